@@ -0,0 +1,200 @@
+#include <benchmark/benchmark.h>
+
+#include <components/bullethelpers/broadphase.hpp>
+#include <components/bullethelpers/collisionobject.hpp>
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btCapsuleShape.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Same as MWPhysics::CollisionType
+    constexpr int collisionTypeWorld = 1 << 0;
+    constexpr int collisionTypeActor = 1 << 2;
+    constexpr int collisionTypeHeightMap = 1 << 3;
+    constexpr int collisionTypeProjectile = 1 << 4;
+
+    constexpr btScalar cellSize = 8192;
+    constexpr std::size_t staticObjectsPerCell = 1000;
+    constexpr std::size_t actorsPerCell = 4;
+
+    enum class Broadphase
+    {
+        // Default btDbvtBroadphase tracking overlapping pairs
+        Legacy,
+        Dbvt,
+        AxisSweep,
+    };
+
+    std::unique_ptr<btBroadphaseInterface> makeBroadphase(Broadphase broadphase)
+    {
+        switch (broadphase)
+        {
+            case Broadphase::Legacy:
+                return std::make_unique<btDbvtBroadphase>();
+            case Broadphase::Dbvt:
+                return BulletHelpers::makeQueryBroadphase(BulletHelpers::BroadphaseType::Dbvt);
+            case Broadphase::AxisSweep:
+                return BulletHelpers::makeQueryBroadphase(BulletHelpers::BroadphaseType::AxisSweep);
+        }
+        return nullptr;
+    }
+
+    // Exterior grid of cells with static objects and actors walking around
+    struct Scene
+    {
+        std::minstd_rand mRandom;
+        btDefaultCollisionConfiguration mCollisionConfiguration;
+        btCollisionDispatcher mDispatcher{ &mCollisionConfiguration };
+        std::unique_ptr<btBroadphaseInterface> mBroadphase;
+        std::unique_ptr<btCollisionWorld> mCollisionWorld;
+        std::vector<std::unique_ptr<btBoxShape>> mStaticShapes;
+        btCapsuleShapeZ mActorShape{ 32, 64 };
+        std::vector<std::unique_ptr<btCollisionObject>> mStaticObjects;
+        std::vector<std::unique_ptr<btCollisionObject>> mActors;
+
+        explicit Scene(Broadphase broadphase, int gridSize)
+            : mBroadphase(makeBroadphase(broadphase))
+            , mCollisionWorld(
+                  std::make_unique<btCollisionWorld>(&mDispatcher, mBroadphase.get(), &mCollisionConfiguration))
+        {
+            mCollisionWorld->setForceUpdateAllAabbs(false);
+
+            std::uniform_real_distribution<btScalar> halfExtent(16, 512);
+            for (std::size_t i = 0; i < 64; ++i)
+                mStaticShapes.push_back(std::make_unique<btBoxShape>(
+                    btVector3(halfExtent(mRandom), halfExtent(mRandom), halfExtent(mRandom))));
+
+            std::uniform_int_distribution<std::size_t> shape(0, mStaticShapes.size() - 1);
+            std::uniform_real_distribution<btScalar> position(0, cellSize);
+            std::uniform_real_distribution<btScalar> height(-512, 2048);
+            std::uniform_real_distribution<btScalar> angle(0, SIMD_2_PI);
+            for (int x = -gridSize / 2; x <= gridSize / 2; ++x)
+            {
+                for (int y = -gridSize / 2; y <= gridSize / 2; ++y)
+                {
+                    const btVector3 cellOrigin(x * cellSize, y * cellSize, 0);
+                    for (std::size_t i = 0; i < staticObjectsPerCell; ++i)
+                        mStaticObjects.push_back(
+                            BulletHelpers::makeCollisionObject(mStaticShapes[shape(mRandom)].get(),
+                                cellOrigin + btVector3(position(mRandom), position(mRandom), height(mRandom)),
+                                btQuaternion(btVector3(0, 0, 1), angle(mRandom))));
+                    for (std::size_t i = 0; i < actorsPerCell; ++i)
+                        mActors.push_back(BulletHelpers::makeCollisionObject(&mActorShape,
+                            cellOrigin + btVector3(position(mRandom), position(mRandom), height(mRandom)),
+                            btQuaternion::getIdentity()));
+                }
+            }
+
+            for (const auto& actor : mActors)
+                mCollisionWorld->addCollisionObject(
+                    actor.get(), collisionTypeActor, collisionTypeWorld | collisionTypeActor | collisionTypeHeightMap);
+        }
+
+        ~Scene()
+        {
+            removeStaticObjects();
+            for (const auto& actor : mActors)
+                mCollisionWorld->removeCollisionObject(actor.get());
+        }
+
+        void addStaticObjects()
+        {
+            for (const auto& object : mStaticObjects)
+                mCollisionWorld->addCollisionObject(object.get(), collisionTypeWorld,
+                    collisionTypeActor | collisionTypeHeightMap | collisionTypeProjectile);
+        }
+
+        void removeStaticObjects()
+        {
+            for (const auto& object : mStaticObjects)
+                if (object->getBroadphaseHandle() != nullptr)
+                    mCollisionWorld->removeCollisionObject(object.get());
+        }
+
+        void moveActors()
+        {
+            std::uniform_real_distribution<btScalar> offset(-16, 16);
+            for (const auto& actor : mActors)
+            {
+                actor->getWorldTransform().getOrigin() += btVector3(offset(mRandom), offset(mRandom), 0);
+                mCollisionWorld->updateSingleAabb(actor.get());
+            }
+        }
+    };
+
+    Broadphase getBroadphase(const benchmark::State& state)
+    {
+        return static_cast<Broadphase>(state.range(0));
+    }
+
+    int getGridSize(const benchmark::State& state)
+    {
+        return static_cast<int>(state.range(1));
+    }
+
+    void addRemoveStaticObjects(benchmark::State& state)
+    {
+        Scene scene(getBroadphase(state), getGridSize(state));
+
+        for (auto _ : state)
+        {
+            scene.addStaticObjects();
+            scene.removeStaticObjects();
+        }
+
+        state.SetItemsProcessed(state.iterations() * scene.mStaticObjects.size());
+    }
+
+    void updateActorsAabbs(benchmark::State& state)
+    {
+        Scene scene(getBroadphase(state), getGridSize(state));
+        scene.addStaticObjects();
+
+        for (auto _ : state)
+            scene.moveActors();
+
+        state.SetItemsProcessed(state.iterations() * scene.mActors.size());
+    }
+
+    void rayTest(benchmark::State& state)
+    {
+        Scene scene(getBroadphase(state), getGridSize(state));
+        scene.addStaticObjects();
+        const btScalar halfWidth = getGridSize(state) * cellSize / 2;
+        std::uniform_real_distribution<btScalar> position(-halfWidth, halfWidth);
+        std::uniform_real_distribution<btScalar> offset(-1024, 1024);
+
+        for (auto _ : state)
+        {
+            const btVector3 from(position(scene.mRandom), position(scene.mRandom), 1024);
+            const btVector3 to = from + btVector3(offset(scene.mRandom), offset(scene.mRandom), -1024);
+            btCollisionWorld::ClosestRayResultCallback callback(from, to);
+            callback.m_collisionFilterGroup = collisionTypeActor;
+            callback.m_collisionFilterMask = collisionTypeWorld | collisionTypeHeightMap;
+            scene.mCollisionWorld->rayTest(from, to, callback);
+            benchmark::DoNotOptimize(callback.hasHit());
+        }
+    }
+
+    const std::vector<std::vector<std::int64_t>> arguments{
+        { static_cast<std::int64_t>(Broadphase::Legacy), static_cast<std::int64_t>(Broadphase::Dbvt),
+            static_cast<std::int64_t>(Broadphase::AxisSweep) },
+        { 3, 5, 7 },
+    };
+}
+
+BENCHMARK(addRemoveStaticObjects)->ArgsProduct(arguments)->ArgNames({ "broadphase", "grid" });
+BENCHMARK(updateActorsAabbs)->ArgsProduct(arguments)->ArgNames({ "broadphase", "grid" });
+BENCHMARK(rayTest)->ArgsProduct(arguments)->ArgNames({ "broadphase", "grid" });
+
+BENCHMARK_MAIN();
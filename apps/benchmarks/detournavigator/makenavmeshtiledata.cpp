@@ -0,0 +1,168 @@
+#include <benchmark/benchmark.h>
+
+#include <components/detournavigator/makenavmesh.hpp>
+#include <components/detournavigator/navmeshdata.hpp>
+#include <components/detournavigator/preparednavmeshdata.hpp>
+#include <components/detournavigator/recastmesh.hpp>
+#include <components/detournavigator/recastmeshbuilder.hpp>
+#include <components/detournavigator/settings.hpp>
+#include <components/detournavigator/settingsutils.hpp>
+#include <components/esm3/loadland.hpp>
+
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+
+#include <osg/Math>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace DetourNavigator;
+
+    RecastSettings makeRecastSettings()
+    {
+        RecastSettings result;
+        result.mBorderSize = 16;
+        result.mCellHeight = 0.2f;
+        result.mCellSize = 0.2f;
+        result.mDetailSampleDist = 6;
+        result.mDetailSampleMaxError = 1;
+        result.mMaxClimb = 34;
+        result.mMaxSimplificationError = 1.3f;
+        result.mMaxSlope = 49;
+        result.mRecastScaleFactor = 0.029411764705882353f;
+        result.mSwimHeightScale = 0.89999997615814208984375f;
+        result.mMaxEdgeLen = 12;
+        result.mMaxVertsPerPoly = 6;
+        result.mRegionMergeArea = 400;
+        result.mRegionMinArea = 64;
+        result.mTileSize = 128;
+        return result;
+    }
+
+    std::vector<float> generateHeights(auto& random)
+    {
+        std::uniform_real_distribution<float> distribution(-16, 16);
+        std::vector<float> result;
+        result.reserve(ESM::Land::LAND_NUM_VERTS);
+        for (int y = 0; y < ESM::Land::LAND_SIZE; ++y)
+            for (int x = 0; x < ESM::Land::LAND_SIZE; ++x)
+                result.push_back(512 * std::sin(x * 0.2f) * std::cos(y * 0.15f) + distribution(random));
+        return result;
+    }
+
+    std::unique_ptr<btTriangleMesh> generateTriangleMesh(std::size_t triangles, auto& random)
+    {
+        std::uniform_real_distribution<float> distribution(-128, 128);
+        auto result = std::make_unique<btTriangleMesh>();
+        const auto vertex = [&] { return btVector3(distribution(random), distribution(random), distribution(random)); };
+        for (std::size_t i = 0; i < triangles; ++i)
+            result->addTriangle(vertex(), vertex(), vertex());
+        return result;
+    }
+
+    btTransform generateTransform(const TileBounds& bounds, auto& random)
+    {
+        std::uniform_real_distribution<float> x(bounds.mMin.x(), bounds.mMax.x());
+        std::uniform_real_distribution<float> y(bounds.mMin.y(), bounds.mMax.y());
+        std::uniform_real_distribution<float> angle(0, 2 * osg::PI);
+        return btTransform(btQuaternion(btVector3(0, 0, 1), angle(random)), btVector3(x(random), y(random), 0));
+    }
+
+    // Scene of a single tile inside a landscape cell with some buildings and rocks
+    struct Scene
+    {
+        const RecastSettings mSettings = makeRecastSettings();
+        const AgentBounds mAgentBounds{ CollisionShapeType::Aabb, { 29, 29, 66 } };
+        const TilePosition mTilePosition{ 4, 4 };
+        const TileBounds mBounds = makeRealTileBoundsWithBorder(mSettings, mTilePosition);
+        const ESM::RefId mWorldspace = ESM::RefId::stringRefId("sys::default");
+        std::vector<float> mHeights;
+        std::vector<std::unique_ptr<btBoxShape>> mBoxes;
+        std::vector<btTransform> mBoxTransforms;
+        std::unique_ptr<btTriangleMesh> mTriangleMesh;
+        std::unique_ptr<btBvhTriangleMeshShape> mTriangleMeshShape;
+        std::vector<btTransform> mTriangleMeshTransforms;
+
+        Scene()
+        {
+            std::minstd_rand random;
+            mHeights = generateHeights(random);
+            std::uniform_real_distribution<float> halfExtent(32, 256);
+            for (std::size_t i = 0; i < 32; ++i)
+            {
+                mBoxes.push_back(std::make_unique<btBoxShape>(
+                    btVector3(halfExtent(random), halfExtent(random), halfExtent(random))));
+                mBoxTransforms.push_back(generateTransform(mBounds, random));
+            }
+            mTriangleMesh = generateTriangleMesh(1000, random);
+            mTriangleMeshShape = std::make_unique<btBvhTriangleMeshShape>(mTriangleMesh.get(), true);
+            for (std::size_t i = 0; i < 16; ++i)
+                mTriangleMeshTransforms.push_back(generateTransform(mBounds, random));
+        }
+
+        std::shared_ptr<RecastMesh> makeRecastMesh() const
+        {
+            RecastMeshBuilder builder(mBounds);
+            const auto [minHeight, maxHeight] = std::minmax_element(mHeights.begin(), mHeights.end());
+            builder.addHeightfield(osg::Vec2i(0, 0), ESM::Land::REAL_SIZE, mHeights.data(), ESM::Land::LAND_SIZE,
+                *minHeight, *maxHeight);
+            for (std::size_t i = 0; i < mBoxes.size(); ++i)
+                builder.addObject(static_cast<const btCollisionShape&>(*mBoxes[i]), mBoxTransforms[i], AreaType_ground,
+                    nullptr, ObjectTransform{});
+            for (const btTransform& transform : mTriangleMeshTransforms)
+                builder.addObject(static_cast<const btCollisionShape&>(*mTriangleMeshShape), transform,
+                    AreaType_ground, nullptr, ObjectTransform{});
+            return std::move(builder).create(Version{ 0, 0 });
+        }
+    };
+
+    void buildRecastMesh(benchmark::State& state)
+    {
+        const Scene scene;
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(scene.makeRecastMesh());
+    }
+
+    void prepareTile(benchmark::State& state)
+    {
+        const Scene scene;
+        const std::shared_ptr<RecastMesh> recastMesh = scene.makeRecastMesh();
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(prepareNavMeshTileData(
+                *recastMesh, scene.mWorldspace, scene.mTilePosition, scene.mAgentBounds, scene.mSettings));
+    }
+
+    void makeTile(benchmark::State& state)
+    {
+        const Scene scene;
+
+        for (auto _ : state)
+        {
+            const std::shared_ptr<RecastMesh> recastMesh = scene.makeRecastMesh();
+            const std::unique_ptr<PreparedNavMeshData> data = prepareNavMeshTileData(
+                *recastMesh, scene.mWorldspace, scene.mTilePosition, scene.mAgentBounds, scene.mSettings);
+            if (data == nullptr)
+            {
+                state.SkipWithError("Failed to prepare navmesh tile data");
+                break;
+            }
+            benchmark::DoNotOptimize(
+                makeNavMeshTileData(*data, {}, scene.mAgentBounds, scene.mTilePosition, scene.mSettings));
+        }
+    }
+}
+
+BENCHMARK(buildRecastMesh);
+BENCHMARK(prepareTile);
+BENCHMARK(makeTile);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,335 @@
+#include <benchmark/benchmark.h>
+
+#include <components/compiler/context.hpp>
+#include <components/compiler/errorhandler.hpp>
+#include <components/compiler/extensions.hpp>
+#include <components/compiler/extensions0.hpp>
+#include <components/compiler/fileparser.hpp>
+#include <components/compiler/opcodes.hpp>
+#include <components/compiler/scanner.hpp>
+
+#include <components/interpreter/context.hpp>
+#include <components/interpreter/installopcodes.hpp>
+#include <components/interpreter/interpreter.hpp>
+#include <components/interpreter/opcodes.hpp>
+#include <components/interpreter/runtime.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Typical local scripts: a timer driven state machine, a loop and a random event
+    const std::string timerScript = R"mwscript(Begin bench_timer
+
+float timer
+short state
+
+if ( MenuMode == 1 )
+    return
+endif
+
+set timer to ( timer + GetSecondsPassed )
+if ( timer < 5 )
+    return
+endif
+
+set timer to 0
+if ( state == 0 )
+    set state to 1
+elseif ( state == 1 )
+    set state to 2
+else
+    set state to 0
+endif
+
+End)mwscript";
+
+    const std::string loopScript = R"mwscript(Begin bench_loop
+
+short i
+float sum
+
+set i to 0
+set sum to 0
+while ( i < 32 )
+    set sum to ( sum + ( GetSquareRoot i ) )
+    set i to ( i + 1 )
+endwhile
+
+End)mwscript";
+
+    const std::string randomScript = R"mwscript(Begin bench_random
+
+long count
+float chance
+
+set chance to ( Random 100 )
+if ( chance < 25 )
+    set count to ( count + 1 )
+elseif ( chance < 50 )
+    set count to ( count - 1 )
+elseif ( chance < 75 )
+    set count to ( count * 2 )
+else
+    set count to 0
+endif
+
+End)mwscript";
+
+    class CompilerContext : public Compiler::Context
+    {
+    public:
+        bool canDeclareLocals() const override { return true; }
+
+        char getGlobalType(const std::string& name) const override { return ' '; }
+
+        std::pair<char, bool> getMemberType(const std::string& name, const ESM::RefId& id) const override
+        {
+            return { ' ', false };
+        }
+
+        bool isId(const ESM::RefId& name) const override { return false; }
+    };
+
+    class ErrorHandler : public Compiler::ErrorHandler
+    {
+        void report(const std::string& message, const Compiler::TokenLoc& loc, Type type) override
+        {
+            if (type == ErrorMessage)
+                throw std::runtime_error(message);
+        }
+
+        void report(const std::string& message, Type type) override
+        {
+            if (type == ErrorMessage)
+                throw std::runtime_error(message);
+        }
+    };
+
+    class InterpreterContext : public Interpreter::Context
+    {
+        std::vector<int> mShorts;
+        std::vector<int> mLongs;
+        std::vector<float> mFloats;
+
+        template <class T>
+        static T getLocal(std::size_t index, const std::vector<T>& values)
+        {
+            return index < values.size() ? values[index] : T{};
+        }
+
+        template <class T>
+        static void setLocal(std::size_t index, T value, std::vector<T>& values)
+        {
+            if (index >= values.size())
+                values.resize(index + 1);
+            values[index] = value;
+        }
+
+    public:
+        ESM::RefId getTarget() const override { return ESM::RefId(); }
+
+        int getLocalShort(int index) const override { return getLocal(index, mShorts); }
+
+        int getLocalLong(int index) const override { return getLocal(index, mLongs); }
+
+        float getLocalFloat(int index) const override { return getLocal(index, mFloats); }
+
+        void setLocalShort(int index, int value) override { setLocal(index, value, mShorts); }
+
+        void setLocalLong(int index, int value) override { setLocal(index, value, mLongs); }
+
+        void setLocalFloat(int index, float value) override { setLocal(index, value, mFloats); }
+
+        void messageBox(std::string_view message, const std::vector<std::string>& buttons) override {}
+
+        void report(const std::string& message) override {}
+
+        int getGlobalShort(std::string_view name) const override { return {}; }
+
+        int getGlobalLong(std::string_view name) const override { return {}; }
+
+        float getGlobalFloat(std::string_view name) const override { return {}; }
+
+        void setGlobalShort(std::string_view name, int value) override {}
+
+        void setGlobalLong(std::string_view name, int value) override {}
+
+        void setGlobalFloat(std::string_view name, float value) override {}
+
+        std::vector<std::string> getGlobals() const override { return {}; }
+
+        char getGlobalType(std::string_view name) const override { return ' '; }
+
+        std::string getActionBinding(std::string_view action) const override { return {}; }
+
+        std::string_view getActorName() const override { return {}; }
+
+        std::string_view getNPCRace() const override { return {}; }
+
+        std::string_view getNPCClass() const override { return {}; }
+
+        std::string_view getNPCFaction() const override { return {}; }
+
+        std::string_view getNPCRank() const override { return {}; }
+
+        std::string_view getPCName() const override { return {}; }
+
+        std::string_view getPCRace() const override { return {}; }
+
+        std::string_view getPCClass() const override { return {}; }
+
+        std::string_view getPCRank() const override { return {}; }
+
+        std::string_view getPCNextRank() const override { return {}; }
+
+        int getPCBounty() const override { return {}; }
+
+        std::string_view getCurrentCellName() const override { return {}; }
+
+        int getMemberShort(ESM::RefId id, std::string_view name, bool global) const override { return {}; }
+
+        int getMemberLong(ESM::RefId id, std::string_view name, bool global) const override { return {}; }
+
+        float getMemberFloat(ESM::RefId id, std::string_view name, bool global) const override { return {}; }
+
+        void setMemberShort(ESM::RefId id, std::string_view name, int value, bool global) override {}
+
+        void setMemberLong(ESM::RefId id, std::string_view name, int value, bool global) override {}
+
+        void setMemberFloat(ESM::RefId id, std::string_view name, float value, bool global) override {}
+    };
+
+    class OpNop0 : public Interpreter::Opcode0
+    {
+    public:
+        void execute(Interpreter::Runtime& runtime) override {}
+    };
+
+    class OpNop1 : public Interpreter::Opcode1
+    {
+    public:
+        void execute(Interpreter::Runtime& runtime, unsigned int arg0) override {}
+    };
+
+    class OpMenuMode : public Interpreter::Opcode0
+    {
+    public:
+        void execute(Interpreter::Runtime& runtime) override { runtime.push(Interpreter::Type_Integer{ 0 }); }
+    };
+
+    class OpGetSecondsPassed : public Interpreter::Opcode0
+    {
+    public:
+        void execute(Interpreter::Runtime& runtime) override { runtime.push(Interpreter::Type_Float{ 0.016f }); }
+    };
+
+    class OpRandom : public Interpreter::Opcode0
+    {
+        Interpreter::Type_Integer mNext = 0;
+
+    public:
+        void execute(Interpreter::Runtime& runtime) override
+        {
+            const Interpreter::Type_Integer limit = runtime[0].mInteger;
+            runtime.pop();
+            mNext = (mNext + 37) % limit;
+            runtime.push(static_cast<Interpreter::Type_Float>(mNext));
+        }
+    };
+
+    class OpGetSquareRoot : public Interpreter::Opcode0
+    {
+    public:
+        void execute(Interpreter::Runtime& runtime) override
+        {
+            const Interpreter::Type_Float value = runtime[0].mFloat;
+            runtime.pop();
+            runtime.push(std::sqrt(value));
+        }
+    };
+
+    Interpreter::Program compile(const std::string& script, const Compiler::Extensions& extensions)
+    {
+        ErrorHandler errorHandler;
+        CompilerContext context;
+        context.setExtensions(&extensions);
+        Compiler::FileParser parser(errorHandler, context);
+        std::istringstream input(script);
+        Compiler::Scanner scanner(errorHandler, input, &extensions);
+        scanner.scan(parser);
+        return parser.getProgram();
+    }
+
+    struct Fixture
+    {
+        Compiler::Extensions mExtensions;
+        Interpreter::Interpreter mInterpreter;
+        InterpreterContext mContext;
+
+        Fixture()
+        {
+            Compiler::registerExtensions(mExtensions);
+
+            Interpreter::installOpcodes(mInterpreter);
+            mInterpreter.installSegment5<OpMenuMode>(Compiler::Misc::opcodeMenuMode);
+            mInterpreter.installSegment5<OpGetSecondsPassed>(Compiler::Misc::opcodeGetSecondsPassed);
+            mInterpreter.installSegment5<OpRandom>(Compiler::Misc::opcodeRandom);
+            mInterpreter.installSegment5<OpGetSquareRoot>(Compiler::Misc::opcodeGetSquareRoot);
+
+            // Populate the rest of the extensions range like the engine does
+            for (int code = 0x2000000; code <= 0x2000325; ++code)
+                if (code != Compiler::Misc::opcodeMenuMode && code != Compiler::Misc::opcodeGetSecondsPassed
+                    && code != Compiler::Misc::opcodeRandom && code != Compiler::Misc::opcodeGetSquareRoot)
+                    mInterpreter.installSegment5<OpNop0>(code);
+            for (int code = 0x20000; code <= 0x20030; ++code)
+                mInterpreter.installSegment3<OpNop1>(code);
+        }
+    };
+
+    void runScripts(benchmark::State& state, const std::vector<const std::string*>& scripts)
+    {
+        Fixture fixture;
+        std::vector<Interpreter::Program> programs;
+        for (const std::string* script : scripts)
+            programs.push_back(compile(*script, fixture.mExtensions));
+
+        for (auto _ : state)
+            for (const Interpreter::Program& program : programs)
+                fixture.mInterpreter.run(program, fixture.mContext);
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(programs.size()));
+    }
+
+    void timer(benchmark::State& state)
+    {
+        runScripts(state, { &timerScript });
+    }
+
+    void loop(benchmark::State& state)
+    {
+        runScripts(state, { &loopScript });
+    }
+
+    void random(benchmark::State& state)
+    {
+        runScripts(state, { &randomScript });
+    }
+
+    void corpus(benchmark::State& state)
+    {
+        runScripts(state, { &timerScript, &loopScript, &randomScript });
+    }
+}
+
+BENCHMARK(timer);
+BENCHMARK(loop);
+BENCHMARK(random);
+BENCHMARK(corpus);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,151 @@
+#include <benchmark/benchmark.h>
+
+#include <components/sceneutil/skinning.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+#include <osg/Quat>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Close to a body part of an NPC with the default skeleton
+    constexpr std::size_t bonesCount = 64;
+    constexpr std::size_t maxBonesPerVertex = 4;
+
+    // Synthetic mesh with vertices grouped by bone weights the same way as SceneUtil::RigGeometry does
+    struct Rig
+    {
+        std::vector<SceneUtil::SkinningInfluence> mInfluences;
+        std::vector<osg::Matrixf> mBoneMatrices;
+        osg::ref_ptr<osg::Vec3Array> mSourcePositions = new osg::Vec3Array;
+        osg::ref_ptr<osg::Vec3Array> mSourceNormals = new osg::Vec3Array;
+        osg::ref_ptr<osg::Vec4Array> mSourceTangents = new osg::Vec4Array;
+        osg::ref_ptr<osg::Vec3Array> mPositions;
+        osg::ref_ptr<osg::Vec3Array> mNormals;
+        osg::ref_ptr<osg::Vec4Array> mTangents;
+
+        explicit Rig(std::size_t verticesCount)
+        {
+            std::minstd_rand random;
+            std::uniform_real_distribution<float> coordinate(-64, 64);
+            std::uniform_real_distribution<float> unit(-1, 1);
+            std::uniform_int_distribution<std::size_t> bonesPerVertex(1, maxBonesPerVertex);
+            // Neighbouring vertices are usually influenced by neighbouring bones
+            std::uniform_int_distribution<std::size_t> boneOffset(0, 2);
+
+            std::map<std::vector<std::pair<std::size_t, float>>, std::vector<unsigned short>> influences;
+            for (std::size_t i = 0; i < verticesCount; ++i)
+            {
+                mSourcePositions->push_back(osg::Vec3f(coordinate(random), coordinate(random), coordinate(random)));
+                osg::Vec3f normal(unit(random), unit(random), unit(random));
+                normal.normalize();
+                mSourceNormals->push_back(normal);
+                mSourceTangents->push_back(osg::Vec4f(normal.z(), normal.x(), normal.y(), 1));
+
+                const std::size_t count = bonesPerVertex(random);
+                std::size_t bone = i * bonesCount / verticesCount;
+                std::vector<std::pair<std::size_t, float>> weights;
+                for (std::size_t j = 0; j < count; ++j)
+                {
+                    weights.emplace_back(bone, 1.0f / count);
+                    bone = std::min(bone + 1 + boneOffset(random), bonesCount - 1);
+                }
+                influences[weights].push_back(static_cast<unsigned short>(i));
+            }
+
+            for (auto& [weights, vertices] : influences)
+                mInfluences.push_back(SceneUtil::SkinningInfluence{ .mBoneWeights = weights, .mVertices = vertices });
+
+            for (std::size_t i = 0; i < bonesCount; ++i)
+            {
+                osg::Matrixf matrix;
+                matrix.makeRotate(osg::Quat(unit(random), osg::Vec3f(unit(random), unit(random), 1)));
+                matrix.postMultTranslate(osg::Vec3f(coordinate(random), coordinate(random), coordinate(random)));
+                mBoneMatrices.push_back(matrix);
+            }
+
+            mPositions = new osg::Vec3Array(verticesCount);
+            mNormals = new osg::Vec3Array(verticesCount);
+            mTangents = new osg::Vec4Array(verticesCount);
+        }
+
+        void skin() const
+        {
+            const SceneUtil::SkinningArrays arrays{
+                .mSourcePositions = mSourcePositions,
+                .mSourceNormals = mSourceNormals,
+                .mSourceTangents = mSourceTangents,
+                .mPositions = mPositions,
+                .mNormals = mNormals,
+                .mTangents = mTangents,
+            };
+            SceneUtil::skin(mInfluences, mBoneMatrices, nullptr, arrays);
+        }
+    };
+
+    struct SkinningWorkItem final : SceneUtil::WorkItem
+    {
+        const Rig& mRig;
+
+        explicit SkinningWorkItem(const Rig& rig)
+            : mRig(rig)
+        {
+        }
+
+        void doWork() override { mRig.skin(); }
+    };
+
+    void skinRig(benchmark::State& state)
+    {
+        const Rig rig(static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state)
+        {
+            rig.skin();
+            benchmark::DoNotOptimize(rig.mPositions->front());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Visible NPCs skinned by a work queue while the caller waits like the draw thread does
+    void skinRigsOnWorkQueue(benchmark::State& state)
+    {
+        const std::size_t threads = static_cast<std::size_t>(state.range(0));
+        const std::size_t rigsCount = static_cast<std::size_t>(state.range(1));
+        constexpr std::size_t verticesCount = 2048;
+        std::vector<Rig> rigs;
+        rigs.reserve(rigsCount);
+        for (std::size_t i = 0; i < rigsCount; ++i)
+            rigs.emplace_back(verticesCount);
+        const osg::ref_ptr<SceneUtil::WorkQueue> workQueue = new SceneUtil::WorkQueue(threads);
+        std::vector<osg::ref_ptr<SkinningWorkItem>> workItems;
+
+        for (auto _ : state)
+        {
+            workItems.clear();
+            for (const Rig& rig : rigs)
+            {
+                workItems.push_back(new SkinningWorkItem(rig));
+                workQueue->addWorkItem(workItems.back(), SceneUtil::WorkPriority::High);
+            }
+            for (const osg::ref_ptr<SkinningWorkItem>& workItem : workItems)
+                workItem->waitTillDone();
+        }
+
+        state.SetItemsProcessed(state.iterations() * rigsCount * verticesCount);
+    }
+}
+
+BENCHMARK(skinRig)->Arg(256)->Arg(2048)->Arg(8192)->ArgName("vertices");
+BENCHMARK(skinRigsOnWorkQueue)
+    ->ArgsProduct({ { 1, 2, 4 }, { 16, 64 } })
+    ->ArgNames({ "threads", "rigs" })
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,163 @@
+#include <benchmark/benchmark.h>
+
+#include "components/vfs/fileindex.hpp"
+#include "components/vfs/filemap.hpp"
+#include "components/vfs/pathutil.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t lookupsCount = 64 * 1024;
+
+    template <class Random>
+    std::string generateName(Random& random)
+    {
+        std::uniform_int_distribution<std::size_t> sizeDistribution(4, 24);
+        std::uniform_int_distribution<int> distribution('a', 'z');
+        std::string result;
+        std::generate_n(std::back_inserter(result), sizeDistribution(random), [&] { return distribution(random); });
+        return result;
+    }
+
+    // Resembles data directories layout: a few top level directories with nested subdirectories
+    template <class Random>
+    std::vector<std::string> generatePaths(std::size_t count, Random& random)
+    {
+        constexpr std::array<std::string_view, 6> directories = { "meshes/", "textures/", "sound/", "icons/",
+            "music/", "bookart/" };
+        constexpr std::array<std::string_view, 6> extensions = { ".nif", ".dds", ".wav", ".tga", ".mp3", ".kf" };
+        std::uniform_int_distribution<std::size_t> directoryDistribution(0, directories.size() - 1);
+        std::uniform_int_distribution<std::size_t> subdirectoryDistribution(0, 63);
+        std::vector<std::string> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::size_t type = directoryDistribution(random);
+            result.push_back(std::string(directories[type]) + "d" + std::to_string(subdirectoryDistribution(random))
+                + "/" + generateName(random) + std::string(extensions[type]));
+        }
+        return result;
+    }
+
+    VFS::FileMap makeFileMap(const std::vector<std::string>& paths)
+    {
+        VFS::FileMap result;
+        for (const std::string& path : paths)
+            result.emplace(VFS::Path::Normalized(path), nullptr);
+        return result;
+    }
+
+    template <class Random>
+    std::vector<std::string> generateLookups(const std::vector<std::string>& paths, Random& random)
+    {
+        std::uniform_int_distribution<std::size_t> distribution(0, paths.size() - 1);
+        std::vector<std::string> result;
+        result.reserve(lookupsCount);
+        std::generate_n(std::back_inserter(result), lookupsCount, [&] { return paths[distribution(random)]; });
+        return result;
+    }
+
+    void fileMapFind(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> paths = generatePaths(state.range(0), random);
+        const VFS::FileMap map = makeFileMap(paths);
+        const std::vector<std::string> lookups = generateLookups(paths, random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(map.find(std::string_view(lookups[i])));
+            if (++i >= lookups.size())
+                i = 0;
+        }
+    }
+
+    void fileIndexFind(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> paths = generatePaths(state.range(0), random);
+        const VFS::FileIndex index(makeFileMap(paths));
+        const std::vector<std::string> lookups = generateLookups(paths, random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(index.find(lookups[i]));
+            if (++i >= lookups.size())
+                i = 0;
+        }
+    }
+
+    void fileMapFindMissing(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const VFS::FileMap map = makeFileMap(generatePaths(state.range(0), random));
+        const std::vector<std::string> lookups = generatePaths(lookupsCount, random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(map.find(std::string_view(lookups[i])));
+            if (++i >= lookups.size())
+                i = 0;
+        }
+    }
+
+    void fileIndexFindMissing(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const VFS::FileIndex index(makeFileMap(generatePaths(state.range(0), random)));
+        const std::vector<std::string> lookups = generatePaths(lookupsCount, random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(index.find(lookups[i]));
+            if (++i >= lookups.size())
+                i = 0;
+        }
+    }
+
+    void fileMapLowerBound(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> paths = generatePaths(state.range(0), random);
+        const VFS::FileMap map = makeFileMap(paths);
+        const std::vector<std::string> lookups = generateLookups(paths, random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(map.lower_bound(std::string_view(lookups[i])));
+            if (++i >= lookups.size())
+                i = 0;
+        }
+    }
+
+    void fileIndexLowerBound(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> paths = generatePaths(state.range(0), random);
+        const VFS::FileIndex index(makeFileMap(paths));
+        const std::vector<std::string> lookups = generateLookups(paths, random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(index.lowerBound(lookups[i]));
+            if (++i >= lookups.size())
+                i = 0;
+        }
+    }
+}
+
+BENCHMARK(fileMapFind)->RangeMultiplier(8)->Range(1024, 512 * 1024);
+BENCHMARK(fileIndexFind)->RangeMultiplier(8)->Range(1024, 512 * 1024);
+BENCHMARK(fileMapFindMissing)->RangeMultiplier(8)->Range(1024, 512 * 1024);
+BENCHMARK(fileIndexFindMissing)->RangeMultiplier(8)->Range(1024, 512 * 1024);
+BENCHMARK(fileMapLowerBound)->RangeMultiplier(8)->Range(1024, 512 * 1024);
+BENCHMARK(fileIndexLowerBound)->RangeMultiplier(8)->Range(1024, 512 * 1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,75 @@
+#include <components/bsa/bsa_file.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace TestingOpenMW;
+
+    struct BsaBSAFileTest : Test
+    {
+        const std::filesystem::path mPath = outputFilePath(
+            std::string(UnitTest::GetInstance()->current_test_info()->name()) + ".bsa");
+
+        void SetUp() override
+        {
+            std::filesystem::remove(mPath);
+            Bsa::BSAFile file;
+            file.open(mPath);
+            std::istringstream first("first file content");
+            file.addFile("meshes\\first.nif", first);
+            std::istringstream second("second");
+            file.addFile("textures\\second.dds", second);
+            file.close();
+        }
+
+        static std::string read(Bsa::BSAFile& file, std::size_t index)
+        {
+            const Files::IStreamPtr stream = file.getFile(&file.getList().at(index));
+            return std::string(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+        }
+    };
+
+    TEST_F(BsaBSAFileTest, getFileShouldReturnContentFromFileStream)
+    {
+        Bsa::BSAFile file;
+        file.open(mPath);
+        ASSERT_EQ(file.getList().size(), 2);
+        EXPECT_FALSE(file.isMemoryMapped());
+        EXPECT_EQ(read(file, 0), "first file content");
+        EXPECT_EQ(read(file, 1), "second");
+    }
+
+    TEST_F(BsaBSAFileTest, getFileShouldReturnContentFromMemoryMapping)
+    {
+        Bsa::BSAFile file;
+        file.open(mPath);
+        file.mapIntoMemory();
+        ASSERT_EQ(file.getList().size(), 2);
+        EXPECT_TRUE(file.isMemoryMapped());
+        EXPECT_EQ(read(file, 0), "first file content");
+        EXPECT_EQ(read(file, 1), "second");
+    }
+
+    TEST_F(BsaBSAFileTest, closeShouldUnmapArchive)
+    {
+        Bsa::BSAFile file;
+        file.open(mPath);
+        file.mapIntoMemory();
+        file.close();
+        EXPECT_FALSE(file.isMemoryMapped());
+    }
+
+    TEST_F(BsaBSAFileTest, mapIntoMemoryShouldThrowForNotOpenedArchive)
+    {
+        Bsa::BSAFile file;
+        EXPECT_THROW(file.mapIntoMemory(), std::runtime_error);
+    }
+}
@@ -0,0 +1,100 @@
+#include <components/bsa/decompress.hpp>
+#include <components/bsa/decompressedfilecache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <zlib.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Bsa;
+
+    DecompressedFile makeFile(std::size_t size)
+    {
+        return std::make_shared<const std::vector<char>>(size, 'a');
+    }
+
+    TEST(BsaDecompressedFileCacheTest, getShouldReturnNullptrForMissingFile)
+    {
+        DecompressedFileCache cache(16);
+        EXPECT_EQ(cache.get(0, 0), nullptr);
+        EXPECT_EQ(cache.getStats().mMisses, 1);
+    }
+
+    TEST(BsaDecompressedFileCacheTest, getShouldReturnAddedFile)
+    {
+        DecompressedFileCache cache(16);
+        const DecompressedFile file = makeFile(4);
+        cache.add(1, 2, file);
+        EXPECT_EQ(cache.get(1, 2), file);
+        EXPECT_EQ(cache.get(2, 2), nullptr);
+        EXPECT_EQ(cache.get(1, 3), nullptr);
+        EXPECT_EQ(cache.getStats().mHits, 1);
+    }
+
+    TEST(BsaDecompressedFileCacheTest, addShouldRemoveLeastRecentlyUsedFilesWhenSizeIsExceeded)
+    {
+        DecompressedFileCache cache(16);
+        cache.add(0, 0, makeFile(8));
+        cache.add(0, 1, makeFile(8));
+        ASSERT_NE(cache.get(0, 0), nullptr);
+        cache.add(0, 2, makeFile(8));
+        EXPECT_NE(cache.get(0, 0), nullptr);
+        EXPECT_EQ(cache.get(0, 1), nullptr);
+        EXPECT_NE(cache.get(0, 2), nullptr);
+        EXPECT_EQ(cache.getStats().mSize, 16);
+        EXPECT_EQ(cache.getStats().mCount, 2);
+    }
+
+    TEST(BsaDecompressedFileCacheTest, addShouldIgnoreFileLargerThanCache)
+    {
+        DecompressedFileCache cache(16);
+        cache.add(0, 0, makeFile(8));
+        cache.add(0, 1, makeFile(17));
+        EXPECT_NE(cache.get(0, 0), nullptr);
+        EXPECT_EQ(cache.get(0, 1), nullptr);
+    }
+
+    TEST(BsaDecompressedFileCacheTest, eraseShouldRemoveAllArchiveFiles)
+    {
+        DecompressedFileCache cache(16);
+        cache.add(0, 0, makeFile(4));
+        cache.add(1, 0, makeFile(4));
+        cache.add(0, 1, makeFile(4));
+        cache.erase(0);
+        EXPECT_EQ(cache.get(0, 0), nullptr);
+        EXPECT_EQ(cache.get(0, 1), nullptr);
+        EXPECT_NE(cache.get(1, 0), nullptr);
+        EXPECT_EQ(cache.getStats().mSize, 4);
+    }
+
+    TEST(BsaDecompressZlibTest, shouldDecompressIntoOutputBuffer)
+    {
+        const std::string content = "content content content content";
+        std::vector<char> compressed(compressBound(static_cast<uLong>(content.size())));
+        uLongf compressedSize = static_cast<uLongf>(compressed.size());
+        ASSERT_EQ(compress(reinterpret_cast<Bytef*>(compressed.data()), &compressedSize,
+                      reinterpret_cast<const Bytef*>(content.data()), static_cast<uLong>(content.size())),
+            Z_OK);
+        compressed.resize(compressedSize);
+        // Context is reused between calls
+        for (int i = 0; i < 2; ++i)
+        {
+            std::string result(content.size(), '\0');
+            decompressZlib(compressed, result);
+            EXPECT_EQ(result, content);
+        }
+    }
+
+    TEST(BsaDecompressZlibTest, shouldThrowOnInvalidInput)
+    {
+        const std::string input = "invalid";
+        std::string result(16, '\0');
+        EXPECT_THROW(decompressZlib(input, result), std::runtime_error);
+    }
+}
@@ -0,0 +1,199 @@
+#include <components/compiler/errorhandler.hpp>
+#include <components/compiler/extensions.hpp>
+#include <components/compiler/extensions0.hpp>
+#include <components/compiler/fileparser.hpp>
+#include <components/compiler/scanner.hpp>
+#include <components/compiler/scriptcache.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    using namespace testing;
+    using namespace Compiler;
+
+    class TestContext : public Context
+    {
+    public:
+        std::map<std::string, char> mGlobals;
+        std::set<ESM::RefId> mIds;
+
+        bool canDeclareLocals() const override { return true; }
+
+        char getGlobalType(const std::string& name) const override
+        {
+            const auto it = mGlobals.find(name);
+            return it == mGlobals.end() ? ' ' : it->second;
+        }
+
+        std::pair<char, bool> getMemberType(const std::string& name, const ESM::RefId& id) const override
+        {
+            return { ' ', false };
+        }
+
+        bool isId(const ESM::RefId& name) const override { return mIds.contains(name); }
+    };
+
+    class TestErrorHandler : public ErrorHandler
+    {
+        void report(const std::string& message, const TokenLoc& loc, Type type) override
+        {
+            if (type == ErrorMessage)
+                throw std::runtime_error(message);
+        }
+
+        void report(const std::string& message, Type type) override
+        {
+            if (type == ErrorMessage)
+                throw std::runtime_error(message);
+        }
+    };
+
+    const std::string script = R"mwscript(Begin test
+
+short value
+float timer
+
+set value to ( GlobalValue + 1 )
+set timer to 0.5
+if ( value == 2 )
+    MessageBox "Hello"
+endif
+
+End)mwscript";
+
+    struct CompilerScriptCacheTest : Test
+    {
+        Extensions mExtensions;
+        TestContext mContext;
+        TestErrorHandler mErrorHandler;
+        const std::filesystem::path mPath = TestingOpenMW::outputFilePath("scripts.bin");
+
+        CompilerScriptCacheTest()
+        {
+            registerExtensions(mExtensions);
+            mContext.setExtensions(&mExtensions);
+            mContext.mGlobals.emplace("globalvalue", 's');
+            std::filesystem::remove(mPath);
+        }
+
+        ScriptCache::Entry compile()
+        {
+            RecordingContext context(mContext);
+            FileParser parser(mErrorHandler, context);
+            std::istringstream input(script);
+            Scanner scanner(mErrorHandler, input, &mExtensions);
+            scanner.scan(parser);
+            return ScriptCache::Entry{ .mProgram = parser.getProgram(),
+                .mLocals = parser.getLocals(),
+                .mDependencies = context.getDependencies() };
+        }
+    };
+
+    TEST_F(CompilerScriptCacheTest, recordingContextShouldRecordQueries)
+    {
+        const ScriptCache::Entry entry = compile();
+        EXPECT_EQ(entry.mDependencies.mGlobals, (std::vector<std::pair<std::string, char>>{ { "globalvalue", 's' } }));
+        EXPECT_TRUE(entry.mDependencies.isSatisfied(mContext));
+    }
+
+    TEST_F(CompilerScriptCacheTest, findShouldReturnNullptrForUnknownScript)
+    {
+        const ScriptCache cache(mPath, mExtensions, 1);
+        EXPECT_EQ(cache.find(ScriptCache::getTextHash(script), mContext), nullptr);
+    }
+
+    TEST_F(CompilerScriptCacheTest, findShouldReturnInsertedEntry)
+    {
+        ScriptCache cache(mPath, mExtensions, 1);
+        const ScriptCache::Entry entry = compile();
+        cache.insert(ScriptCache::getTextHash(script), ScriptCache::Entry(entry));
+        const ScriptCache::Entry* found = cache.find(ScriptCache::getTextHash(script), mContext);
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(found->mProgram.mInstructions, entry.mProgram.mInstructions);
+    }
+
+    TEST_F(CompilerScriptCacheTest, findShouldReturnNullptrWhenDependencyChanged)
+    {
+        ScriptCache cache(mPath, mExtensions, 1);
+        cache.insert(ScriptCache::getTextHash(script), compile());
+        mContext.mGlobals["globalvalue"] = 'f';
+        EXPECT_EQ(cache.find(ScriptCache::getTextHash(script), mContext), nullptr);
+    }
+
+    TEST_F(CompilerScriptCacheTest, removeDuplicatesShouldKeepSingleCopyOfRepeatedQueries)
+    {
+        ScriptDependencies dependencies;
+        dependencies.mGlobals = { { "b", 's' }, { "a", 'f' }, { "b", 's' } };
+        dependencies.mIds = { { ESM::RefId::stringRefId("id"), true }, { ESM::RefId::stringRefId("id"), true } };
+        dependencies.removeDuplicates();
+        EXPECT_EQ(dependencies.mGlobals, (std::vector<std::pair<std::string, char>>{ { "a", 'f' }, { "b", 's' } }));
+        EXPECT_EQ(dependencies.mIds.size(), 1);
+    }
+
+    TEST_F(CompilerScriptCacheTest, retainShouldRemoveEntriesForAbsentScripts)
+    {
+        ScriptCache cache(mPath, mExtensions, 1);
+        cache.insert(ScriptCache::getTextHash(script), compile());
+        cache.insert(ScriptCache::getTextHash("removed"), compile());
+        cache.retain({ ScriptCache::getTextHash(script) });
+        EXPECT_EQ(cache.size(), 1);
+        EXPECT_NE(cache.find(ScriptCache::getTextHash(script), mContext), nullptr);
+    }
+
+    TEST_F(CompilerScriptCacheTest, shouldReadWrittenEntries)
+    {
+        ScriptCache::Entry compiled = compile();
+        compiled.mWarnings = { "line 1, column 1 (Begin): test warning" };
+        const ScriptCache::Entry entry = std::move(compiled);
+        {
+            ScriptCache cache(mPath, mExtensions, 1);
+            cache.insert(ScriptCache::getTextHash(script), ScriptCache::Entry(entry));
+            cache.write();
+        }
+        const ScriptCache cache(mPath, mExtensions, 1);
+        ASSERT_EQ(cache.size(), 1);
+        const ScriptCache::Entry* found = cache.find(ScriptCache::getTextHash(script), mContext);
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(found->mProgram.mInstructions, entry.mProgram.mInstructions);
+        EXPECT_EQ(found->mProgram.mIntegers, entry.mProgram.mIntegers);
+        EXPECT_EQ(found->mProgram.mFloats, entry.mProgram.mFloats);
+        EXPECT_EQ(found->mProgram.mStrings, entry.mProgram.mStrings);
+        EXPECT_EQ(found->mLocals.get('s'), entry.mLocals.get('s'));
+        EXPECT_EQ(found->mLocals.get('f'), entry.mLocals.get('f'));
+        EXPECT_EQ(found->mDependencies.mGlobals, entry.mDependencies.mGlobals);
+        EXPECT_EQ(found->mDependencies.mIds, entry.mDependencies.mIds);
+        EXPECT_EQ(found->mWarnings, entry.mWarnings);
+    }
+
+    TEST_F(CompilerScriptCacheTest, shouldIgnoreEntriesWrittenWithDifferentWarningsMode)
+    {
+        {
+            ScriptCache cache(mPath, mExtensions, 1);
+            cache.insert(ScriptCache::getTextHash(script), compile());
+            cache.write();
+        }
+        const ScriptCache cache(mPath, mExtensions, 2);
+        EXPECT_EQ(cache.size(), 0);
+    }
+
+    TEST_F(CompilerScriptCacheTest, shouldIgnoreEntriesWrittenWithDifferentExtensions)
+    {
+        {
+            ScriptCache cache(mPath, mExtensions, 1);
+            cache.insert(ScriptCache::getTextHash(script), compile());
+            cache.write();
+        }
+        Extensions extensions;
+        registerExtensions(extensions);
+        extensions.registerInstruction("testinstruction", "", 0x2001000);
+        const ScriptCache cache(mPath, extensions, 1);
+        EXPECT_EQ(cache.size(), 0);
+    }
+}
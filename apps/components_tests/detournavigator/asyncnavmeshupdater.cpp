@@ -156,6 +156,38 @@ namespace
         EXPECT_EQ(tile->mVersion, navMeshFormatVersion);
     }
 
+    TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, pending_db_writes_should_be_committed_on_stop)
+    {
+        mRecastMeshManager.setWorldspace(mWorldspace, nullptr);
+        addHeightFieldPlane(mRecastMeshManager);
+        addObject(mBox, mRecastMeshManager);
+        auto db = std::make_unique<NavMeshDb>(":memory:", std::numeric_limits<std::uint64_t>::max());
+        NavMeshDb* const dbPtr = db.get();
+        mSettings.mDbTransactionInterval = std::chrono::hours(1);
+        mSettings.mMaxDbTransactionSize = 1000;
+        AsyncNavMeshUpdater updater(mSettings, mRecastMeshManager, mOffMeshConnectionsManager, std::move(db));
+        const auto navMeshCacheItem = std::make_shared<GuardedNavMeshCacheItem>(1, mSettings);
+        const TilePosition tilePosition{ 0, 0 };
+        const std::map<TilePosition, ChangeType> changedTiles{ { tilePosition, ChangeType::add } };
+        updater.post(mAgentBounds, navMeshCacheItem, mPlayerTile, mWorldspace, changedTiles);
+        updater.wait(WaitConditionType::allJobsDone, &mListener);
+        updater.stop();
+        const auto stats = updater.getStats();
+        ASSERT_TRUE(stats.mDb.has_value());
+        EXPECT_EQ(stats.mDb->mWriteCount, 1);
+        EXPECT_EQ(stats.mDb->mCommitCount, 1);
+        EXPECT_EQ(stats.mDb->mPendingWriteCount, 0);
+        const auto recastMesh = mRecastMeshManager.getMesh(mWorldspace, tilePosition);
+        ASSERT_NE(recastMesh, nullptr);
+        ShapeId nextShapeId{ 1 };
+        const std::vector<DbRefGeometryObject> objects = makeDbRefGeometryObjects(recastMesh->getMeshSources(),
+            [&](const MeshSource& v) { return resolveMeshSource(*dbPtr, v, nextShapeId); });
+        const auto tile = dbPtr->findTile(
+            mWorldspace, tilePosition, serialize(mSettings.mRecast, mAgentBounds, *recastMesh, objects));
+        ASSERT_TRUE(tile.has_value());
+        EXPECT_EQ(tile->mTileId, 1);
+    }
+
     TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, post_when_writing_to_db_disabled_should_not_write_tiles)
     {
         mRecastMeshManager.setWorldspace(mWorldspace, nullptr);
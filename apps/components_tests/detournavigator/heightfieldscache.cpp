@@ -0,0 +1,115 @@
+#include "settings.hpp"
+
+#include <components/detournavigator/heightfieldscache.hpp>
+#include <components/detournavigator/makenavmesh.hpp>
+#include <components/detournavigator/preparednavmeshdata.hpp>
+#include <components/detournavigator/recastmesh.hpp>
+#include <components/detournavigator/recastmeshbuilder.hpp>
+#include <components/detournavigator/settingsutils.hpp>
+#include <components/detournavigator/stats.hpp>
+
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+    using namespace DetourNavigator::Tests;
+
+    std::shared_ptr<const RasterizedTile> makeRasterizedTile(std::size_t spans)
+    {
+        auto result = std::make_shared<RasterizedTile>();
+        result->mSpans.resize(spans);
+        return result;
+    }
+
+    struct DetourNavigatorHeightfieldsCacheTest : Test
+    {
+        const AgentBounds mAgentBounds{ CollisionShapeType::Aabb, { 29, 29, 66 } };
+        const TilePosition mTilePosition{ 0, 0 };
+        const Settings mSettings = makeSettings();
+        const osg::ref_ptr<const Resource::BulletShape> mSource{ nullptr };
+        const ObjectTransform mObjectTransform{ ESM::Position{ { 0, 0, 0 }, { 0, 0, 0 } }, 0.0f };
+        const ESM::RefId mWorldspace = ESM::RefId::stringRefId("sys::default");
+
+        std::shared_ptr<RecastMesh> makeRecastMesh(const btBoxShape* box)
+        {
+            RecastMeshBuilder builder(makeRealTileBoundsWithBorder(mSettings.mRecast, mTilePosition));
+            builder.addHeightfield(osg::Vec2i(0, 0), 8192, 0);
+            if (box != nullptr)
+                builder.addObject(static_cast<const btCollisionShape&>(*box),
+                    btTransform(btMatrix3x3::getIdentity(), btVector3(256, 256, 0)), AreaType_ground, mSource,
+                    mObjectTransform);
+            return std::move(builder).create(Version{ 0, 0 });
+        }
+    };
+
+    TEST_F(DetourNavigatorHeightfieldsCacheTest, get_for_empty_cache_should_return_nullptr)
+    {
+        HeightfieldsCache cache(1024);
+        EXPECT_EQ(cache.get(mAgentBounds, mTilePosition), nullptr);
+        const HeightfieldsCacheStats stats = cache.getStats();
+        EXPECT_EQ(stats.mGetCount, 1);
+        EXPECT_EQ(stats.mHitCount, 0);
+    }
+
+    TEST_F(DetourNavigatorHeightfieldsCacheTest, get_should_return_set_value)
+    {
+        HeightfieldsCache cache(1024);
+        const std::shared_ptr<const RasterizedTile> value = makeRasterizedTile(1);
+        cache.set(mAgentBounds, mTilePosition, std::shared_ptr(value));
+        EXPECT_EQ(cache.get(mAgentBounds, mTilePosition), value);
+        const HeightfieldsCacheStats stats = cache.getStats();
+        EXPECT_EQ(stats.mSize, getSize(*value));
+        EXPECT_EQ(stats.mTiles, 1);
+        EXPECT_EQ(stats.mHitCount, 1);
+    }
+
+    TEST_F(DetourNavigatorHeightfieldsCacheTest, set_should_ignore_value_exceeding_max_size)
+    {
+        HeightfieldsCache cache(1);
+        cache.set(mAgentBounds, mTilePosition, makeRasterizedTile(1));
+        EXPECT_EQ(cache.get(mAgentBounds, mTilePosition), nullptr);
+    }
+
+    TEST_F(DetourNavigatorHeightfieldsCacheTest, set_should_evict_least_recently_used_values)
+    {
+        const std::size_t size = getSize(*makeRasterizedTile(1));
+        HeightfieldsCache cache(2 * size);
+        const TilePosition tilePosition1(1, 0);
+        const TilePosition tilePosition2(2, 0);
+        const TilePosition tilePosition3(3, 0);
+        cache.set(mAgentBounds, tilePosition1, makeRasterizedTile(1));
+        cache.set(mAgentBounds, tilePosition2, makeRasterizedTile(1));
+        ASSERT_NE(cache.get(mAgentBounds, tilePosition1), nullptr);
+        cache.set(mAgentBounds, tilePosition3, makeRasterizedTile(1));
+        EXPECT_NE(cache.get(mAgentBounds, tilePosition1), nullptr);
+        EXPECT_EQ(cache.get(mAgentBounds, tilePosition2), nullptr);
+        EXPECT_NE(cache.get(mAgentBounds, tilePosition3), nullptr);
+        EXPECT_EQ(cache.getStats().mSize, 2 * size);
+    }
+
+    TEST_F(DetourNavigatorHeightfieldsCacheTest, prepare_with_cache_should_give_same_result_as_without)
+    {
+        HeightfieldsCache cache(std::numeric_limits<std::size_t>::max());
+        const std::shared_ptr<RecastMesh> initial = makeRecastMesh(nullptr);
+        ASSERT_NE(prepareNavMeshTileData(*initial, mWorldspace, mTilePosition, mAgentBounds, mSettings.mRecast, &cache),
+            nullptr);
+        EXPECT_EQ(cache.getStats().mTiles, 1);
+
+        const btBoxShape box(btVector3(64, 64, 32));
+        const std::shared_ptr<RecastMesh> changed = makeRecastMesh(&box);
+        const std::unique_ptr<PreparedNavMeshData> incremental
+            = prepareNavMeshTileData(*changed, mWorldspace, mTilePosition, mAgentBounds, mSettings.mRecast, &cache);
+        const std::unique_ptr<PreparedNavMeshData> full
+            = prepareNavMeshTileData(*changed, mWorldspace, mTilePosition, mAgentBounds, mSettings.mRecast);
+        ASSERT_NE(incremental, nullptr);
+        ASSERT_NE(full, nullptr);
+        EXPECT_EQ(*incremental, *full);
+        EXPECT_EQ(cache.getStats().mHitCount, 1);
+    }
+}
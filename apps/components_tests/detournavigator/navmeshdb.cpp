@@ -1,12 +1,20 @@
 #include "generate.hpp"
 
 #include <components/detournavigator/navmeshdb.hpp>
+#include <components/files/conversion.hpp>
+#include <components/misc/compression.hpp>
+#include <components/sqlite3/db.hpp>
+#include <components/sqlite3/statement.hpp>
+#include <components/testing/util.hpp>
 
 #include <DetourAlloc.h>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <sqlite3.h>
+
+#include <filesystem>
 #include <limits>
 #include <random>
 
@@ -176,4 +184,79 @@ namespace
         };
         EXPECT_THROW(f(), std::runtime_error);
     }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, tile_with_different_input_should_not_be_found)
+    {
+        const auto [worldspace, tilePosition, input, data] = insertTile(TileId{ 1 }, TileVersion{ 1 });
+        std::vector<std::byte> otherInput = input;
+        otherInput.back() = ~otherInput.back();
+        EXPECT_FALSE(mDb.findTile(worldspace, tilePosition, otherInput).has_value());
+        EXPECT_FALSE(mDb.getTileData(worldspace, tilePosition, otherInput).has_value());
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, tiles_with_different_inputs_at_same_position_should_be_found)
+    {
+        const auto first = insertTile(TileId{ 1 }, TileVersion{ 1 });
+        const auto second = insertTile(TileId{ 2 }, TileVersion{ 1 });
+        const auto firstResult = mDb.getTileData(first.mWorldspace, first.mTilePosition, first.mInput);
+        ASSERT_TRUE(firstResult.has_value());
+        EXPECT_EQ(firstResult->mTileId, TileId{ 1 });
+        EXPECT_EQ(firstResult->mData, first.mData);
+        const auto secondResult = mDb.getTileData(second.mWorldspace, second.mTilePosition, second.mInput);
+        ASSERT_TRUE(secondResult.has_value());
+        EXPECT_EQ(secondResult->mTileId, TileId{ 2 });
+        EXPECT_EQ(secondResult->mData, second.mData);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, should_migrate_db_without_input_hash)
+    {
+        const std::filesystem::path path = TestingOpenMW::outputFilePath("navmesh_v0.db");
+        std::filesystem::remove(path);
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const TilePosition tilePosition{ 3, 4 };
+        const std::vector<std::byte> input = generateData();
+        const std::vector<std::byte> data = generateData();
+        {
+            const Sqlite3::Db db = Sqlite3::makeDb(Files::pathToUnicodeString(path), R"(
+                CREATE TABLE tiles (
+                    tile_id INTEGER PRIMARY KEY,
+                    revision INTEGER NOT NULL DEFAULT 1,
+                    worldspace TEXT NOT NULL,
+                    tile_position_x INTEGER NOT NULL,
+                    tile_position_y INTEGER NOT NULL,
+                    version INTEGER NOT NULL,
+                    input BLOB,
+                    data BLOB
+                );
+
+                CREATE UNIQUE INDEX index_unique_tiles_by_worldspace_and_tile_position_and_input
+                    ON tiles (worldspace, tile_position_x, tile_position_y, input);
+            )");
+            const Sqlite3::StatementHandle statementHandle = Sqlite3::makeStatementHandle(*db,
+                "INSERT INTO tiles (tile_id, worldspace, version, tile_position_x, tile_position_y, input, data) "
+                "VALUES (7, ?, 1, ?, ?, ?, ?)");
+            sqlite3_stmt* const statement = statementHandle.get();
+            const std::string serializedWorldspace = worldspace.serializeText();
+            const std::vector<std::byte> compressedInput = Misc::compress(input);
+            const std::vector<std::byte> compressedData = Misc::compress(data);
+            sqlite3_bind_text(statement, 1, serializedWorldspace.data(), static_cast<int>(serializedWorldspace.size()),
+                SQLITE_STATIC);
+            sqlite3_bind_int(statement, 2, tilePosition.x());
+            sqlite3_bind_int(statement, 3, tilePosition.y());
+            sqlite3_bind_blob(
+                statement, 4, compressedInput.data(), static_cast<int>(compressedInput.size()), SQLITE_STATIC);
+            sqlite3_bind_blob(
+                statement, 5, compressedData.data(), static_cast<int>(compressedData.size()), SQLITE_STATIC);
+            EXPECT_EQ(sqlite3_step(statement), SQLITE_DONE);
+        }
+        for (int i = 0; i < 2; ++i)
+        {
+            NavMeshDb db(Files::pathToUnicodeString(path), std::numeric_limits<std::uint64_t>::max());
+            const auto result = db.getTileData(worldspace, tilePosition, input);
+            ASSERT_TRUE(result.has_value());
+            EXPECT_EQ(result->mTileId, TileId{ 7 });
+            EXPECT_EQ(result->mVersion, TileVersion{ 1 });
+            EXPECT_EQ(result->mData, data);
+        }
+    }
 }
@@ -561,4 +561,30 @@ namespace
         expected.mMinY = 1;
         EXPECT_EQ(recastMesh->getHeightfields(), std::vector<Heightfield>({ expected }));
     }
+
+    TEST_F(DetourNavigatorRecastMeshBuilderTest, make_mesh_for_heightfield_should_add_triangles_for_each_quad)
+    {
+        constexpr std::size_t size = 3;
+        constexpr std::array<float, 3 * 3> heights{ {
+            0, 1, 2, // row 0
+            3, 4, 5, // row 1
+            6, 7, 8, // row 2
+        } };
+        mBounds.mMin = osg::Vec2f(750, 750);
+        RecastMeshBuilder builder(mBounds);
+        builder.addHeightfield(osg::Vec2i(0, 0), 1000, heights.data(), size, 0, 8);
+        const auto recastMesh = std::move(builder).create(mVersion);
+        ASSERT_EQ(recastMesh->getHeightfields().size(), 1);
+        const Mesh mesh = makeMesh(recastMesh->getHeightfields().front());
+        EXPECT_EQ(mesh.getVertices(),
+            std::vector<float>({
+                500, 500, 4, // vertex 0
+                500, 1000, 7, // vertex 1
+                1000, 500, 5, // vertex 2
+                1000, 1000, 8, // vertex 3
+            }))
+            << mesh.getVertices();
+        EXPECT_EQ(mesh.getIndices(), std::vector<int>({ 0, 1, 3, 0, 3, 2 }));
+        EXPECT_EQ(mesh.getAreaTypes(), std::vector<AreaType>(2, AreaType_ground));
+    }
 }
@@ -0,0 +1,72 @@
+#include <components/interpreter/dispatchtable.hpp>
+
+#include <gtest/gtest.h>
+
+namespace Interpreter
+{
+    namespace
+    {
+        struct Handler
+        {
+        };
+
+        TEST(InterpreterDispatchTableTest, findShouldReturnNullptrWhenEmpty)
+        {
+            DispatchTable<Handler> table;
+            EXPECT_EQ(table.find(0), nullptr);
+            EXPECT_EQ(table.getRangesCount(), 0);
+        }
+
+        TEST(InterpreterDispatchTableTest, findShouldReturnInstalledHandler)
+        {
+            std::map<int, std::unique_ptr<Handler>> handlers;
+            handlers.emplace(3, std::make_unique<Handler>());
+            handlers.emplace(0x2000000, std::make_unique<Handler>());
+            DispatchTable<Handler> table;
+            table.build(handlers);
+            EXPECT_EQ(table.find(3), handlers[3].get());
+            EXPECT_EQ(table.find(0x2000000), handlers[0x2000000].get());
+        }
+
+        TEST(InterpreterDispatchTableTest, findShouldReturnNullptrForNotInstalledOpcode)
+        {
+            std::map<int, std::unique_ptr<Handler>> handlers;
+            handlers.emplace(1, std::make_unique<Handler>());
+            handlers.emplace(3, std::make_unique<Handler>());
+            handlers.emplace(0x20000, std::make_unique<Handler>());
+            DispatchTable<Handler> table;
+            table.build(handlers);
+            EXPECT_EQ(table.find(0), nullptr);
+            EXPECT_EQ(table.find(2), nullptr);
+            EXPECT_EQ(table.find(4), nullptr);
+            EXPECT_EQ(table.find(0x1ffff), nullptr);
+            EXPECT_EQ(table.find(0x20001), nullptr);
+            EXPECT_EQ(table.find(0xffffffff), nullptr);
+        }
+
+        TEST(InterpreterDispatchTableTest, buildShouldSplitDistantOpcodesIntoSeparateRanges)
+        {
+            std::map<int, std::unique_ptr<Handler>> handlers;
+            handlers.emplace(0, std::make_unique<Handler>());
+            handlers.emplace(70, std::make_unique<Handler>());
+            handlers.emplace(0x2000000, std::make_unique<Handler>());
+            handlers.emplace(0x2000325, std::make_unique<Handler>());
+            DispatchTable<Handler> table;
+            table.build(handlers);
+            EXPECT_EQ(table.getRangesCount(), 3);
+        }
+
+        TEST(InterpreterDispatchTableTest, buildShouldReplacePreviousContent)
+        {
+            std::map<int, std::unique_ptr<Handler>> handlers;
+            handlers.emplace(1, std::make_unique<Handler>());
+            DispatchTable<Handler> table;
+            table.build(handlers);
+            handlers.clear();
+            handlers.emplace(2, std::make_unique<Handler>());
+            table.build(handlers);
+            EXPECT_EQ(table.find(1), nullptr);
+            EXPECT_EQ(table.find(2), handlers[2].get());
+        }
+    }
+}
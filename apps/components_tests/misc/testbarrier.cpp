@@ -0,0 +1,55 @@
+#include <components/misc/barrier.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    void testPhases(unsigned spinCount)
+    {
+        constexpr unsigned threadsCount = 4;
+        constexpr int phasesCount = 1000;
+        Misc::Barrier barrier(threadsCount, spinCount);
+        std::atomic<int> arrived{ 0 };
+        int callbacks = 0;
+        bool failed = false;
+        std::vector<std::thread> threads;
+        for (unsigned i = 0; i < threadsCount; ++i)
+            threads.emplace_back([&] {
+                for (int phase = 0; phase < phasesCount; ++phase)
+                {
+                    arrived.fetch_add(1, std::memory_order_relaxed);
+                    barrier.wait([&] {
+                        if (arrived.load(std::memory_order_relaxed) != static_cast<int>(threadsCount) * (phase + 1))
+                            failed = true;
+                        ++callbacks;
+                    });
+                }
+            });
+        for (std::thread& thread : threads)
+            thread.join();
+        EXPECT_FALSE(failed);
+        EXPECT_EQ(callbacks, phasesCount);
+    }
+
+    TEST(MiscBarrierTest, waitShouldCallCallbackOnceAfterAllThreadsArrived)
+    {
+        testPhases(Misc::Barrier::sDefaultSpinCount);
+    }
+
+    TEST(MiscBarrierTest, waitWithoutSpinningShouldCallCallbackOnceAfterAllThreadsArrived)
+    {
+        testPhases(0);
+    }
+
+    TEST(MiscBarrierTest, waitForZeroThreadsShouldCallCallback)
+    {
+        Misc::Barrier barrier(0);
+        int callbacks = 0;
+        barrier.wait([&] { ++callbacks; });
+        EXPECT_EQ(callbacks, 1);
+    }
+}
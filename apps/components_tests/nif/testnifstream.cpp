@@ -0,0 +1,131 @@
+#include <components/files/memorystream.hpp>
+#include <components/nif/niffile.hpp>
+#include <components/nif/nifstream.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Nif
+{
+    namespace
+    {
+        using namespace testing;
+
+        template <class T>
+        void append(std::string& data, T value)
+        {
+            data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        struct NifNIFStreamTest : TestWithParam<bool>
+        {
+            NIFFile mFile{ VFS::Path::NormalizedView("test.nif") };
+            Reader mReader{ mFile, nullptr };
+            std::string mData;
+
+            NifNIFStreamTest()
+            {
+                mData = "Gamebryo File Format\n";
+                append<std::uint32_t>(mData, 42);
+                append<float>(mData, 1);
+                append<float>(mData, 2);
+                append<float>(mData, 3);
+                append<std::uint32_t>(mData, 3);
+                mData += "abc";
+                append<std::uint16_t>(mData, 13);
+            }
+
+            NIFStream makeStream()
+            {
+                if (GetParam())
+                    return NIFStream(mReader, std::make_unique<Files::IMemStream>(mData.data(), mData.size()), nullptr);
+                return NIFStream(mReader, std::make_unique<std::istringstream>(mData), nullptr);
+            }
+        };
+
+        TEST_P(NifNIFStreamTest, shouldReadFromMemoryOnlyForMemoryBackedStream)
+        {
+            EXPECT_EQ(makeStream().isMemoryBacked(), GetParam());
+        }
+
+        TEST_P(NifNIFStreamTest, shouldReadValues)
+        {
+            NIFStream stream = makeStream();
+            EXPECT_EQ(stream.getVersionString(), "Gamebryo File Format");
+            EXPECT_EQ(stream.get<std::uint32_t>(), 42);
+            EXPECT_EQ(stream.get<osg::Vec3f>(), osg::Vec3f(1, 2, 3));
+            EXPECT_EQ(stream.getSizedString(), "abc");
+            EXPECT_EQ(stream.get<std::uint16_t>(), 13);
+        }
+
+        TEST_P(NifNIFStreamTest, shouldReadDynamicBuffer)
+        {
+            NIFStream stream = makeStream();
+            stream.skip(mData.find('\n') + 1 + sizeof(std::uint32_t));
+            std::vector<float> values;
+            stream.readVector(values, 3);
+            EXPECT_EQ(values, std::vector<float>({ 1, 2, 3 }));
+        }
+
+        INSTANTIATE_TEST_SUITE_P(MemoryBacked, NifNIFStreamTest, Values(false, true));
+
+        struct NifNIFStreamTruncatedTest : TestWithParam<bool>
+        {
+            NIFFile mFile{ VFS::Path::NormalizedView("test.nif") };
+            Reader mReader{ mFile, nullptr };
+            const std::string mData = std::string(3, '\0');
+
+            NIFStream makeStream()
+            {
+                if (GetParam())
+                    return NIFStream(mReader, std::make_unique<Files::IMemStream>(mData.data(), mData.size()), nullptr);
+                return NIFStream(mReader, std::make_unique<std::istringstream>(mData), nullptr);
+            }
+        };
+
+        TEST_P(NifNIFStreamTruncatedTest, shouldThrowExceptionWhenReadingPastTheEnd)
+        {
+            NIFStream stream = makeStream();
+            EXPECT_THROW(stream.get<std::uint32_t>(), std::runtime_error);
+        }
+
+        TEST_P(NifNIFStreamTruncatedTest, shouldThrowExceptionWhenReadingDynamicBufferPastTheEnd)
+        {
+            NIFStream stream = makeStream();
+            std::vector<std::uint16_t> values;
+            EXPECT_THROW(stream.readVector(values, 2), std::runtime_error);
+        }
+
+        TEST_P(NifNIFStreamTruncatedTest, shouldThrowExceptionWhenReadingStringPastTheEnd)
+        {
+            NIFStream stream = makeStream();
+            EXPECT_THROW(stream.getSizedString(4), std::runtime_error);
+        }
+
+        TEST_P(NifNIFStreamTruncatedTest, shouldThrowExceptionWhenSkippingPastTheEnd)
+        {
+            NIFStream stream = makeStream();
+            EXPECT_THROW(stream.skip(4), std::runtime_error);
+        }
+
+        INSTANTIATE_TEST_SUITE_P(MemoryBacked, NifNIFStreamTruncatedTest, Values(false, true));
+
+        TEST(NifNIFStreamMemoryTest, shouldStartFromCurrentStreamPosition)
+        {
+            NIFFile file(VFS::Path::NormalizedView("test.nif"));
+            Reader reader(file, nullptr);
+            std::string data(2, '\0');
+            append<std::uint16_t>(data, 7);
+            auto input = std::make_unique<Files::IMemStream>(data.data(), data.size());
+            input->seekg(2);
+            NIFStream stream(reader, std::move(input), nullptr);
+            EXPECT_EQ(stream.get<std::uint16_t>(), 7);
+        }
+    }
+}
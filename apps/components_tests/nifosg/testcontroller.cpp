@@ -0,0 +1,84 @@
+#include <components/nif/nifkey.hpp>
+#include <components/nifosg/controller.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace
+{
+    using namespace testing;
+    using namespace NifOsg;
+
+    std::shared_ptr<Nif::FloatKeyMap> makeFloatKeyMap()
+    {
+        auto result = std::make_shared<Nif::FloatKeyMap>();
+        result->mInterpolationType = Nif::InterpolationType_Linear;
+        result->insert(1, Nif::FloatKey{ .mValue = 10 });
+        result->insert(2, Nif::FloatKey{ .mValue = 20 });
+        result->insert(4, Nif::FloatKey{ .mValue = 40 });
+        return result;
+    }
+
+    TEST(NifKeyMapTest, insertShouldKeepKeysSortedByTime)
+    {
+        Nif::FloatKeyMap keys;
+        keys.insert(2, Nif::FloatKey{ .mValue = 20 });
+        keys.insert(1, Nif::FloatKey{ .mValue = 10 });
+        keys.insert(3, Nif::FloatKey{ .mValue = 30 });
+        EXPECT_EQ(keys.mTimes, (std::vector<float>{ 1, 2, 3 }));
+        ASSERT_EQ(keys.mKeys.size(), 3);
+        EXPECT_EQ(keys.mKeys[0].mValue, 10);
+        EXPECT_EQ(keys.mKeys[1].mValue, 20);
+        EXPECT_EQ(keys.mKeys[2].mValue, 30);
+    }
+
+    TEST(NifKeyMapTest, insertShouldReplaceKeyWithSameTime)
+    {
+        Nif::FloatKeyMap keys;
+        keys.insert(1, Nif::FloatKey{ .mValue = 10 });
+        keys.insert(2, Nif::FloatKey{ .mValue = 20 });
+        keys.insert(1, Nif::FloatKey{ .mValue = 30 });
+        EXPECT_EQ(keys.mTimes, (std::vector<float>{ 1, 2 }));
+        ASSERT_EQ(keys.mKeys.size(), 2);
+        EXPECT_EQ(keys.mKeys[0].mValue, 30);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, interpKeyShouldReturnDefaultValueForEmptyKeys)
+    {
+        const FloatInterpolator interpolator(std::make_shared<Nif::FloatKeyMap>(), 42);
+        EXPECT_EQ(interpolator.interpKey(1), 42);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, interpKeyShouldClampToFirstAndLastKeys)
+    {
+        const FloatInterpolator interpolator(makeFloatKeyMap());
+        EXPECT_EQ(interpolator.interpKey(0), 10);
+        EXPECT_EQ(interpolator.interpKey(5), 40);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, interpKeyShouldInterpolateBetweenKeys)
+    {
+        const FloatInterpolator interpolator(makeFloatKeyMap());
+        EXPECT_FLOAT_EQ(interpolator.interpKey(1.5f), 15);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(2), 20);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(3), 30);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, interpKeyShouldSupportTimeGoingBackwards)
+    {
+        const FloatInterpolator interpolator(makeFloatKeyMap());
+        EXPECT_FLOAT_EQ(interpolator.interpKey(3), 30);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(1.5f), 15);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(3.5f), 35);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, interpKeyShouldUseConstantInterpolation)
+    {
+        const std::shared_ptr<Nif::FloatKeyMap> keys = makeFloatKeyMap();
+        keys->mInterpolationType = Nif::InterpolationType_Constant;
+        const FloatInterpolator interpolator(keys);
+        EXPECT_EQ(interpolator.interpKey(1.25f), 10);
+        EXPECT_EQ(interpolator.interpKey(1.75f), 20);
+    }
+}
@@ -5,6 +5,9 @@
 
 #include <osg/Object>
 
+#include <string>
+#include <vector>
+
 namespace Resource
 {
     namespace
@@ -373,5 +376,78 @@ namespace Resource
             cache->addEntryToObjectCache(key, value);
             EXPECT_TRUE(cache->checkInObjectCache(std::string_view("key"), 0));
         }
+
+        std::size_t getUnitCost(const osg::Object& /*object*/)
+        {
+            return 1;
+        }
+
+        TEST(ResourceGenericObjectCacheTest, shardedCacheShouldStoreValues)
+        {
+            osg::ref_ptr<GenericObjectCache<std::string>> cache(new GenericObjectCache<std::string>(4));
+            std::vector<osg::ref_ptr<Object>> values;
+            for (int i = 0; i < 16; ++i)
+            {
+                values.emplace_back(new Object);
+                cache->addEntryToObjectCache(std::to_string(i), values.back());
+            }
+            for (int i = 0; i < 16; ++i)
+                EXPECT_EQ(cache->getRefFromObjectCache(std::string_view(std::to_string(i))), values[i]) << i;
+            EXPECT_EQ(cache->getStats().mSize, 16);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, lowerBoundShouldReturnMinimumOverShards)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>(4));
+            for (int key : { 7, 3, 12, 5 })
+                cache->addEntryToObjectCache(key, nullptr);
+            const auto result = cache->lowerBound(4);
+            ASSERT_TRUE(result.has_value());
+            EXPECT_EQ(result->first, 5);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, getStatsShouldReturnTotalCost)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>(2, &getUnitCost));
+            cache->addEntryToObjectCache(1, new Object);
+            cache->addEntryToObjectCache(2, new Object);
+            cache->addEntryToObjectCache(2, new Object);
+            EXPECT_EQ(cache->getStats().mCost, 2);
+            cache->removeFromObjectCache(1);
+            EXPECT_EQ(cache->getStats().mCost, 1);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, updateShouldEvictLeastRecentlyUsedItemsOverBudget)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>(2, &getUnitCost));
+            cache->setMaxCost(2);
+
+            cache->addEntryToObjectCache(1, new Object, 3);
+            cache->addEntryToObjectCache(2, new Object, 1);
+            cache->addEntryToObjectCache(3, new Object, 2);
+
+            cache->update(3, 10);
+
+            EXPECT_EQ(cache->getRefFromObjectCacheOrNone(2), std::nullopt);
+            EXPECT_NE(cache->getRefFromObjectCache(1), nullptr);
+            EXPECT_NE(cache->getRefFromObjectCache(3), nullptr);
+            EXPECT_EQ(cache->getStats().mEvicted, 1);
+            EXPECT_EQ(cache->getStats().mCost, 2);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, updateShouldNotEvictItemsReferencedElsewhere)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>(1, &getUnitCost));
+            cache->setMaxCost(0);
+
+            osg::ref_ptr<Object> value(new Object);
+            cache->addEntryToObjectCache(1, value, 1);
+            cache->addEntryToObjectCache(2, new Object, 1);
+
+            cache->update(1, 10);
+
+            EXPECT_EQ(cache->getRefFromObjectCache(1), value);
+            EXPECT_EQ(cache->getRefFromObjectCacheOrNone(2), std::nullopt);
+        }
     }
 }
@@ -0,0 +1,70 @@
+#include <components/resource/templatediskcache.hpp>
+#include <components/sceneutil/serialize.hpp>
+
+#include <gtest/gtest.h>
+
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/MatrixTransform>
+#include <osg/NodeCallback>
+#include <osg/Texture2D>
+
+namespace Resource
+{
+    namespace
+    {
+        struct Callback : osg::NodeCallback
+        {
+        };
+
+        struct Node : osg::Node
+        {
+        };
+
+        TEST(ResourceTemplateDiskCacheTest, isLosslessShouldReturnTrueForGroupWithGeometry)
+        {
+            osg::ref_ptr<osg::Group> group(new osg::Group);
+            group->addChild(new osg::MatrixTransform);
+            group->addChild(new osg::Geometry);
+            EXPECT_TRUE(TemplateDiskCache::isLossless(*group));
+        }
+
+        TEST(ResourceTemplateDiskCacheTest, isLosslessShouldReturnFalseForNodeWithUpdateCallback)
+        {
+            osg::ref_ptr<osg::Group> group(new osg::Group);
+            group->setUpdateCallback(new Callback);
+            EXPECT_FALSE(TemplateDiskCache::isLossless(*group));
+        }
+
+        TEST(ResourceTemplateDiskCacheTest, isLosslessShouldReturnFalseForUnknownChildType)
+        {
+            osg::ref_ptr<osg::Group> group(new osg::Group);
+            group->addChild(new Node);
+            EXPECT_FALSE(TemplateDiskCache::isLossless(*group));
+        }
+
+        TEST(ResourceTemplateDiskCacheTest, isLosslessShouldReturnFalseForTextureWithEmbeddedImage)
+        {
+            osg::ref_ptr<osg::Texture2D> texture(new osg::Texture2D(new osg::Image));
+            osg::ref_ptr<osg::Geometry> geometry(new osg::Geometry);
+            geometry->getOrCreateStateSet()->setTextureAttributeAndModes(0, texture);
+            EXPECT_FALSE(TemplateDiskCache::isLossless(*geometry));
+        }
+
+        TEST(ResourceTemplateDiskCacheTest, isLosslessShouldReturnTrueForTextureWithExternalImage)
+        {
+            osg::ref_ptr<osg::Image> image(new osg::Image);
+            image->setFileName("textures/tx_test.dds");
+            osg::ref_ptr<osg::Texture2D> texture(new osg::Texture2D(image));
+            osg::ref_ptr<osg::Geometry> geometry(new osg::Geometry);
+            geometry->getOrCreateStateSet()->setTextureAttributeAndModes(0, texture);
+            EXPECT_TRUE(TemplateDiskCache::isLossless(*geometry));
+        }
+
+        TEST(ResourceTemplateDiskCacheTest, shouldNotBeUsableAfterSerializersRegistration)
+        {
+            SceneUtil::registerSerializers();
+            EXPECT_FALSE(TemplateDiskCache::isUsable());
+        }
+    }
+}
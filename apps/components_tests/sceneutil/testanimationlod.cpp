@@ -0,0 +1,87 @@
+#include <components/sceneutil/animationlod.hpp>
+
+#include <osg/Stats>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    TEST(SceneUtilAnimationLodTest, getUpdateIntervalShouldReturnOneForLargeSize)
+    {
+        const AnimationLod lod(100, 4);
+        EXPECT_EQ(lod.getUpdateInterval(100), 1);
+        EXPECT_EQ(lod.getUpdateInterval(1000), 1);
+    }
+
+    TEST(SceneUtilAnimationLodTest, getUpdateIntervalShouldGrowInverselyToSize)
+    {
+        const AnimationLod lod(100, 4);
+        EXPECT_EQ(lod.getUpdateInterval(99), 2);
+        EXPECT_EQ(lod.getUpdateInterval(50), 2);
+        EXPECT_EQ(lod.getUpdateInterval(49), 3);
+        EXPECT_EQ(lod.getUpdateInterval(34), 3);
+    }
+
+    TEST(SceneUtilAnimationLodTest, getUpdateIntervalShouldBeLimitedByMaxUpdateInterval)
+    {
+        const AnimationLod lod(100, 4);
+        EXPECT_EQ(lod.getUpdateInterval(25), 4);
+        EXPECT_EQ(lod.getUpdateInterval(1), 4);
+        EXPECT_EQ(lod.getUpdateInterval(0), 4);
+    }
+
+    TEST(SceneUtilAnimationLodTest, getStatsShouldReturnStatsOfLastCompleteFrame)
+    {
+        AnimationLod lod(100, 4);
+        lod.record(1, false);
+        lod.record(1, true);
+        lod.record(1, true);
+        EXPECT_EQ(lod.getStats().mUpdated, 0);
+        lod.record(2, false);
+        EXPECT_EQ(lod.getStats().mUpdated, 1);
+        EXPECT_EQ(lod.getStats().mSkipped, 2);
+    }
+
+    TEST(SceneUtilAnimationLodTest, reportStatsShouldCompleteFrameWithoutNextRecord)
+    {
+        AnimationLod lod(100, 4);
+        osg::Stats stats("test");
+        lod.record(1, false);
+        lod.record(1, true);
+        lod.reportStats(2, stats);
+        EXPECT_EQ(lod.getStats().mUpdated, 1);
+        EXPECT_EQ(lod.getStats().mSkipped, 1);
+    }
+
+    TEST(SceneUtilAnimationLodTest, reportStatsShouldResetStatsWhenFramePassedWithoutRecord)
+    {
+        AnimationLod lod(100, 4);
+        osg::Stats stats("test");
+        lod.record(1, false);
+        lod.reportStats(2, stats);
+        lod.reportStats(3, stats);
+        EXPECT_EQ(lod.getStats().mUpdated, 0);
+        EXPECT_EQ(lod.getStats().mSkipped, 0);
+    }
+
+    TEST(SceneUtilAnimationLodTest, recordShouldResetStatsWhenFramePassedWithoutRecord)
+    {
+        AnimationLod lod(100, 4);
+        lod.record(1, false);
+        lod.record(3, false);
+        EXPECT_EQ(lod.getStats().mUpdated, 0);
+    }
+
+    TEST(SceneUtilAnimationLodTest, recordAfterReportStatsShouldCountForReportedFrame)
+    {
+        AnimationLod lod(100, 4);
+        osg::Stats stats("test");
+        lod.reportStats(1, stats);
+        lod.record(1, true);
+        lod.reportStats(2, stats);
+        EXPECT_EQ(lod.getStats().mSkipped, 1);
+    }
+}
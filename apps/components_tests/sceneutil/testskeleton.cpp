@@ -0,0 +1,82 @@
+#include <components/sceneutil/skeleton.hpp>
+
+#include <osg/MatrixTransform>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    osg::ref_ptr<osg::MatrixTransform> makeBone(const std::string& name, const osg::Matrix& matrix)
+    {
+        osg::ref_ptr<osg::MatrixTransform> result = new osg::MatrixTransform(matrix);
+        result->setName(name);
+        return result;
+    }
+
+    void expectNear(const osg::Matrixf& actual, const osg::Matrixf& expected)
+    {
+        for (int row = 0; row < 4; ++row)
+            for (int column = 0; column < 4; ++column)
+                EXPECT_NEAR(actual(row, column), expected(row, column), 1e-5f) << row << " " << column;
+    }
+
+    struct SceneUtilSkeletonTest : Test
+    {
+        const osg::ref_ptr<Skeleton> mSkeleton = new Skeleton;
+        const osg::ref_ptr<osg::MatrixTransform> mRoot = makeBone("Root", osg::Matrix::translate(1, 2, 3));
+        const osg::ref_ptr<osg::MatrixTransform> mSpine
+            = makeBone("Spine", osg::Matrix::rotate(osg::PI_2, osg::Vec3(0, 0, 1)));
+        const osg::ref_ptr<osg::MatrixTransform> mHead = makeBone("Head", osg::Matrix::translate(0, 0, 10));
+
+        SceneUtilSkeletonTest()
+        {
+            mSkeleton->addChild(mRoot);
+            mRoot->addChild(mSpine);
+            mSpine->addChild(mHead);
+        }
+    };
+
+    TEST_F(SceneUtilSkeletonTest, getBoneIndexShouldReturnNulloptForMissingBone)
+    {
+        EXPECT_EQ(mSkeleton->getBoneIndex("Tail"), std::nullopt);
+    }
+
+    TEST_F(SceneUtilSkeletonTest, getBoneIndexShouldIgnoreCase)
+    {
+        EXPECT_EQ(mSkeleton->getBoneIndex("hEaD"), 2);
+    }
+
+    TEST_F(SceneUtilSkeletonTest, getBoneIndexShouldAddParentsBeforeBone)
+    {
+        EXPECT_EQ(mSkeleton->getBoneIndex("Head"), 2);
+        EXPECT_EQ(mSkeleton->getBoneIndex("Root"), 0);
+        EXPECT_EQ(mSkeleton->getBoneIndex("Spine"), 1);
+        EXPECT_EQ(mSkeleton->getBoneMatrices().size(), 3);
+    }
+
+    TEST_F(SceneUtilSkeletonTest, updateBoneMatricesShouldApplyParentMatrices)
+    {
+        const std::optional<std::size_t> head = mSkeleton->getBoneIndex("Head");
+        ASSERT_TRUE(head.has_value());
+        mSkeleton->updateBoneMatrices(1);
+        expectNear(mSkeleton->getBoneMatrices()[*head],
+            osg::Matrixf(mHead->getMatrix() * mSpine->getMatrix() * mRoot->getMatrix()));
+    }
+
+    TEST_F(SceneUtilSkeletonTest, updateBoneMatricesShouldUpdateOncePerFrame)
+    {
+        const std::optional<std::size_t> root = mSkeleton->getBoneIndex("Root");
+        ASSERT_TRUE(root.has_value());
+        mSkeleton->updateBoneMatrices(1);
+        mRoot->setMatrix(osg::Matrix::translate(4, 5, 6));
+        mSkeleton->updateBoneMatrices(1);
+        expectNear(mSkeleton->getBoneMatrices()[*root], osg::Matrixf::translate(1, 2, 3));
+        mSkeleton->updateBoneMatrices(2);
+        expectNear(mSkeleton->getBoneMatrices()[*root], osg::Matrixf::translate(4, 5, 6));
+    }
+}
@@ -0,0 +1,127 @@
+#include <components/sceneutil/skinning.hpp>
+
+#include <gtest/gtest.h>
+
+#include <initializer_list>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    template <class ArrayT, class ValueT = ArrayT::value_type>
+    osg::ref_ptr<ArrayT> makeArray(std::initializer_list<ValueT> values)
+    {
+        return new ArrayT(values.begin(), values.end());
+    }
+
+    struct SceneUtilSkinningTest : Test
+    {
+        const std::vector<osg::Matrixf> mBoneMatrices{
+            osg::Matrixf::rotate(0.5f, osg::Vec3f(0, 0, 1)) * osg::Matrixf::translate(1, 2, 3),
+            osg::Matrixf::rotate(-1.0f, osg::Vec3f(1, 0, 0)) * osg::Matrixf::translate(-4, 5, -6),
+        };
+        osg::ref_ptr<osg::Vec3Array> mSourcePositions
+            = makeArray<osg::Vec3Array>({ osg::Vec3f(1, 0, 0), osg::Vec3f(0, 1, 0), osg::Vec3f(0, 0, 1) });
+        osg::ref_ptr<osg::Vec3Array> mSourceNormals
+            = makeArray<osg::Vec3Array>({ osg::Vec3f(0, 0, 1), osg::Vec3f(1, 0, 0), osg::Vec3f(0, 1, 0) });
+        osg::ref_ptr<osg::Vec4Array> mSourceTangents = makeArray<osg::Vec4Array>(
+            { osg::Vec4f(0, 1, 0, 1), osg::Vec4f(0, 0, 1, -1), osg::Vec4f(1, 0, 0, 1) });
+        osg::ref_ptr<osg::Vec3Array> mPositions = new osg::Vec3Array(3);
+        osg::ref_ptr<osg::Vec3Array> mNormals = new osg::Vec3Array(3);
+        osg::ref_ptr<osg::Vec4Array> mTangents = new osg::Vec4Array(3);
+        const std::vector<SkinningInfluence> mInfluences{
+            SkinningInfluence{ .mBoneWeights = { { 0, 1.0f } }, .mVertices = { 0 } },
+            SkinningInfluence{ .mBoneWeights = { { 0, 0.25f }, { 1, 0.75f } }, .mVertices = { 1, 2 } },
+        };
+
+        SkinningArrays makeArrays() const
+        {
+            return SkinningArrays{
+                .mSourcePositions = mSourcePositions,
+                .mSourceNormals = mSourceNormals,
+                .mSourceTangents = mSourceTangents,
+                .mPositions = mPositions,
+                .mNormals = mNormals,
+                .mTangents = mTangents,
+            };
+        }
+
+        // Weighted sum of transformed vertices is the same as the vertex transformed by the weighted sum of matrices
+        osg::Vec3f blend(const SkinningInfluence& influence, const osg::Vec3f& position) const
+        {
+            osg::Vec3f result;
+            for (const auto& [bone, weight] : influence.mBoneWeights)
+                result += mBoneMatrices[bone].preMult(position) * weight;
+            return result;
+        }
+
+        osg::Vec3f blend3x3(const SkinningInfluence& influence, const osg::Vec3f& vector) const
+        {
+            osg::Vec3f result;
+            for (const auto& [bone, weight] : influence.mBoneWeights)
+                result += osg::Matrixf::transform3x3(vector, mBoneMatrices[bone]) * weight;
+            return result;
+        }
+    };
+
+    void expectNear(const osg::Vec3f& actual, const osg::Vec3f& expected)
+    {
+        EXPECT_NEAR(actual.x(), expected.x(), 1e-5f);
+        EXPECT_NEAR(actual.y(), expected.y(), 1e-5f);
+        EXPECT_NEAR(actual.z(), expected.z(), 1e-5f);
+    }
+
+    TEST_F(SceneUtilSkinningTest, skinShouldTransformVerticesByBlendedBoneMatrices)
+    {
+        skin(mInfluences, mBoneMatrices, nullptr, makeArrays());
+
+        for (const SkinningInfluence& influence : mInfluences)
+        {
+            for (const unsigned short vertex : influence.mVertices)
+            {
+                expectNear((*mPositions)[vertex], blend(influence, (*mSourcePositions)[vertex]));
+                expectNear((*mNormals)[vertex], blend3x3(influence, (*mSourceNormals)[vertex]));
+                const osg::Vec4f& source = (*mSourceTangents)[vertex];
+                const osg::Vec4f& tangent = (*mTangents)[vertex];
+                expectNear(osg::Vec3f(tangent.x(), tangent.y(), tangent.z()),
+                    blend3x3(influence, osg::Vec3f(source.x(), source.y(), source.z())));
+                EXPECT_EQ(tangent.w(), source.w());
+            }
+        }
+    }
+
+    TEST_F(SceneUtilSkinningTest, skinShouldApplyGeomToSkelMatrixAfterBoneMatrices)
+    {
+        const osg::Matrixf geomToSkelMatrix = osg::Matrixf::translate(10, 20, 30);
+
+        skin(mInfluences, mBoneMatrices, &geomToSkelMatrix, makeArrays());
+
+        expectNear((*mPositions)[1], geomToSkelMatrix.preMult(blend(mInfluences[1], (*mSourcePositions)[1])));
+        expectNear((*mNormals)[1], blend3x3(mInfluences[1], (*mSourceNormals)[1]));
+    }
+
+    TEST_F(SceneUtilSkinningTest, skinShouldIgnoreBonesWithZeroMatrix)
+    {
+        std::vector<osg::Matrixf> boneMatrices = mBoneMatrices;
+        boneMatrices[1] = osg::Matrixf(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+        skin(mInfluences, boneMatrices, nullptr, makeArrays());
+
+        expectNear((*mPositions)[1], mBoneMatrices[0].preMult((*mSourcePositions)[1]) * 0.25f);
+    }
+
+    TEST_F(SceneUtilSkinningTest, skinShouldOnlyTransformPositionsWithoutNormalsAndTangents)
+    {
+        SkinningArrays arrays = makeArrays();
+        arrays.mNormals = nullptr;
+        arrays.mTangents = nullptr;
+
+        skin(mInfluences, mBoneMatrices, nullptr, arrays);
+
+        expectNear((*mPositions)[0], blend(mInfluences[0], (*mSourcePositions)[0]));
+        expectNear((*mNormals)[0], osg::Vec3f());
+        EXPECT_EQ((*mTangents)[0], osg::Vec4f());
+    }
+}
@@ -0,0 +1,136 @@
+#include <components/sceneutil/skinningcache.hpp>
+
+#include <osg/Stats>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    struct SceneUtilSkinningCacheTest : Test
+    {
+        const std::vector<SkinningInfluence> mInfluences{
+            SkinningInfluence{ .mBoneWeights = { { 0, 1.0f } }, .mVertices = { 0, 1 } },
+        };
+        const osg::ref_ptr<osg::Vec3Array> mSourcePositions = new osg::Vec3Array(2);
+        const osg::Matrixf mPose = osg::Matrixf::translate(1, 2, 3);
+        SkinningCache mCache;
+
+        SceneUtilSkinningCacheTest()
+        {
+            (*mSourcePositions)[0] = osg::Vec3f(1, 0, 0);
+            (*mSourcePositions)[1] = osg::Vec3f(0, 1, 0);
+        }
+
+        osg::ref_ptr<SkinningResult> makeResult(const osg::Matrixf& pose, osg::ref_ptr<osg::Vec3Array> positions) const
+        {
+            const SkinningArrays arrays{ .mSourcePositions = mSourcePositions, .mPositions = positions };
+            return new SkinningResult(nullptr, mInfluences, std::vector<osg::Matrixf>{ pose }, std::nullopt, arrays);
+        }
+
+        osg::ref_ptr<SkinningResult> makeResult(const osg::Matrixf& pose) const
+        {
+            return makeResult(pose, new osg::Vec3Array(2));
+        }
+    };
+
+    TEST_F(SceneUtilSkinningCacheTest, getShouldReturnNullptrForNewPose)
+    {
+        EXPECT_EQ(mCache.get(1, makeResult(mPose)), nullptr);
+    }
+
+    TEST_F(SceneUtilSkinningCacheTest, getShouldReturnResultForSamePoseInSameFrame)
+    {
+        const osg::ref_ptr<SkinningResult> result = makeResult(mPose);
+        ASSERT_EQ(mCache.get(1, result), nullptr);
+        EXPECT_EQ(mCache.get(1, makeResult(mPose)), result);
+    }
+
+    TEST_F(SceneUtilSkinningCacheTest, getShouldReturnNullptrForDifferentPose)
+    {
+        ASSERT_EQ(mCache.get(1, makeResult(mPose)), nullptr);
+        EXPECT_EQ(mCache.get(1, makeResult(osg::Matrixf::translate(1, 2, 4))), nullptr);
+    }
+
+    TEST_F(SceneUtilSkinningCacheTest, getShouldReturnNullptrForSamePoseInNextFrame)
+    {
+        ASSERT_EQ(mCache.get(1, makeResult(mPose)), nullptr);
+        EXPECT_EQ(mCache.get(2, makeResult(mPose)), nullptr);
+    }
+
+    TEST_F(SceneUtilSkinningCacheTest, getStatsShouldReturnStatsOfLastCompleteFrame)
+    {
+        mCache.get(1, makeResult(mPose));
+        mCache.get(1, makeResult(mPose));
+        mCache.get(1, makeResult(osg::Matrixf::translate(1, 2, 4)));
+        mCache.get(2, makeResult(mPose));
+        const SkinningCacheStats stats = mCache.getStats();
+        EXPECT_EQ(stats.mGet, 3);
+        EXPECT_EQ(stats.mHit, 1);
+    }
+
+    TEST_F(SceneUtilSkinningCacheTest, reportStatsShouldCompleteFrameWithoutNextGet)
+    {
+        osg::Stats stats("test");
+        mCache.get(1, makeResult(mPose));
+        mCache.get(1, makeResult(mPose));
+        mCache.reportStats(2, stats);
+        const SkinningCacheStats cacheStats = mCache.getStats();
+        EXPECT_EQ(cacheStats.mGet, 2);
+        EXPECT_EQ(cacheStats.mHit, 1);
+    }
+
+    TEST_F(SceneUtilSkinningCacheTest, reportStatsShouldResetStatsWhenFramePassedWithoutGet)
+    {
+        osg::Stats stats("test");
+        mCache.get(1, makeResult(mPose));
+        mCache.reportStats(2, stats);
+        mCache.reportStats(3, stats);
+        EXPECT_EQ(mCache.getStats().mGet, 0);
+    }
+
+    TEST_F(SceneUtilSkinningCacheTest, getShouldResetStatsWhenFramePassedWithoutGet)
+    {
+        mCache.get(1, makeResult(mPose));
+        mCache.get(3, makeResult(mPose));
+        EXPECT_EQ(mCache.getStats().mGet, 0);
+    }
+
+    TEST_F(SceneUtilSkinningCacheTest, getAfterReportStatsShouldShareResultsInReportedFrame)
+    {
+        osg::Stats stats("test");
+        mCache.reportStats(1, stats);
+        const osg::ref_ptr<SkinningResult> result = makeResult(mPose);
+        ASSERT_EQ(mCache.get(1, result), nullptr);
+        EXPECT_EQ(mCache.get(1, makeResult(mPose)), result);
+    }
+
+    TEST_F(SceneUtilSkinningCacheTest, shareShouldCopySkinnedResult)
+    {
+        const osg::ref_ptr<osg::Vec3Array> positions = new osg::Vec3Array(2);
+        const osg::ref_ptr<SkinningResult> result = makeResult(mPose, positions);
+        result->doWork();
+
+        const osg::ref_ptr<osg::Vec3Array> sharedPositions = new osg::Vec3Array(2);
+        EXPECT_TRUE(result->share(SkinnedArrays{ .mPositions = sharedPositions }));
+        EXPECT_EQ((*sharedPositions)[0], osg::Vec3f(2, 2, 3));
+        EXPECT_EQ((*sharedPositions)[1], osg::Vec3f(1, 3, 3));
+    }
+
+    TEST_F(SceneUtilSkinningCacheTest, shareShouldCopyResultAfterSkinning)
+    {
+        const osg::ref_ptr<SkinningResult> result = makeResult(mPose);
+
+        const osg::ref_ptr<osg::Vec3Array> sharedPositions = new osg::Vec3Array(2);
+        EXPECT_FALSE(result->share(SkinnedArrays{ .mPositions = sharedPositions }));
+        EXPECT_EQ((*sharedPositions)[0], osg::Vec3f());
+
+        result->doWork();
+        EXPECT_EQ((*sharedPositions)[0], osg::Vec3f(2, 2, 3));
+        EXPECT_EQ((*sharedPositions)[1], osg::Vec3f(1, 3, 3));
+    }
+}
@@ -0,0 +1,164 @@
+#include <components/sceneutil/workqueue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace SceneUtil;
+
+    struct BlockingItem : WorkItem
+    {
+        std::atomic_bool mStarted{ false };
+        std::atomic_bool mRelease{ false };
+
+        void doWork() override
+        {
+            mStarted = true;
+            while (!mRelease)
+                std::this_thread::yield();
+        }
+    };
+
+    struct RecordingItem : WorkItem
+    {
+        int mValue;
+        std::mutex& mMutex;
+        std::vector<int>& mResult;
+
+        explicit RecordingItem(int value, std::mutex& mutex, std::vector<int>& result)
+            : mValue(value)
+            , mMutex(mutex)
+            , mResult(result)
+        {
+        }
+
+        void doWork() override
+        {
+            const std::lock_guard lock(mMutex);
+            mResult.push_back(mValue);
+        }
+    };
+
+    struct SceneUtilWorkQueueTest : ::testing::Test
+    {
+        std::mutex mMutex;
+        std::vector<int> mResult;
+
+        osg::ref_ptr<RecordingItem> makeItem(int value) { return new RecordingItem(value, mMutex, mResult); }
+
+        // Occupies the only thread so the following items are queued
+        static osg::ref_ptr<BlockingItem> block(WorkQueue& queue)
+        {
+            osg::ref_ptr<BlockingItem> item(new BlockingItem);
+            queue.addWorkItem(item);
+            while (!item->mStarted)
+                std::this_thread::yield();
+            return item;
+        }
+    };
+
+    TEST_F(SceneUtilWorkQueueTest, shouldProcessAllItems)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(4));
+        std::vector<osg::ref_ptr<RecordingItem>> items;
+        for (int i = 0; i < 100; ++i)
+        {
+            items.push_back(makeItem(i));
+            queue->addWorkItem(items.back());
+        }
+        for (const osg::ref_ptr<RecordingItem>& item : items)
+            item->waitTillDone();
+        EXPECT_EQ(mResult.size(), 100);
+        EXPECT_EQ(queue->getNumItems(), 0);
+    }
+
+    TEST_F(SceneUtilWorkQueueTest, shouldProcessItemsInPriorityOrder)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+        const osg::ref_ptr<BlockingItem> blocking = block(*queue);
+        const osg::ref_ptr<RecordingItem> low = makeItem(0);
+        const osg::ref_ptr<RecordingItem> normal = makeItem(1);
+        const osg::ref_ptr<RecordingItem> high = makeItem(2);
+        queue->addWorkItem(low, WorkPriority::Low);
+        queue->addWorkItem(normal, WorkPriority::Normal);
+        queue->addWorkItem(high, WorkPriority::High);
+        blocking->mRelease = true;
+        low->waitTillDone();
+        EXPECT_EQ(mResult, (std::vector<int>{ 2, 1, 0 }));
+    }
+
+    TEST_F(SceneUtilWorkQueueTest, shouldProcessItemsOfSamePriorityInOrder)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+        const osg::ref_ptr<BlockingItem> blocking = block(*queue);
+        std::vector<osg::ref_ptr<RecordingItem>> items;
+        for (int i = 0; i < 3; ++i)
+        {
+            items.push_back(makeItem(i));
+            queue->addWorkItem(items.back());
+        }
+        blocking->mRelease = true;
+        items.back()->waitTillDone();
+        EXPECT_EQ(mResult, (std::vector<int>{ 0, 1, 2 }));
+    }
+
+    TEST_F(SceneUtilWorkQueueTest, shouldSkipCancelledItems)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+        const osg::ref_ptr<BlockingItem> blocking = block(*queue);
+        const osg::ref_ptr<RecordingItem> cancelled = makeItem(0);
+        const osg::ref_ptr<RecordingItem> other = makeItem(1);
+        queue->addWorkItem(cancelled);
+        queue->addWorkItem(other);
+        cancelled->cancel();
+        blocking->mRelease = true;
+        cancelled->waitTillDone();
+        other->waitTillDone();
+        EXPECT_EQ(mResult, (std::vector<int>{ 1 }));
+    }
+
+    TEST_F(SceneUtilWorkQueueTest, numItemsShouldNotExceedNumberOfAddedItems)
+    {
+        constexpr int producersCount = 4;
+        constexpr int itemsPerProducer = 10000;
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(4));
+        std::atomic_size_t added{ 0 };
+        std::atomic_bool done{ false };
+        std::size_t exceeded = 0;
+        std::thread monitor([&] {
+            while (!done)
+            {
+                // Underflow of the counter shows up as a huge value
+                const std::size_t numItems = queue->getNumItems();
+                if (numItems > added)
+                    ++exceeded;
+            }
+        });
+        std::vector<std::thread> producers;
+        std::vector<osg::ref_ptr<WorkItem>> items(producersCount * itemsPerProducer);
+        for (int i = 0; i < producersCount; ++i)
+            producers.emplace_back([&, i] {
+                for (int j = 0; j < itemsPerProducer; ++j)
+                {
+                    osg::ref_ptr<WorkItem>& item = items[i * itemsPerProducer + j];
+                    item = new WorkItem;
+                    // Count the item before adding it to the queue, so the counter value is an upper bound
+                    ++added;
+                    queue->addWorkItem(item);
+                }
+            });
+        for (std::thread& producer : producers)
+            producer.join();
+        for (const osg::ref_ptr<WorkItem>& item : items)
+            item->waitTillDone();
+        done = true;
+        monitor.join();
+        EXPECT_EQ(exceeded, 0);
+        EXPECT_EQ(queue->getNumItems(), 0);
+    }
+}
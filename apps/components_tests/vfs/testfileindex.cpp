@@ -0,0 +1,72 @@
+#include <components/testing/util.hpp>
+#include <components/vfs/fileindex.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace VFS
+{
+    namespace
+    {
+        using namespace testing;
+        using namespace TestingOpenMW;
+
+        struct VFSFileIndexTest : Test
+        {
+            VFSTestFile mFirst{ "first" };
+            VFSTestFile mSecond{ "second" };
+            VFSTestFile mThird{ "third" };
+
+            FileIndex makeIndex()
+            {
+                FileMap map;
+                map.emplace(Path::Normalized("textures/b.dds"), &mSecond);
+                map.emplace(Path::Normalized("meshes/a.nif"), &mFirst);
+                map.emplace(Path::Normalized("textures/c/d.dds"), &mThird);
+                return FileIndex(std::move(map));
+            }
+        };
+
+        TEST_F(VFSFileIndexTest, shouldBeEmptyByDefault)
+        {
+            const FileIndex index;
+            EXPECT_TRUE(index.empty());
+            EXPECT_EQ(index.find("meshes/a.nif"), index.end());
+            EXPECT_EQ(index.lowerBound("meshes/a.nif"), index.end());
+        }
+
+        TEST_F(VFSFileIndexTest, shouldKeepFilesSortedByPath)
+        {
+            const FileIndex index = makeIndex();
+            ASSERT_EQ(index.size(), 3);
+            auto it = index.begin();
+            EXPECT_EQ(it++->first, "meshes/a.nif");
+            EXPECT_EQ(it++->first, "textures/b.dds");
+            EXPECT_EQ(it++->first, "textures/c/d.dds");
+        }
+
+        TEST_F(VFSFileIndexTest, findShouldReturnFileForExistingPath)
+        {
+            const FileIndex index = makeIndex();
+            const auto it = index.find("textures/b.dds");
+            ASSERT_NE(it, index.end());
+            EXPECT_EQ(it->second, &mSecond);
+        }
+
+        TEST_F(VFSFileIndexTest, findShouldReturnEndForMissingPath)
+        {
+            const FileIndex index = makeIndex();
+            EXPECT_EQ(index.find("textures/b"), index.end());
+            EXPECT_EQ(index.find("textures/b.ddss"), index.end());
+        }
+
+        TEST_F(VFSFileIndexTest, lowerBoundShouldReturnFirstNotLessPath)
+        {
+            const FileIndex index = makeIndex();
+            const auto it = index.lowerBound("textures/");
+            ASSERT_NE(it, index.end());
+            EXPECT_EQ(it->first, "textures/b.dds");
+        }
+    }
+}
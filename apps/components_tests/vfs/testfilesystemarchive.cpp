@@ -0,0 +1,90 @@
+#include <components/testing/util.hpp>
+#include <components/vfs/file.hpp>
+#include <components/vfs/filesystemarchive.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace VFS
+{
+    namespace
+    {
+        using namespace testing;
+        using namespace TestingOpenMW;
+
+        struct VFSFileSystemArchiveTest : Test
+        {
+            const std::string mName = UnitTest::GetInstance()->current_test_info()->name();
+            const std::filesystem::path mRoot = outputDirPath(mName);
+            const std::filesystem::path mSnapshotPath = outputFilePath(mName + ".bin");
+
+            void SetUp() override
+            {
+                std::filesystem::remove(mSnapshotPath);
+                createFile("Meshes/a.nif");
+                createFile("Textures/b.dds");
+            }
+
+            void createFile(const std::filesystem::path& path) const
+            {
+                std::filesystem::create_directories((mRoot / path).parent_path());
+                std::ofstream(mRoot / path) << "content";
+            }
+
+            static std::vector<std::string> list(FileSystemArchive& archive)
+            {
+                FileMap map;
+                archive.listResources(map);
+                std::vector<std::string> result;
+                for (const auto& [path, file] : map)
+                    result.emplace_back(path.value());
+                return result;
+            }
+        };
+
+        TEST_F(VFSFileSystemArchiveTest, shouldListFilesWithoutSnapshot)
+        {
+            FileSystemArchive archive(mRoot);
+            EXPECT_THAT(list(archive), ElementsAre("meshes/a.nif", "textures/b.dds"));
+        }
+
+        TEST_F(VFSFileSystemArchiveTest, shouldWriteSnapshot)
+        {
+            FileSystemArchive archive(mRoot, mSnapshotPath);
+            EXPECT_TRUE(std::filesystem::exists(mSnapshotPath));
+            EXPECT_THAT(list(archive), ElementsAre("meshes/a.nif", "textures/b.dds"));
+        }
+
+        TEST_F(VFSFileSystemArchiveTest, shouldUseSnapshotForNotModifiedDirectories)
+        {
+            FileSystemArchive(mRoot, mSnapshotPath);
+            FileSystemArchive archive(mRoot, mSnapshotPath);
+            EXPECT_THAT(list(archive), ElementsAre("meshes/a.nif", "textures/b.dds"));
+            FileMap map;
+            archive.listResources(map);
+            EXPECT_EQ(map.at(Path::Normalized("meshes/a.nif"))->getPath(), mRoot / "Meshes/a.nif");
+        }
+
+        TEST_F(VFSFileSystemArchiveTest, shouldIgnoreSnapshotWhenNestedDirectoryIsModified)
+        {
+            FileSystemArchive(mRoot, mSnapshotPath);
+            createFile("Meshes/c.nif");
+            std::filesystem::last_write_time(
+                mRoot / "Meshes", std::filesystem::last_write_time(mRoot / "Meshes") + std::chrono::seconds(1));
+            FileSystemArchive archive(mRoot, mSnapshotPath);
+            EXPECT_THAT(list(archive), ElementsAre("meshes/a.nif", "meshes/c.nif", "textures/b.dds"));
+        }
+
+        TEST_F(VFSFileSystemArchiveTest, shouldIgnoreCorruptedSnapshot)
+        {
+            std::ofstream(mSnapshotPath) << "corrupted";
+            FileSystemArchive archive(mRoot, mSnapshotPath);
+            EXPECT_THAT(list(archive), ElementsAre("meshes/a.nif", "textures/b.dds"));
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#include <components/testing/util.hpp>
+#include <components/vfs/manager.hpp>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+namespace VFS
+{
+    namespace
+    {
+        using namespace testing;
+        using namespace TestingOpenMW;
+
+        struct PrefetchCountingFile : VFSTestFile
+        {
+            int mPrefetched = 0;
+            bool mThrowOnPrefetch = false;
+
+            PrefetchCountingFile()
+                : VFSTestFile("content")
+            {
+            }
+
+            void prefetch() override
+            {
+                ++mPrefetched;
+                if (mThrowOnPrefetch)
+                    throw std::runtime_error("prefetch error");
+            }
+        };
+
+        struct VFSManagerTest : Test
+        {
+            PrefetchCountingFile mFirst;
+            PrefetchCountingFile mSecond;
+            std::unique_ptr<Manager> mVfs = createTestVFS({
+                { Path::NormalizedView("meshes/a.nif"), &mFirst },
+                { Path::NormalizedView("meshes/b.nif"), &mSecond },
+            });
+        };
+
+        TEST_F(VFSManagerTest, prefetchShouldPrefetchRequestedFiles)
+        {
+            const std::vector<Path::NormalizedView> names{ Path::NormalizedView("meshes/a.nif") };
+            mVfs->prefetch(names);
+            EXPECT_EQ(mFirst.mPrefetched, 1);
+            EXPECT_EQ(mSecond.mPrefetched, 0);
+        }
+
+        TEST_F(VFSManagerTest, prefetchShouldIgnoreMissingFiles)
+        {
+            const std::vector<Path::NormalizedView> names{ Path::NormalizedView("meshes/c.nif"),
+                Path::NormalizedView("meshes/b.nif") };
+            mVfs->prefetch(names);
+            EXPECT_EQ(mSecond.mPrefetched, 1);
+        }
+
+        TEST_F(VFSManagerTest, prefetchShouldIgnoreErrors)
+        {
+            mFirst.mThrowOnPrefetch = true;
+            const std::vector<Path::NormalizedView> names{ Path::NormalizedView("meshes/a.nif"),
+                Path::NormalizedView("meshes/b.nif") };
+            EXPECT_NO_THROW(mVfs->prefetch(names));
+            EXPECT_EQ(mFirst.mPrefetched, 1);
+            EXPECT_EQ(mSecond.mPrefetched, 1);
+        }
+    }
+}
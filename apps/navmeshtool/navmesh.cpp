@@ -183,20 +183,22 @@ namespace NavMeshTool
                 mHasTile.notify_one();
             }
 
-            Status wait()
+            Status wait(std::chrono::milliseconds transactionInterval, std::size_t maxTransactionSize)
             {
-                constexpr std::chrono::seconds transactionInterval(1);
                 std::unique_lock lock(mMutex);
                 auto start = std::chrono::steady_clock::now();
+                std::size_t committed = mProvided;
                 while (mProvided < mExpected && mStatus == Status::Ok)
                 {
                     mHasTile.wait(lock);
                     const auto now = std::chrono::steady_clock::now();
-                    if (now - start > transactionInterval)
+                    const std::size_t provided = mProvided;
+                    if (now - start > transactionInterval || provided - committed >= maxTransactionSize)
                     {
                         mTransaction.commit();
                         mTransaction = mDb.startTransaction(Sqlite3::TransactionMode::Immediate);
                         start = now;
+                        committed = provided;
                     }
                 }
                 logGeneratedTiles(mProvided, mExpected);
@@ -293,7 +295,8 @@ namespace NavMeshTool
                     navMeshTileConsumer));
         }
 
-        const Status status = navMeshTileConsumer->wait();
+        const Status status
+            = navMeshTileConsumer->wait(settings.mDbTransactionInterval, settings.mMaxDbTransactionSize);
         if (status == Status::Ok)
             navMeshTileConsumer->commit();
 
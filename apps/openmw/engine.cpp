@@ -3,7 +3,9 @@
 #include <cerrno>
 #include <chrono>
 #include <future>
+#include <string>
 #include <system_error>
+#include <utility>
 
 #include <osgDB/WriteFile>
 #include <osgViewer/ViewerEventHandlers>
@@ -22,6 +24,8 @@
 #include <components/sdlutil/imagetosurface.hpp>
 #include <components/sdlutil/sdlgraphicswindow.hpp>
 
+#include <components/resource/imagemanager.hpp>
+#include <components/resource/keyframemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/stats.hpp>
@@ -109,7 +113,21 @@ namespace
         // the forEachUserStatsValue loop is "run" at compile time, hence the settings manager is not available.
         // Unconditionnally add the async physics stats, and then remove it at runtime if necessary
         if (Settings::physics().mAsyncNumThreads == 0)
+        {
             profiler.removeUserStatsLine(" -Async");
+            return;
+        }
+
+        // Per phase durations of the async physics worker, without a bar since they have no begin and end
+        const std::pair<std::string, std::string> physicsWorkerPhases[] = {
+            { "Async PreStep", "physicsworker_prestep_time" },
+            { "Async PostStep", "physicsworker_poststep_time" },
+            { "Async PostSim", "physicsworker_postsim_time" },
+            { "Async Wait", "physicsworker_wait_time" },
+        };
+        for (const auto& [label, taken] : physicsWorkerPhases)
+            profiler.addUserStatsLine(
+                label, textColor, barColor, taken, multiplier, average, averageInInverseSpace, "", "", maxValue);
     }
 
     struct ScreenCaptureMessageBox
@@ -329,8 +347,7 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
 
         mResourceSystem->reportStats(frameNumber, stats);
 
-        stats->setAttribute(frameNumber, "WorkQueue", mWorkQueue->getNumItems());
-        stats->setAttribute(frameNumber, "WorkThread", mWorkQueue->getNumActiveThreads());
+        mWorkQueue->reportStats(frameNumber, *stats);
 
         mMechanicsManager->reportStats(frameNumber, *stats);
         mWorld->reportStats(frameNumber, *stats);
@@ -729,7 +746,8 @@ void OMW::Engine::prepareEngine()
 
     mVFS = std::make_unique<VFS::Manager>();
 
-    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true);
+    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true,
+        Settings::general().mCacheVfsIndex ? mCfgMgr.getCachePath() / "vfs" : std::filesystem::path());
 
     mResourceSystem = std::make_unique<Resource::ResourceSystem>(
         mVFS.get(), Settings::cells().mCacheExpiryDelay, &mEncoder.get()->getStatelessEncoder());
@@ -738,6 +756,12 @@ void OMW::Engine::prepareEngine()
         false); // keep to Off for now to allow better state sharing
     mResourceSystem->getSceneManager()->setFilterSettings(Settings::general().mTextureMagFilter,
         Settings::general().mTextureMinFilter, Settings::general().mTextureMipmap, Settings::general().mAnisotropy);
+    if (Settings::models().mCacheNifTemplates)
+        mResourceSystem->getSceneManager()->setTemplateDiskCacheDir(mCfgMgr.getCachePath() / "templates");
+    constexpr std::size_t mebibyte = 1024 * 1024;
+    mResourceSystem->getSceneManager()->setCacheBudget(Settings::cells().mSceneCacheBudget * mebibyte);
+    mResourceSystem->getImageManager()->setCacheBudget(Settings::cells().mImageCacheBudget * mebibyte);
+    mResourceSystem->getKeyframeManager()->setCacheBudget(Settings::cells().mKeyframeCacheBudget * mebibyte);
     mEnvironment.setResourceSystem(*mResourceSystem);
 
     mWorkQueue = new SceneUtil::WorkQueue(Settings::cells().mPreloadNumThreads);
@@ -887,7 +911,8 @@ void OMW::Engine::prepareEngine()
     mScriptContext = std::make_unique<MWScript::CompilerContext>(MWScript::CompilerContext::Type_Full);
     mScriptContext->setExtensions(&mExtensions);
 
-    mScriptManager = std::make_unique<MWScript::ScriptManager>(mWorld->getStore(), *mScriptContext, mWarningsMode);
+    mScriptManager = std::make_unique<MWScript::ScriptManager>(mWorld->getStore(), *mScriptContext, mWarningsMode,
+        Settings::general().mCacheCompiledScripts ? mCfgMgr.getCachePath() / "scripts.bin" : std::filesystem::path());
     mEnvironment.setScriptManager(*mScriptManager);
 
     // Create game mechanics system
@@ -140,6 +140,10 @@ namespace MWPhysics
         const osg::Vec3f& getLastStuckPosition() const { return mLastStuckPosition; }
         void setLastStuckPosition(osg::Vec3f position) { mLastStuckPosition = position; }
 
+        /// Time in seconds spent to move the actor during the last simulation step
+        double getMovementCost() const { return mMovementCost; }
+        void setMovementCost(double value) { mMovementCost = value; }
+
         bool canMoveToWaterSurface(float waterlevel, const btCollisionWorld* world) const;
 
         bool isActive() const { return mActive; }
@@ -181,6 +185,7 @@ namespace MWPhysics
 
         unsigned int mStuckFrames;
         osg::Vec3f mLastStuckPosition;
+        double mMovementCost = 0;
 
         osg::Vec3f mForce;
         bool mOnGround;
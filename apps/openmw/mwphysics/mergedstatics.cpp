@@ -0,0 +1,71 @@
+#include "mergedstatics.hpp"
+#include "mtphysics.hpp"
+
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+
+#include <cassert>
+
+namespace MWPhysics
+{
+    MergedStatics::MergedStatics(int collisionFilterGroup, int collisionFilterMask, PhysicsTaskScheduler* scheduler)
+        : mCollisionFilterGroup(collisionFilterGroup)
+        , mCollisionFilterMask(collisionFilterMask)
+        , mTaskScheduler(scheduler)
+        , mShape(std::make_unique<btCompoundShape>(true))
+        , mCollisionObject(std::make_unique<btCollisionObject>())
+    {
+        mCollisionObject->setCollisionShape(mShape.get());
+    }
+
+    MergedStatics::~MergedStatics()
+    {
+        if (!mObjects.empty())
+            mTaskScheduler->removeCollisionObject(mCollisionObject.get());
+    }
+
+    void MergedStatics::add(btCollisionObject& object)
+    {
+        assert(!mChildIndices.contains(&object));
+
+        const auto addChild = [&] {
+            mChildIndices.emplace(&object, mObjects.size());
+            mObjects.push_back(&object);
+            mShape->addChildShape(object.getWorldTransform(), object.getCollisionShape());
+        };
+
+        if (!mObjects.empty())
+            return mTaskScheduler->updateCollisionShape(mCollisionObject.get(), addChild);
+
+        // Empty compound has inverted bounds so it's added to the world only after getting the first child
+        addChild();
+        mTaskScheduler->addCollisionObject(mCollisionObject.get(), mCollisionFilterGroup, mCollisionFilterMask);
+    }
+
+    void MergedStatics::remove(const btCollisionObject& object)
+    {
+        const auto it = mChildIndices.find(&object);
+        if (it == mChildIndices.end())
+            return;
+
+        const std::size_t index = it->second;
+        mChildIndices.erase(it);
+
+        // Compound shape moves the last child in place of the removed one and so do we
+        const auto removeChild = [&] {
+            mShape->removeChildShapeByIndex(static_cast<int>(index));
+            mObjects[index] = mObjects.back();
+            mObjects.pop_back();
+            if (index < mObjects.size())
+                mChildIndices[mObjects[index]] = index;
+        };
+
+        if (mObjects.size() > 1)
+            return mTaskScheduler->updateCollisionShape(mCollisionObject.get(), removeChild);
+
+        mTaskScheduler->removeCollisionObject(mCollisionObject.get());
+        removeChild();
+        // Removal doesn't shrink local bounds, reset them to not keep the bounds of all removed children
+        mShape->recalculateLocalAabb();
+    }
+}
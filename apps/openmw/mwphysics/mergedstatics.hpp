@@ -0,0 +1,49 @@
+#ifndef OPENMW_MWPHYSICS_MERGEDSTATICS_H
+#define OPENMW_MWPHYSICS_MERGEDSTATICS_H
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class btCollisionObject;
+class btCompoundShape;
+
+namespace MWPhysics
+{
+    class PhysicsTaskScheduler;
+
+    /// @brief Single collision object in the world made of shapes of many immovable objects
+    /// @par Merged objects keep their own collision objects outside of the world to provide transform and shape.
+    /// Hits on merged shapes are reported without an object like for a heightfield.
+    class MergedStatics
+    {
+    public:
+        MergedStatics(int collisionFilterGroup, int collisionFilterMask, PhysicsTaskScheduler* scheduler);
+        ~MergedStatics();
+
+        MergedStatics(const MergedStatics&) = delete;
+        MergedStatics& operator=(const MergedStatics&) = delete;
+
+        /// @param object collision object not present in the world, has to outlive its presence here
+        void add(btCollisionObject& object);
+        void remove(const btCollisionObject& object);
+
+        bool empty() const { return mObjects.empty(); }
+        std::size_t size() const { return mObjects.size(); }
+
+        const btCollisionObject& getCollisionObject() const { return *mCollisionObject; }
+
+    private:
+        const int mCollisionFilterGroup;
+        const int mCollisionFilterMask;
+        PhysicsTaskScheduler* mTaskScheduler;
+        std::unique_ptr<btCompoundShape> mShape;
+        std::unique_ptr<btCollisionObject> mCollisionObject;
+        // Have the same order as mShape children
+        std::vector<const btCollisionObject*> mObjects;
+        std::unordered_map<const btCollisionObject*, std::size_t> mChildIndices;
+    };
+}
+
+#endif
@@ -1,8 +1,10 @@
 #include "mtphysics.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <mutex>
+#include <numeric>
 #include <optional>
 #include <shared_mutex>
 #include <stdexcept>
@@ -17,6 +19,7 @@
 #include "components/debug/debuglog.hpp"
 #include "components/misc/convert.hpp"
 #include <components/misc/barrier.hpp>
+#include <components/misc/hash.hpp>
 #include <components/settings/values.hpp>
 
 #include "../mwmechanics/actorutil.hpp"
@@ -137,6 +140,63 @@ namespace
         return ptr.getPosition() * interpolationFactor + ptr.getPreviousPosition() * (1.f - interpolationFactor);
     }
 
+    // Uses broadphase bounds to cover the object placement known to the ray tests
+    void invalidateRayCastCache(MWPhysics::RayCastCache& cache, const btCollisionObject& collisionObject)
+    {
+        const btBroadphaseProxy* const proxy = collisionObject.getBroadphaseHandle();
+        if (proxy == nullptr)
+            return;
+        cache.invalidate(Misc::Convert::toOsg(proxy->m_aabbMin), Misc::Convert::toOsg(proxy->m_aabbMax),
+            proxy->m_collisionFilterGroup, proxy->m_collisionFilterMask);
+    }
+
+    void updateSingleAabb(
+        btCollisionWorld& collisionWorld, MWPhysics::RayCastCache& cache, btCollisionObject& collisionObject)
+    {
+        invalidateRayCastCache(cache, collisionObject);
+        collisionWorld.updateSingleAabb(&collisionObject);
+        invalidateRayCastCache(cache, collisionObject);
+    }
+
+    MWPhysics::RayCastCacheValue castClosestRay(
+        const btCollisionWorld& collisionWorld, const MWPhysics::RayCastCacheKey& key)
+    {
+        const btVector3 from = Misc::Convert::toBullet(key.mFrom);
+        const btVector3 to = Misc::Convert::toBullet(key.mTo);
+        btCollisionWorld::ClosestRayResultCallback resultCallback(from, to);
+        resultCallback.m_collisionFilterGroup = key.mGroup;
+        resultCallback.m_collisionFilterMask = key.mMask;
+        collisionWorld.rayTest(from, to, resultCallback);
+        MWPhysics::RayCastCacheValue result;
+        result.mHit = resultCallback.hasHit();
+        if (result.mHit)
+        {
+            result.mHitPos = Misc::Convert::toOsg(resultCallback.m_hitPointWorld);
+            result.mHitNormal = Misc::Convert::toOsg(resultCallback.m_hitNormalWorld);
+            result.mHitObject = resultCallback.m_collisionObject;
+        }
+        return result;
+    }
+
+    MWPhysics::RayCastCacheKey makeLineOfSightKey(const MWPhysics::Actor& actor1, const MWPhysics::Actor& actor2)
+    {
+        return MWPhysics::RayCastCacheKey{
+            // eye level
+            .mFrom = actor1.getCollisionObjectPosition() + osg::Vec3f(0, 0, actor1.getHalfExtents().z() * 0.9),
+            .mTo = actor2.getCollisionObjectPosition() + osg::Vec3f(0, 0, actor2.getHalfExtents().z() * 0.9),
+            .mMask = MWPhysics::CollisionType_World | MWPhysics::CollisionType_HeightMap
+                | MWPhysics::CollisionType_Door,
+            .mGroup = MWPhysics::CollisionType_AnyPhysical,
+        };
+    }
+
+    double getMovementCost(const MWPhysics::Simulation& sim)
+    {
+        if (const auto* actor = std::get_if<MWPhysics::ActorSimulation>(&sim))
+            return actor->getData().mMovementCost;
+        return 0;
+    }
+
     using LockedActorSimulation
         = std::pair<std::shared_ptr<MWPhysics::Actor>, std::reference_wrapper<MWPhysics::ActorFrameData>>;
     using LockedProjectileSimulation
@@ -208,6 +268,7 @@ namespace
         struct UpdatePosition
         {
             btCollisionWorld* mCollisionWorld;
+            MWPhysics::RayCastCache& mRayCastCache;
             void operator()(const LockedActorSimulation& sim) const
             {
                 auto& [actor, frameDataRef] = sim;
@@ -216,7 +277,7 @@ namespace
                 {
                     frameData.mPosition = actor->getPosition(); // account for potential position change made by script
                     actor->updateCollisionObjectPosition();
-                    mCollisionWorld->updateSingleAabb(actor->getCollisionObject());
+                    updateSingleAabb(*mCollisionWorld, mRayCastCache, *actor->getCollisionObject());
                 }
             }
             void operator()(const LockedProjectileSimulation& sim) const
@@ -225,7 +286,7 @@ namespace
                 auto& frameData = frameDataRef.get();
                 proj->setPosition(frameData.mPosition);
                 proj->updateCollisionObjectPosition();
-                mCollisionWorld->updateSingleAabb(proj->getCollisionObject());
+                updateSingleAabb(*mCollisionWorld, mRayCastCache, *proj->getCollisionObject());
             }
         };
 
@@ -234,9 +295,12 @@ namespace
             const float mPhysicsDt;
             const btCollisionWorld* mCollisionWorld;
             const MWPhysics::WorldFrameData& mWorldFrameData;
+            const osg::Timer* mTimer;
             void operator()(const LockedActorSimulation& sim) const
             {
+                const osg::Timer_t start = mTimer->tick();
                 MWPhysics::MovementSolver::move(sim.second, mPhysicsDt, mCollisionWorld, mWorldFrameData);
+                sim.second.get().mMovementCost = mTimer->delta_s(start, mTimer->tick());
             }
             void operator()(const LockedProjectileSimulation& sim) const
             {
@@ -290,6 +354,7 @@ namespace
                     actor->setOnSlope(frameData.mIsOnSlope);
                     actor->setWalkingOnWater(frameData.mWalkingOnWater);
                     actor->setInertialForce(frameData.mInertia);
+                    actor->setMovementCost(frameData.mMovementCost);
                 }
             }
             void operator()(MWPhysics::ProjectileSimulation& sim) const
@@ -406,6 +471,7 @@ namespace MWPhysics
         , mTimeAccum(0.f)
         , mCollisionWorld(collisionWorld)
         , mDebugDrawer(debugDrawer)
+        , mRayCastCache(Settings::physics().mRaycastCacheSize)
         , mLockingPolicy(detectLockingPolicy())
         , mNumThreads(getNumThreads(mLockingPolicy))
         , mNumJobs(0)
@@ -535,15 +601,31 @@ namespace MWPhysics
             updateStats(frameStart, frameNumber, stats);
         }
 
+        mPreStepTime = 0;
+        mPostStepTime = 0;
+        mPostSimTime = 0;
+        mBarrierWaitTime.store(0, std::memory_order_relaxed);
+
         auto [numSteps, newDelta] = calculateStepConfig(timeAccum);
         timeAccum -= numSteps * newDelta;
 
+        // Actors and projectiles are moved every frame, not always updating their bounds
+        mRayCastCache.invalidate(CollisionType_Actor | CollisionType_Projectile, ~0);
+
         // init
         const Visitors::InitPosition vis{ mCollisionWorld };
         for (auto& sim : simulations)
         {
             std::visit(vis, sim);
         }
+
+        // Start with the most expensive simulations to not leave workers idle waiting for the last one.
+        // Costs are measured during the previous frame.
+        mSimulationsOrder.resize(simulations.size());
+        std::iota(mSimulationsOrder.begin(), mSimulationsOrder.end(), std::size_t{ 0 });
+        std::stable_sort(mSimulationsOrder.begin(), mSimulationsOrder.end(), [&](std::size_t lhs, std::size_t rhs) {
+            return getMovementCost(simulations[lhs]) > getMovementCost(simulations[rhs]);
+        });
         mPrevStepCount = numSteps;
         mRemainingSteps = numSteps;
         mTimeAccum = timeAccum;
@@ -647,7 +729,9 @@ namespace MWPhysics
     void PhysicsTaskScheduler::setCollisionFilterMask(btCollisionObject* collisionObject, int collisionFilterMask)
     {
         MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        invalidateRayCastCache(mRayCastCache, *collisionObject);
         collisionObject->getBroadphaseHandle()->m_collisionFilterMask = collisionFilterMask;
+        invalidateRayCastCache(mRayCastCache, *collisionObject);
     }
 
     void PhysicsTaskScheduler::addCollisionObject(
@@ -656,15 +740,26 @@ namespace MWPhysics
         MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
         mCollisionObjects.insert(collisionObject);
         mCollisionWorld->addCollisionObject(collisionObject, collisionFilterGroup, collisionFilterMask);
+        invalidateRayCastCache(mRayCastCache, *collisionObject);
     }
 
     void PhysicsTaskScheduler::removeCollisionObject(btCollisionObject* collisionObject)
     {
         MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
         mCollisionObjects.erase(collisionObject);
+        invalidateRayCastCache(mRayCastCache, *collisionObject);
         mCollisionWorld->removeCollisionObject(collisionObject);
     }
 
+    void PhysicsTaskScheduler::updateCollisionShape(
+        btCollisionObject* collisionObject, const std::function<void()>& update)
+    {
+        MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        update();
+        // Broadphase proxy still has the old bounds so the ray cache is invalidated for both
+        ::updateSingleAabb(*mCollisionWorld, mRayCastCache, *collisionObject);
+    }
+
     void PhysicsTaskScheduler::updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate)
     {
         if (immediate || mNumThreads == 0)
@@ -684,32 +779,82 @@ namespace MWPhysics
         MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
 
         auto req = LOSRequest(actor1, actor2);
-        auto result = std::find(mLOSCache.begin(), mLOSCache.end(), req);
-        if (result == mLOSCache.end())
+        const auto result = mLOSCacheIndex.find(req.mRawActors);
+        if (result == mLOSCacheIndex.end())
         {
             req.mResult = hasLineOfSight(actor1.get(), actor2.get());
+            mLOSCacheIndex.emplace(req.mRawActors, mLOSCache.size());
             mLOSCache.push_back(req);
             return req.mResult;
         }
-        result->mAge = 0;
-        return result->mResult;
+        LOSRequest& cached = mLOSCache[result->second];
+        cached.mAge = 0;
+        return cached.mResult;
+    }
+
+    RayCastCacheValue PhysicsTaskScheduler::castRay(const RayCastCacheKey& key)
+    {
+        RayCastCacheValue result;
+        castRays(std::span(&key, 1), std::span(&result, 1));
+        return result;
+    }
+
+    void PhysicsTaskScheduler::castRays(std::span<const RayCastCacheKey> keys, std::span<RayCastCacheValue> results)
+    {
+        assert(keys.size() == results.size());
+        // Results are stored under the same lock as used for the test to not race with invalidation
+        MaybeLock lock(mCollisionWorldMutex, mLockingPolicy);
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            if (const std::optional<RayCastCacheValue> cached = mRayCastCache.get(keys[i]))
+            {
+                results[i] = *cached;
+                continue;
+            }
+            results[i] = castClosestRay(*mCollisionWorld, keys[i]);
+            mRayCastCache.set(keys[i], results[i]);
+        }
+    }
+
+    RayCastCacheStats PhysicsTaskScheduler::getRayCastCacheStats() const
+    {
+        return mRayCastCache.getStats();
     }
 
     void PhysicsTaskScheduler::refreshLOSCache()
     {
+        constexpr int batchSize = 16;
+
         MaybeSharedLock lock(mLOSCacheMutex, mLockingPolicy);
+        std::array<RayCastCacheKey, batchSize> keys;
+        std::array<RayCastCacheValue, batchSize> results;
+        std::array<LOSRequest*, batchSize> requests;
         int job = 0;
         int numLOS = mLOSCache.size();
-        while ((job = mNextLOS.fetch_add(1, std::memory_order_relaxed)) < numLOS)
+        while ((job = mNextLOS.fetch_add(batchSize, std::memory_order_relaxed)) < numLOS)
         {
-            auto& req = mLOSCache[job];
-            auto actorPtr1 = req.mActors[0].lock();
-            auto actorPtr2 = req.mActors[1].lock();
+            std::size_t count = 0;
+            for (const int end = std::min(job + batchSize, numLOS); job < end; ++job)
+            {
+                auto& req = mLOSCache[job];
+                auto actorPtr1 = req.mActors[0].lock();
+                auto actorPtr2 = req.mActors[1].lock();
 
-            if (req.mAge++ > mLOSCacheExpiry || !actorPtr1 || !actorPtr2)
-                req.mStale = true;
-            else
-                req.mResult = hasLineOfSight(actorPtr1.get(), actorPtr2.get());
+                if (req.mAge++ > mLOSCacheExpiry || !actorPtr1 || !actorPtr2)
+                {
+                    req.mStale = true;
+                    continue;
+                }
+
+                keys[count] = makeLineOfSightKey(*actorPtr1, *actorPtr2);
+                requests[count] = &req;
+                ++count;
+            }
+
+            castRays(std::span(keys.data(), count), std::span(results.data(), count));
+
+            for (std::size_t i = 0; i < count; ++i)
+                requests[i]->mResult = !results[i].mHit;
         }
     }
 
@@ -730,17 +875,17 @@ namespace MWPhysics
         if (const auto actor = std::dynamic_pointer_cast<Actor>(ptr))
         {
             actor->updateCollisionObjectPosition();
-            mCollisionWorld->updateSingleAabb(actor->getCollisionObject());
+            ::updateSingleAabb(*mCollisionWorld, mRayCastCache, *actor->getCollisionObject());
         }
         else if (const auto object = std::dynamic_pointer_cast<Object>(ptr))
         {
             object->commitPositionChange();
-            mCollisionWorld->updateSingleAabb(object->getCollisionObject());
+            ::updateSingleAabb(*mCollisionWorld, mRayCastCache, *object->getCollisionObject());
         }
         else if (const auto projectile = std::dynamic_pointer_cast<Projectile>(ptr))
         {
             projectile->updateCollisionObjectPosition();
-            mCollisionWorld->updateSingleAabb(projectile->getCollisionObject());
+            ::updateSingleAabb(*mCollisionWorld, mRayCastCache, *projectile->getCollisionObject());
         }
     }
 
@@ -754,7 +899,7 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::updateActorsPositions()
     {
-        const Visitors::UpdatePosition impl{ mCollisionWorld };
+        const Visitors::UpdatePosition impl{ mCollisionWorld, mRayCastCache };
         const Visitors::WithLockedPtr<Visitors::UpdatePosition, MaybeExclusiveLock> vis{ impl, mCollisionWorldMutex,
             mLockingPolicy };
         for (Simulation& sim : *mSimulations)
@@ -763,36 +908,39 @@ namespace MWPhysics
 
     bool PhysicsTaskScheduler::hasLineOfSight(const Actor* actor1, const Actor* actor2)
     {
-        btVector3 pos1 = Misc::Convert::toBullet(
-            actor1->getCollisionObjectPosition() + osg::Vec3f(0, 0, actor1->getHalfExtents().z() * 0.9)); // eye level
-        btVector3 pos2 = Misc::Convert::toBullet(
-            actor2->getCollisionObjectPosition() + osg::Vec3f(0, 0, actor2->getHalfExtents().z() * 0.9));
-
-        btCollisionWorld::ClosestRayResultCallback resultCallback(pos1, pos2);
-        resultCallback.m_collisionFilterGroup = CollisionType_AnyPhysical;
-        resultCallback.m_collisionFilterMask = CollisionType_World | CollisionType_HeightMap | CollisionType_Door;
-
-        MaybeLock lockColWorld(mCollisionWorldMutex, mLockingPolicy);
-        mCollisionWorld->rayTest(pos1, pos2, resultCallback);
+        return !castRay(makeLineOfSightKey(*actor1, *actor2)).mHit;
+    }
 
-        return !resultCallback.hasHit();
+    template <class Callback>
+    void PhysicsTaskScheduler::waitBarrier(Misc::Barrier& barrier, double& phaseTime, Callback&& callback)
+    {
+        const osg::Timer_t start = mTimer->tick();
+        osg::Timer_t callbackTime = 0;
+        barrier.wait([&] {
+            const osg::Timer_t callbackStart = mTimer->tick();
+            callback();
+            callbackTime = mTimer->tick() - callbackStart;
+            phaseTime += mTimer->delta_s(0, callbackTime);
+        });
+        mBarrierWaitTime.fetch_add(mTimer->tick() - start - callbackTime, std::memory_order_relaxed);
     }
 
     void PhysicsTaskScheduler::doSimulation()
     {
         while (mRemainingSteps)
         {
-            mPreStepBarrier->wait([this] { afterPreStep(); });
+            waitBarrier(*mPreStepBarrier, mPreStepTime, [this] { afterPreStep(); });
             int job = 0;
-            const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData };
+            const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData, mTimer };
             const Visitors::WithLockedPtr<Visitors::Move, MaybeLock> vis{ impl, mCollisionWorldMutex, mLockingPolicy };
             while ((job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mNumJobs)
-                std::visit(vis, (*mSimulations)[job]);
+                std::visit(vis, (*mSimulations)[mSimulationsOrder[job]]);
 
-            mPostStepBarrier->wait([this] { afterPostStep(); });
+            waitBarrier(*mPostStepBarrier, mPostStepTime, [this] { afterPostStep(); });
         }
 
         refreshLOSCache();
+        // Main thread may read the stats once afterPostSim is done, so they are updated inside
         mPostSimBarrier->wait([this] { afterPostSim(); });
     }
 
@@ -805,6 +953,11 @@ namespace MWPhysics
             stats.setAttribute(mFrameNumber, "physicsworker_time_begin", mTimer->delta_s(mFrameStart, mTimeBegin));
             stats.setAttribute(mFrameNumber, "physicsworker_time_taken", mTimer->delta_s(mTimeBegin, mTimeEnd));
             stats.setAttribute(mFrameNumber, "physicsworker_time_end", mTimer->delta_s(mFrameStart, mTimeEnd));
+            stats.setAttribute(mFrameNumber, "physicsworker_prestep_time", mPreStepTime);
+            stats.setAttribute(mFrameNumber, "physicsworker_poststep_time", mPostStepTime);
+            stats.setAttribute(mFrameNumber, "physicsworker_postsim_time", mPostSimTime);
+            stats.setAttribute(mFrameNumber, "physicsworker_wait_time",
+                mTimer->delta_s(0, mBarrierWaitTime.load(std::memory_order_relaxed)));
         }
         mFrameStart = frameStart;
         mTimeBegin = mTimer->tick();
@@ -825,6 +978,15 @@ namespace MWPhysics
         return (*it)->getUserPointer();
     }
 
+    std::size_t PhysicsTaskScheduler::LOSRequestHash::operator()(
+        const std::array<const Actor*, 2>& actors) const noexcept
+    {
+        std::size_t result = 0;
+        Misc::hashCombine(result, actors[0]);
+        Misc::hashCombine(result, actors[1]);
+        return result;
+    }
+
     void PhysicsTaskScheduler::releaseSharedStates()
     {
         waitForWorkers();
@@ -861,13 +1023,19 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::afterPostSim()
     {
+        const osg::Timer_t start = mTimer->tick();
         {
             MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
-            mLOSCache.erase(
-                std::remove_if(mLOSCache.begin(), mLOSCache.end(), [](const LOSRequest& req) { return req.mStale; }),
-                mLOSCache.end());
+            const std::size_t erased = std::erase_if(mLOSCache, [](const LOSRequest& req) { return req.mStale; });
+            if (erased != 0)
+            {
+                mLOSCacheIndex.clear();
+                for (std::size_t i = 0; i < mLOSCache.size(); ++i)
+                    mLOSCacheIndex.emplace(mLOSCache[i].mRawActors, i);
+            }
         }
         mTimeEnd = mTimer->tick();
+        mPostSimTime = mTimer->delta_s(start, mTimeEnd);
         if (mWorkersSync != nullptr)
             mWorkersSync->workIsDone();
     }
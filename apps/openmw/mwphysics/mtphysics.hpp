@@ -1,13 +1,17 @@
 #ifndef OPENMW_MWPHYSICS_MTPHYSICS_H
 #define OPENMW_MWPHYSICS_MTPHYSICS_H
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <set>
 #include <shared_mutex>
+#include <span>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
@@ -17,6 +21,7 @@
 #include "components/misc/budgetmeasurement.hpp"
 #include "physicssystem.hpp"
 #include "ptrholder.hpp"
+#include "raycastcache.hpp"
 
 namespace Misc
 {
@@ -65,8 +70,15 @@ namespace MWPhysics
         void setCollisionFilterMask(btCollisionObject* collisionObject, int collisionFilterMask);
         void addCollisionObject(btCollisionObject* collisionObject, int collisionFilterGroup, int collisionFilterMask);
         void removeCollisionObject(btCollisionObject* collisionObject);
+        /// Modify shape of the collision object present in the world and update its bounds
+        void updateCollisionShape(btCollisionObject* collisionObject, const std::function<void()>& update);
         void updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate = false);
         bool getLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
+        /// Closest hit ray test reusing results of the previous identical requests
+        RayCastCacheValue castRay(const RayCastCacheKey& key);
+        /// Same as castRay for each key but the collision world is locked once for all cache misses
+        void castRays(std::span<const RayCastCacheKey> keys, std::span<RayCastCacheValue> results);
+        RayCastCacheStats getRayCastCacheStats() const;
         void debugDraw();
         void* getUserPointer(const btCollisionObject* object) const;
         void releaseSharedStates(); // destroy all objects whose destructor can't be safely called from
@@ -75,6 +87,11 @@ namespace MWPhysics
     private:
         class WorkersSync;
 
+        struct LOSRequestHash
+        {
+            std::size_t operator()(const std::array<const Actor*, 2>& actors) const noexcept;
+        };
+
         void doSimulation();
         void worker();
         void updateActorsPositions();
@@ -89,11 +106,14 @@ namespace MWPhysics
         void afterPostSim();
         void syncWithMainThread();
         void waitForWorkers();
+        template <class Callback>
+        void waitBarrier(Misc::Barrier& barrier, double& phaseTime, Callback&& callback);
         void prepareWork(float& timeAccum, std::vector<Simulation>& simulations, osg::Timer_t frameStart,
             unsigned int frameNumber, osg::Stats& stats);
 
         std::unique_ptr<WorldFrameData> mWorldFrameData;
         std::vector<Simulation>* mSimulations = nullptr;
+        std::vector<std::size_t> mSimulationsOrder;
         std::unordered_set<const btCollisionObject*> mCollisionObjects;
         float mDefaultPhysicsDt;
         float mPhysicsDt;
@@ -101,9 +121,10 @@ namespace MWPhysics
         btCollisionWorld* mCollisionWorld;
         MWRender::DebugDrawer* mDebugDrawer;
         std::vector<LOSRequest> mLOSCache;
+        std::unordered_map<std::array<const Actor*, 2>, std::size_t, LOSRequestHash> mLOSCacheIndex;
+        RayCastCache mRayCastCache;
         std::set<std::weak_ptr<PtrHolder>, std::owner_less<std::weak_ptr<PtrHolder>>> mUpdateAabb;
 
-        // TODO: use std::experimental::flex_barrier or std::barrier once it becomes a thing
         std::unique_ptr<Misc::Barrier> mPreStepBarrier;
         std::unique_ptr<Misc::Barrier> mPostStepBarrier;
         std::unique_ptr<Misc::Barrier> mPostSimBarrier;
@@ -134,6 +155,12 @@ namespace MWPhysics
         osg::Timer_t mTimeBegin;
         osg::Timer_t mTimeEnd;
         osg::Timer_t mFrameStart;
+        // Time spent in the single threaded phases and total time workers spent waiting for each other between
+        // simulation steps
+        double mPreStepTime = 0;
+        double mPostStepTime = 0;
+        double mPostSimTime = 0;
+        std::atomic<osg::Timer_t> mBarrierWaitTime{ 0 };
 
         std::unique_ptr<WorkersSync> mWorkersSync;
     };
@@ -1,4 +1,5 @@
 #include "object.hpp"
+#include "mergedstatics.hpp"
 #include "mtphysics.hpp"
 
 #include <components/bullethelpers/collisionobject.hpp>
@@ -15,7 +16,7 @@
 namespace MWPhysics
 {
     Object::Object(const MWWorld::Ptr& ptr, osg::ref_ptr<Resource::BulletShapeInstance> shapeInstance,
-        osg::Quat rotation, int collisionType, PhysicsTaskScheduler* scheduler)
+        osg::Quat rotation, int collisionType, PhysicsTaskScheduler* scheduler, MergedStatics* mergedStatics)
         : PtrHolder(ptr, osg::Vec3f())
         , mShapeInstance(std::move(shapeInstance))
         , mSolid(true)
@@ -23,19 +24,27 @@ namespace MWPhysics
         , mPosition(ptr.getRefData().getPosition().asVec3())
         , mRotation(rotation)
         , mTaskScheduler(scheduler)
+        , mMergedStatics(mergedStatics)
+        , mCollisionType(collisionType)
         , mCollidedWith(ScriptedCollisionType_None)
     {
         mCollisionObject = BulletHelpers::makeCollisionObject(mShapeInstance->mCollisionShape.get(),
             Misc::Convert::toBullet(mPosition), Misc::Convert::toBullet(rotation));
         mCollisionObject->setUserPointer(this);
         mShapeInstance->setLocalScaling(mScale);
-        mTaskScheduler->addCollisionObject(mCollisionObject.get(), collisionType,
-            CollisionType_Actor | CollisionType_HeightMap | CollisionType_Projectile);
+        if (mMergedStatics != nullptr)
+            mMergedStatics->add(*mCollisionObject);
+        else
+            mTaskScheduler->addCollisionObject(mCollisionObject.get(), collisionType,
+                CollisionType_Actor | CollisionType_HeightMap | CollisionType_Projectile);
     }
 
     Object::~Object()
     {
-        mTaskScheduler->removeCollisionObject(mCollisionObject.get());
+        if (mMergedStatics != nullptr)
+            mMergedStatics->remove(*mCollisionObject);
+        else
+            mTaskScheduler->removeCollisionObject(mCollisionObject.get());
     }
 
     const Resource::BulletShapeInstance* Object::getShapeInstance() const
@@ -43,6 +52,21 @@ namespace MWPhysics
         return mShapeInstance.get();
     }
 
+    MergedStatics* Object::getMergedStatics() const
+    {
+        return mMergedStatics;
+    }
+
+    void Object::unmerge()
+    {
+        if (mMergedStatics == nullptr)
+            return;
+        mMergedStatics->remove(*mCollisionObject);
+        mMergedStatics = nullptr;
+        mTaskScheduler->addCollisionObject(mCollisionObject.get(), mCollisionType,
+            CollisionType_Actor | CollisionType_HeightMap | CollisionType_Projectile);
+    }
+
     void Object::setScale(float scale)
     {
         std::unique_lock<std::mutex> lock(mPositionMutex);
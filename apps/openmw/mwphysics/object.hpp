@@ -16,6 +16,7 @@ namespace Resource
 
 namespace MWPhysics
 {
+    class MergedStatics;
     class PhysicsTaskScheduler;
 
     enum ScriptedCollisionType : char
@@ -30,7 +31,7 @@ namespace MWPhysics
     {
     public:
         Object(const MWWorld::Ptr& ptr, osg::ref_ptr<Resource::BulletShapeInstance> shapeInstance, osg::Quat rotation,
-            int collisionType, PhysicsTaskScheduler* scheduler);
+            int collisionType, PhysicsTaskScheduler* scheduler, MergedStatics* mergedStatics = nullptr);
         ~Object() override;
 
         const Resource::BulletShapeInstance* getShapeInstance() const;
@@ -49,6 +50,10 @@ namespace MWPhysics
         bool collidedWith(ScriptedCollisionType type) const;
         void addCollision(ScriptedCollisionType type);
         void resetCollisions();
+        /// Return merged statics containing the object shape instead of having own collision object in the world.
+        MergedStatics* getMergedStatics() const;
+        /// Move collision from merged statics to own collision object in the world. Required to change transform.
+        void unmerge();
 
     private:
         osg::ref_ptr<Resource::BulletShapeInstance> mShapeInstance;
@@ -61,6 +66,8 @@ namespace MWPhysics
         bool mTransformUpdatePending = false;
         mutable std::mutex mPositionMutex;
         PhysicsTaskScheduler* mTaskScheduler;
+        MergedStatics* mMergedStatics;
+        int mCollisionType;
         char mCollidedWith;
     };
 }
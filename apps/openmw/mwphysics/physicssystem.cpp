@@ -8,7 +8,7 @@
 #include <osg/Stats>
 #include <osg/Timer>
 
-#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/BroadphaseCollision/btBroadphaseInterface.h>
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 #include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
@@ -19,9 +19,11 @@
 #include <LinearMath/btQuickprof.h>
 #include <LinearMath/btVector3.h>
 
+#include <components/bullethelpers/broadphase.hpp>
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/loadgmst.hpp>
 #include <components/esm3/loadmgef.hpp>
+#include <components/esm3/loadstat.hpp>
 #include <components/misc/convert.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/conversion.hpp>
@@ -51,6 +53,7 @@
 #include "contacttestresultcallback.hpp"
 #include "hasspherecollisioncallback.hpp"
 #include "heightfield.hpp"
+#include "mergedstatics.hpp"
 #include "movementsolver.hpp"
 #include "mtphysics.hpp"
 #include "object.hpp"
@@ -105,11 +108,15 @@ namespace MWPhysics
         , mParentNode(std::move(parentNode))
         , mPhysicsDt(1.f / 60.f)
     {
+        mShapeManager->setCacheBudget(Settings::cells().mBulletShapeCacheBudget * 1024 * 1024);
         mResourceSystem->addResourceManager(mShapeManager.get());
 
         mCollisionConfiguration = std::make_unique<btDefaultCollisionConfiguration>();
         mDispatcher = std::make_unique<btCollisionDispatcher>(mCollisionConfiguration.get());
-        mBroadphase = std::make_unique<btDbvtBroadphase>();
+        const std::string& broadphase = Settings::physics().mBroadphase;
+        mBroadphase = BulletHelpers::makeQueryBroadphase(
+            BulletHelpers::parseBroadphaseType(broadphase).value_or(BulletHelpers::BroadphaseType::Dbvt));
+        Log(Debug::Info) << "Using " << broadphase << " physics broadphase";
 
         mCollisionWorld
             = std::make_unique<btCollisionWorld>(mDispatcher.get(), mBroadphase.get(), mCollisionConfiguration.get());
@@ -144,6 +151,7 @@ namespace MWPhysics
         mTaskScheduler->releaseSharedStates();
         mHeightFields.clear();
         mObjects.clear();
+        mMergedStatics.clear();
         mActors.clear();
         mProjectiles.clear();
     }
@@ -162,6 +170,36 @@ namespace MWPhysics
         return mDebugDrawEnabled;
     }
 
+    MergedStatics* PhysicsSystem::getMergedStatics(const MWWorld::Ptr& ptr, int collisionType)
+    {
+        // Only objects that are not expected to move or report collisions with them are merged
+        if (!Settings::physics().mMergeCellStatics || ptr.getType() != ESM::Static::sRecordId
+            || collisionType != CollisionType_World || ptr.getCell() == nullptr)
+            return nullptr;
+
+        std::unique_ptr<MergedStatics>& result = mMergedStatics[ptr.getCell()];
+        if (result == nullptr)
+            result = std::make_unique<MergedStatics>(collisionType,
+                CollisionType_Actor | CollisionType_HeightMap | CollisionType_Projectile, mTaskScheduler.get());
+        return result.get();
+    }
+
+    void PhysicsSystem::unmerge(Object& object)
+    {
+        const MergedStatics* const mergedStatics = object.getMergedStatics();
+        if (mergedStatics == nullptr)
+            return;
+        object.unmerge();
+        removeIfEmpty(mergedStatics);
+    }
+
+    void PhysicsSystem::removeIfEmpty(const MergedStatics* mergedStatics)
+    {
+        if (mergedStatics == nullptr || !mergedStatics->empty())
+            return;
+        std::erase_if(mMergedStatics, [&](const auto& v) { return v.second.get() == mergedStatics; });
+    }
+
     void PhysicsSystem::markAsNonSolid(const MWWorld::ConstPtr& ptr)
     {
         ObjectMap::iterator found = mObjects.find(ptr.mRef);
@@ -233,6 +271,26 @@ namespace MWPhysics
             }
         }
 
+        if (ignoreList.empty() && targetCollisionObjects.empty())
+        {
+            const RayCastCacheValue value = mTaskScheduler->castRay(RayCastCacheKey{
+                .mFrom = from,
+                .mTo = to,
+                .mMask = mask,
+                .mGroup = group,
+            });
+            RayCastingResult result;
+            result.mHit = value.mHit;
+            if (value.mHit)
+            {
+                result.mHitPos = value.mHitPos;
+                result.mHitNormal = value.mHitNormal;
+                if (PtrHolder* ptrHolder = static_cast<PtrHolder*>(mTaskScheduler->getUserPointer(value.mHitObject)))
+                    result.mHitObject = ptrHolder->getPtr();
+            }
+            return result;
+        }
+
         ClosestNotMeRayResultCallback resultCallback(ignoreList, targetCollisionObjects, btFrom, btTo);
         resultCallback.m_collisionFilterGroup = group;
         resultCallback.m_collisionFilterMask = mask;
@@ -434,7 +492,10 @@ namespace MWPhysics
                 break;
         }
 
-        auto obj = std::make_shared<Object>(ptr, shapeInstance, rotation, collisionType, mTaskScheduler.get());
+        MergedStatics* const mergedStatics
+            = shapeInstance->isAnimated() ? nullptr : getMergedStatics(ptr, collisionType);
+        auto obj = std::make_shared<Object>(
+            ptr, shapeInstance, rotation, collisionType, mTaskScheduler.get(), mergedStatics);
         mObjects.emplace(ptr.mRef, obj);
 
         if (obj->isAnimated())
@@ -447,6 +508,8 @@ namespace MWPhysics
         {
             mAnimatedObjects.erase(foundObject->second.get());
 
+            // Object may outlive the map entry when shared with the scheduler, don't leave its shape merged
+            unmerge(*foundObject->second);
             mObjects.erase(foundObject);
         }
         else if (auto foundActor = mActors.find(ptr.mRef); foundActor != mActors.end())
@@ -518,6 +581,7 @@ namespace MWPhysics
     {
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
+            unmerge(*foundObject->second);
             float scale = ptr.getCellRef().getScale();
             foundObject->second->setScale(scale);
             mTaskScheduler->updateSingleAabb(foundObject->second);
@@ -533,6 +597,7 @@ namespace MWPhysics
     {
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
+            unmerge(*foundObject->second);
             foundObject->second->setRotation(rotate);
             mTaskScheduler->updateSingleAabb(foundObject->second);
         }
@@ -550,6 +615,7 @@ namespace MWPhysics
     {
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
+            unmerge(*foundObject->second);
             foundObject->second->updatePosition();
             mTaskScheduler->updateSingleAabb(foundObject->second);
         }
@@ -891,6 +957,11 @@ namespace MWPhysics
         stats.setAttribute(frameNumber, "Physics Objects", mObjects.size());
         stats.setAttribute(frameNumber, "Physics Projectiles", mProjectiles.size());
         stats.setAttribute(frameNumber, "Physics HeightFields", mHeightFields.size());
+
+        const RayCastCacheStats rayCastCacheStats = mTaskScheduler->getRayCastCacheStats();
+        stats.setAttribute(frameNumber, "Physics RayCastCache Count", rayCastCacheStats.mSize);
+        stats.setAttribute(frameNumber, "Physics RayCastCache Get", rayCastCacheStats.mGetCount);
+        stats.setAttribute(frameNumber, "Physics RayCastCache Hit", rayCastCacheStats.mHitCount);
     }
 
     void PhysicsSystem::reportCollision(const btVector3& position, const btVector3& normal)
@@ -922,6 +993,7 @@ namespace MWPhysics
         , mHalfExtentsZ(actor.getHalfExtents().z())
         , mOldHeight(0)
         , mStuckFrames(0)
+        , mMovementCost(actor.getMovementCost())
         , mFlying(MWBase::Environment::get().getWorld()->isFlying(actor.getPtr()))
         , mWasOnGround(actor.getOnGround())
         , mIsAquatic(actor.getPtr().getClass().isPureWaterCreature(actor.getPtr()))
@@ -52,6 +52,7 @@ class btVector3;
 namespace MWPhysics
 {
     class HeightField;
+    class MergedStatics;
     class Object;
     class Actor;
     class PhysicsTaskScheduler;
@@ -98,6 +99,7 @@ namespace MWPhysics
         const float mHalfExtentsZ;
         float mOldHeight;
         unsigned int mStuckFrames;
+        double mMovementCost;
         const bool mFlying;
         const bool mWasOnGround;
         const bool mIsAquatic;
@@ -140,6 +142,8 @@ namespace MWPhysics
             return std::nullopt;
         }
 
+        const FrameData& getData() const { return mData; }
+
     private:
         std::weak_ptr<Ptr> mPtr;
         FrameData mData;
@@ -292,6 +296,12 @@ namespace MWPhysics
 
         void prepareSimulation(bool willSimulate, std::vector<Simulation>& simulations);
 
+        MergedStatics* getMergedStatics(const MWWorld::Ptr& ptr, int collisionType);
+
+        void unmerge(Object& object);
+
+        void removeIfEmpty(const MergedStatics* mergedStatics);
+
         std::unique_ptr<btBroadphaseInterface> mBroadphase;
         std::unique_ptr<btDefaultCollisionConfiguration> mCollisionConfiguration;
         std::unique_ptr<btCollisionDispatcher> mDispatcher;
@@ -301,6 +311,9 @@ namespace MWPhysics
         std::unique_ptr<Resource::BulletShapeManager> mShapeManager;
         Resource::ResourceSystem* mResourceSystem;
 
+        // Should outlive objects merged into them
+        std::unordered_map<const MWWorld::CellStore*, std::unique_ptr<MergedStatics>> mMergedStatics;
+
         using ObjectMap = std::unordered_map<const MWWorld::LiveCellRefBase*, std::shared_ptr<Object>>;
         ObjectMap mObjects;
 
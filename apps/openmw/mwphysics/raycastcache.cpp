@@ -0,0 +1,186 @@
+#include "raycastcache.hpp"
+
+#include <components/misc/hash.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace MWPhysics
+{
+    namespace
+    {
+        int getCell(float value)
+        {
+            return static_cast<int>(std::floor(value / RayCastCache::sCellSize));
+        }
+
+        bool intersects(const osg::Vec3f& lhsMin, const osg::Vec3f& lhsMax, const osg::Vec3f& rhsMin,
+            const osg::Vec3f& rhsMax)
+        {
+            return lhsMin.x() <= rhsMax.x() && rhsMin.x() <= lhsMax.x() && lhsMin.y() <= rhsMax.y()
+                && rhsMin.y() <= lhsMax.y() && lhsMin.z() <= rhsMax.z() && rhsMin.z() <= lhsMax.z();
+        }
+
+        // Same as btCollisionWorld filtering
+        bool canCollide(const RayCastCacheKey& key, int group, int mask)
+        {
+            return (key.mMask & group) != 0 && (key.mGroup & mask) != 0;
+        }
+
+        // Also false for NaN and infinity
+        bool isSupported(const osg::Vec3f& value)
+        {
+            constexpr float maxCoordinate = 1e9f;
+            return std::abs(value.x()) < maxCoordinate && std::abs(value.y()) < maxCoordinate
+                && std::abs(value.z()) < maxCoordinate;
+        }
+    }
+
+    std::size_t RayCastCache::KeyHash::operator()(const RayCastCacheKey& key) const noexcept
+    {
+        std::size_t result = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            Misc::hashCombine(result, key.mFrom[i]);
+            Misc::hashCombine(result, key.mTo[i]);
+        }
+        Misc::hashCombine(result, key.mMask);
+        Misc::hashCombine(result, key.mGroup);
+        return result;
+    }
+
+    std::size_t RayCastCache::CellHash::operator()(const osg::Vec2i& cell) const noexcept
+    {
+        return Misc::hash2dCoord(cell.x(), cell.y());
+    }
+
+    RayCastCache::RayCastCache(std::size_t maxSize)
+        : mMaxSize(maxSize)
+    {
+    }
+
+    std::optional<RayCastCacheValue> RayCastCache::get(const RayCastCacheKey& key)
+    {
+        const std::lock_guard lock(mMutex);
+        ++mGetCount;
+        const auto it = mEntries.find(key);
+        if (it == mEntries.end())
+            return std::nullopt;
+        ++mHitCount;
+        return it->second.mValue;
+    }
+
+    void RayCastCache::set(const RayCastCacheKey& key, const RayCastCacheValue& value)
+    {
+        if (mMaxSize == 0 || !isSupported(key.mFrom) || !isSupported(key.mTo))
+            return;
+
+        Entry entry{
+            .mValue = value,
+            .mMin = osg::Vec3f(std::min(key.mFrom.x(), key.mTo.x()), std::min(key.mFrom.y(), key.mTo.y()),
+                std::min(key.mFrom.z(), key.mTo.z())),
+            .mMax = osg::Vec3f(std::max(key.mFrom.x(), key.mTo.x()), std::max(key.mFrom.y(), key.mTo.y()),
+                std::max(key.mFrom.z(), key.mTo.z())),
+        };
+
+        const int minX = getCell(entry.mMin.x());
+        const int minY = getCell(entry.mMin.y());
+        const int maxX = getCell(entry.mMax.x());
+        const int maxY = getCell(entry.mMax.y());
+        const std::size_t cells
+            = static_cast<std::size_t>(maxX - minX + 1) * static_cast<std::size_t>(maxY - minY + 1);
+        if (cells > sMaxRayCells)
+            return;
+
+        const std::lock_guard lock(mMutex);
+
+        // Cells may refer to already dropped entries, start from scratch when there are too many references
+        if (mEntries.size() >= mMaxSize || mCellsSize + cells > 4 * mMaxSize)
+            clearUnsafe();
+
+        if (!mEntries.insert_or_assign(key, entry).second)
+            return;
+
+        for (int x = minX; x <= maxX; ++x)
+            for (int y = minY; y <= maxY; ++y)
+                mCells[osg::Vec2i(x, y)].push_back(key);
+
+        mCellsSize += cells;
+    }
+
+    void RayCastCache::invalidate(const osg::Vec3f& aabbMin, const osg::Vec3f& aabbMax, int group, int mask)
+    {
+        const std::lock_guard lock(mMutex);
+
+        if (mEntries.empty())
+            return;
+
+        // Visiting each cell of a huge object like water plane costs more than scanning all entries
+        if (!isSupported(aabbMin) || !isSupported(aabbMax)
+            || static_cast<std::size_t>(getCell(aabbMax.x()) - getCell(aabbMin.x()) + 1)
+                    * static_cast<std::size_t>(getCell(aabbMax.y()) - getCell(aabbMin.y()) + 1)
+                > mCells.size())
+        {
+            std::erase_if(mEntries, [&](const auto& v) {
+                return canCollide(v.first, group, mask)
+                    && intersects(v.second.mMin, v.second.mMax, aabbMin, aabbMax);
+            });
+            return;
+        }
+
+        const int minX = getCell(aabbMin.x());
+        const int minY = getCell(aabbMin.y());
+        const int maxX = getCell(aabbMax.x());
+        const int maxY = getCell(aabbMax.y());
+
+        for (int x = minX; x <= maxX; ++x)
+        {
+            for (int y = minY; y <= maxY; ++y)
+            {
+                const auto cell = mCells.find(osg::Vec2i(x, y));
+                if (cell == mCells.end())
+                    continue;
+                mCellsSize -= std::erase_if(cell->second, [&](const RayCastCacheKey& key) {
+                    const auto it = mEntries.find(key);
+                    if (it == mEntries.end())
+                        return true;
+                    if (!canCollide(key, group, mask)
+                        || !intersects(it->second.mMin, it->second.mMax, aabbMin, aabbMax))
+                        return false;
+                    mEntries.erase(it);
+                    return true;
+                });
+            }
+        }
+    }
+
+    void RayCastCache::invalidate(int group, int mask)
+    {
+        const std::lock_guard lock(mMutex);
+        std::erase_if(mEntries, [&](const auto& v) { return canCollide(v.first, group, mask); });
+    }
+
+    void RayCastCache::clear()
+    {
+        const std::lock_guard lock(mMutex);
+        clearUnsafe();
+    }
+
+    RayCastCacheStats RayCastCache::getStats() const
+    {
+        const std::lock_guard lock(mMutex);
+        return RayCastCacheStats{
+            .mSize = mEntries.size(),
+            .mGetCount = mGetCount,
+            .mHitCount = mHitCount,
+        };
+    }
+
+    void RayCastCache::clearUnsafe()
+    {
+        mEntries.clear();
+        mCells.clear();
+        mCellsSize = 0;
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef OPENMW_MWPHYSICS_RAYCASTCACHE_H
+#define OPENMW_MWPHYSICS_RAYCASTCACHE_H
+
+#include <osg/Vec2i>
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+class btCollisionObject;
+
+namespace MWPhysics
+{
+    struct RayCastCacheKey
+    {
+        osg::Vec3f mFrom;
+        osg::Vec3f mTo;
+        int mMask;
+        int mGroup;
+
+        friend bool operator==(const RayCastCacheKey& lhs, const RayCastCacheKey& rhs) = default;
+    };
+
+    struct RayCastCacheValue
+    {
+        bool mHit = false;
+        osg::Vec3f mHitPos;
+        osg::Vec3f mHitNormal;
+        const btCollisionObject* mHitObject = nullptr;
+    };
+
+    struct RayCastCacheStats
+    {
+        std::size_t mSize = 0;
+        std::size_t mGetCount = 0;
+        std::size_t mHitCount = 0;
+    };
+
+    /// @brief Results of ray tests kept between frames until a collision object changes on the way of the ray.
+    /// @par Rays are indexed by a 2d grid over their bounds so a change drops only the results it can affect.
+    class RayCastCache
+    {
+    public:
+        static constexpr float sCellSize = 512;
+
+        /// Rays covering more cells are not cached.
+        static constexpr std::size_t sMaxRayCells = 64;
+
+        explicit RayCastCache(std::size_t maxSize);
+
+        std::optional<RayCastCacheValue> get(const RayCastCacheKey& key);
+
+        void set(const RayCastCacheKey& key, const RayCastCacheValue& value);
+
+        /// Drop results of the rays with bounds intersecting given bounds which may hit an object with given
+        /// collision filter group and mask.
+        void invalidate(const osg::Vec3f& aabbMin, const osg::Vec3f& aabbMax, int group, int mask);
+
+        /// Drop results of the rays which may hit an object with given collision filter group and mask.
+        void invalidate(int group, int mask);
+
+        void clear();
+
+        RayCastCacheStats getStats() const;
+
+    private:
+        struct KeyHash
+        {
+            std::size_t operator()(const RayCastCacheKey& key) const noexcept;
+        };
+
+        struct CellHash
+        {
+            std::size_t operator()(const osg::Vec2i& cell) const noexcept;
+        };
+
+        struct Entry
+        {
+            RayCastCacheValue mValue;
+            osg::Vec3f mMin;
+            osg::Vec3f mMax;
+        };
+
+        mutable std::mutex mMutex;
+        std::size_t mMaxSize;
+        std::size_t mCellsSize = 0;
+        std::size_t mGetCount = 0;
+        std::size_t mHitCount = 0;
+        std::unordered_map<RayCastCacheKey, Entry, KeyHash> mEntries;
+        std::unordered_map<osg::Vec2i, std::vector<RayCastCacheKey>, CellHash> mCells;
+
+        void clearUnsafe();
+    };
+}
+
+#endif
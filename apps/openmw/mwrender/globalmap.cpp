@@ -653,6 +653,6 @@ namespace MWRender
             return;
         // Use deep copy to avoid any sychronization
         mWritePng = new WritePng(new osg::Image(*mOverlayImage, osg::CopyOp::DEEP_COPY_ALL));
-        mWorkQueue->addWorkItem(mWritePng, /*front=*/true);
+        mWorkQueue->addWorkItem(mWritePng, SceneUtil::WorkPriority::High);
     }
 }
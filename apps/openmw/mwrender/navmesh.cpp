@@ -246,7 +246,8 @@ namespace MWRender
                     std::swap(latestCandidate, *it);
                 }
                 if (*it != nullptr)
-                    mWorkQueue->addWorkItem(new DeallocateCreateNavMeshTileGroups(std::move(*it)));
+                    mWorkQueue->addWorkItem(
+                        new DeallocateCreateNavMeshTileGroups(std::move(*it)), SceneUtil::WorkPriority::Low);
                 it = mWorkItems.erase(it);
             }
 
@@ -276,7 +277,8 @@ namespace MWRender
                     }
                 }
 
-                mWorkQueue->addWorkItem(new DeallocateCreateNavMeshTileGroups(std::move(latestCandidate)));
+                mWorkQueue->addWorkItem(new DeallocateCreateNavMeshTileGroups(std::move(latestCandidate)),
+                    SceneUtil::WorkPriority::Low);
             }
         }
 
@@ -313,7 +315,7 @@ namespace MWRender
 
         osg::ref_ptr<CreateNavMeshTileGroups> workItem = new CreateNavMeshTileGroups(
             id, version, navMesh, mGroupStateSet, mDebugDrawStateSet, settings, mTiles, mMode);
-        mWorkQueue->addWorkItem(workItem);
+        mWorkQueue->addWorkItem(workItem, SceneUtil::WorkPriority::Low);
         mWorkItems.push_back(std::move(workItem));
     }
 
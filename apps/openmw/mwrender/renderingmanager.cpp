@@ -33,12 +33,16 @@
 
 #include <components/settings/values.hpp>
 
+#include <components/sceneutil/animationlod.hpp>
 #include <components/sceneutil/cullsafeboundsvisitor.hpp>
 #include <components/sceneutil/depth.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
+#include <components/sceneutil/riggeometry.hpp>
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
+#include <components/sceneutil/skeleton.hpp>
+#include <components/sceneutil/skinningcache.hpp>
 #include <components/sceneutil/statesetupdater.hpp>
 #include <components/sceneutil/visitor.hpp>
 #include <components/sceneutil/workqueue.hpp>
@@ -330,6 +334,20 @@ namespace MWRender
 
         resourceSystem->getSceneManager()->setParticleSystemMask(MWRender::Mask_ParticleSystem);
 
+        if (const int skinningNumThreads = Settings::models().mSkinningNumThreads; skinningNumThreads > 0)
+            SceneUtil::RigGeometry::setWorkQueue(new SceneUtil::WorkQueue(skinningNumThreads));
+        if (Settings::models().mShareSkinningResults)
+        {
+            mSkinningCache = new SceneUtil::SkinningCache;
+            SceneUtil::RigGeometry::setSkinningCache(mSkinningCache);
+        }
+        if (const float animationLodPixelSize = Settings::models().mAnimationLodPixelSize; animationLodPixelSize > 0)
+        {
+            mAnimationLod = new SceneUtil::AnimationLod(
+                animationLodPixelSize, static_cast<unsigned int>(Settings::models().mAnimationLodMaxUpdateInterval));
+            SceneUtil::Skeleton::setAnimationLod(mAnimationLod);
+        }
+
         // Figure out which pipeline must be used by default and inform the user
         bool forceShaders = Settings::shaders().mForceShaders;
         {
@@ -612,6 +630,9 @@ namespace MWRender
     {
         // let background loading thread finish before we delete anything else
         mWorkQueue = nullptr;
+        SceneUtil::RigGeometry::setWorkQueue(nullptr);
+        SceneUtil::RigGeometry::setSkinningCache(nullptr);
+        SceneUtil::Skeleton::setAnimationLod(nullptr);
     }
 
     osgUtil::IncrementalCompileOperation* RenderingManager::getIncrementalCompileOperation()
@@ -1501,6 +1522,10 @@ namespace MWRender
         if (stats->collectStats("resource"))
         {
             mTerrain->reportStats(frameNumber, stats);
+            if (mSkinningCache != nullptr)
+                mSkinningCache->reportStats(frameNumber, *stats);
+            if (mAnimationLod != nullptr)
+                mAnimationLod->reportStats(frameNumber, *stats);
         }
     }
 
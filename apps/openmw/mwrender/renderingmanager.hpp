@@ -63,6 +63,8 @@ namespace SceneUtil
     class WorkQueue;
     class LightManager;
     class UnrefQueue;
+    class SkinningCache;
+    class AnimationLod;
 }
 
 namespace DetourNavigator
@@ -308,6 +310,8 @@ namespace MWRender
         Resource::ResourceSystem* mResourceSystem;
 
         osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        osg::ref_ptr<SceneUtil::SkinningCache> mSkinningCache;
+        osg::ref_ptr<SceneUtil::AnimationLod> mAnimationLod;
 
         osg::ref_ptr<osg::Light> mSunLight;
 
@@ -24,16 +24,39 @@
 
 namespace MWScript
 {
-    ScriptManager::ScriptManager(const MWWorld::ESMStore& store, Compiler::Context& compilerContext, int warningsMode)
+    ScriptManager::ScriptManager(const MWWorld::ESMStore& store, Compiler::Context& compilerContext, int warningsMode,
+        const std::filesystem::path& cachePath)
         : mErrorHandler()
         , mStore(store)
         , mCompilerContext(compilerContext)
-        , mParser(mErrorHandler, mCompilerContext)
+        , mRecordingContext(compilerContext)
+        , mParser(mErrorHandler, mRecordingContext)
         , mGlobalScripts(store)
     {
         installOpcodes(mInterpreter);
 
         mErrorHandler.setWarningsMode(warningsMode);
+
+        if (!cachePath.empty())
+        {
+            mCache
+                = std::make_unique<Compiler::ScriptCache>(cachePath, *mCompilerContext.getExtensions(), warningsMode);
+            Log(Debug::Verbose) << "Loaded " << mCache->size() << " compiled scripts from " << cachePath;
+        }
+    }
+
+    ScriptManager::~ScriptManager()
+    {
+        if (mCache == nullptr)
+            return;
+
+        // Drop entries of scripts changed or removed from the content files since they were compiled
+        std::set<Compiler::ScriptCache::Hash> textHashes;
+        for (const ESM::Script& script : mStore.get<ESM::Script>())
+            textHashes.insert(Compiler::ScriptCache::getTextHash(script.mScriptText));
+        mCache->retain(textHashes);
+
+        mCache->write();
     }
 
     bool ScriptManager::compile(const ESM::RefId& name)
@@ -43,6 +66,21 @@ namespace MWScript
 
         if (const ESM::Script* script = mStore.get<ESM::Script>().find(name))
         {
+            Compiler::ScriptCache::Hash textHash{};
+            if (mCache != nullptr)
+            {
+                textHash = Compiler::ScriptCache::getTextHash(script->mScriptText);
+                if (const Compiler::ScriptCache::Entry* entry = mCache->find(textHash, mCompilerContext))
+                {
+                    mErrorHandler.setContext(script->mId.getRefIdString());
+                    for (const std::string& warning : entry->mWarnings)
+                        mErrorHandler.replayWarning(warning);
+                    mScripts.emplace(name, CompiledScript(Interpreter::Program(entry->mProgram), entry->mLocals));
+                    return true;
+                }
+            }
+
+            mRecordingContext.clear();
             mErrorHandler.setContext(script->mId.getRefIdString());
 
             bool Success = true;
@@ -75,6 +113,17 @@ namespace MWScript
 
             if (Success)
             {
+                if (mCache != nullptr)
+                {
+                    Compiler::ScriptDependencies dependencies = mRecordingContext.getDependencies();
+                    dependencies.removeDuplicates();
+                    mCache->insert(textHash,
+                        Compiler::ScriptCache::Entry{ .mProgram = mParser.getProgram(),
+                            .mLocals = mParser.getLocals(),
+                            .mDependencies = std::move(dependencies),
+                            .mWarnings = mErrorHandler.getWarnings() });
+                }
+
                 mScripts.emplace(name, CompiledScript(mParser.getProgram(), mParser.getLocals()));
 
                 return true;
@@ -1,11 +1,14 @@
 #ifndef GAME_SCRIPT_SCRIPTMANAGER_H
 #define GAME_SCRIPT_SCRIPTMANAGER_H
 
+#include <filesystem>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 
 #include <components/compiler/fileparser.hpp>
+#include <components/compiler/scriptcache.hpp>
 #include <components/compiler/streamerrorhandler.hpp>
 
 #include <components/interpreter/interpreter.hpp>
@@ -40,7 +43,9 @@ namespace MWScript
         Compiler::StreamErrorHandler mErrorHandler;
         const MWWorld::ESMStore& mStore;
         Compiler::Context& mCompilerContext;
+        Compiler::RecordingContext mRecordingContext;
         Compiler::FileParser mParser;
+        std::unique_ptr<Compiler::ScriptCache> mCache;
         Interpreter::Interpreter mInterpreter;
 
         struct CompiledScript
@@ -61,7 +66,11 @@ namespace MWScript
         std::unordered_map<ESM::RefId, Compiler::Locals> mOtherLocals;
 
     public:
-        ScriptManager(const MWWorld::ESMStore& store, Compiler::Context& compilerContext, int warningsMode);
+        /// @param cachePath File to store compiled scripts in between runs. Empty path disables the cache.
+        ScriptManager(const MWWorld::ESMStore& store, Compiler::Context& compilerContext, int warningsMode,
+            const std::filesystem::path& cachePath = {});
+
+        ~ScriptManager() override;
 
         void clear() override;
 
@@ -92,6 +92,9 @@ namespace MWWorld
         /// Preload work to be called from the worker thread.
         void doWork() override
         {
+            const std::vector<VFS::Path::Normalized> meshes = correctMeshPaths();
+            prefetchMeshes(meshes);
+
             if (mIsExterior)
             {
                 try
@@ -106,19 +109,17 @@ namespace MWWorld
                 }
             }
 
-            VFS::Path::Normalized mesh;
+            const VFS::Manager& vfs = *mSceneManager->getVFS();
             VFS::Path::Normalized kfname;
-            for (std::string_view path : mMeshes)
+            for (std::size_t i = 0; i < meshes.size(); ++i)
             {
                 if (mAbort)
                     break;
 
+                const VFS::Path::Normalized& mesh = meshes[i];
+
                 try
                 {
-                    const VFS::Manager& vfs = *mSceneManager->getVFS();
-                    mesh = Misc::ResourceHelpers::correctMeshPath(VFS::Path::Normalized(path));
-                    mesh = Misc::ResourceHelpers::correctActorModelPath(mesh, &vfs);
-
                     if (!vfs.exists(mesh))
                         continue;
 
@@ -138,13 +139,38 @@ namespace MWWorld
                 }
                 catch (const std::exception& e)
                 {
-                    Log(Debug::Warning) << "Failed to preload mesh \"" << path << "\" from cell " << mCellId << ": "
-                                        << e.what();
+                    Log(Debug::Warning) << "Failed to preload mesh \"" << mMeshes[i] << "\" from cell " << mCellId
+                                        << ": " << e.what();
                 }
             }
         }
 
     private:
+        std::vector<VFS::Path::Normalized> correctMeshPaths() const
+        {
+            const VFS::Manager& vfs = *mSceneManager->getVFS();
+            std::vector<VFS::Path::Normalized> meshes;
+            meshes.reserve(mMeshes.size());
+            for (std::string_view path : mMeshes)
+            {
+                const VFS::Path::Normalized mesh = Misc::ResourceHelpers::correctMeshPath(VFS::Path::Normalized(path));
+                meshes.push_back(Misc::ResourceHelpers::correctActorModelPath(mesh, &vfs));
+            }
+            return meshes;
+        }
+
+        /// Let the VFS read all meshes in background while terrain is cached and meshes are loaded one by one.
+        void prefetchMeshes(const std::vector<VFS::Path::Normalized>& meshes) const
+        {
+            std::vector<VFS::Path::NormalizedView> views(meshes.begin(), meshes.end());
+
+            // Cells usually have many instances of the same model
+            std::sort(views.begin(), views.end());
+            views.erase(std::unique(views.begin(), views.end()), views.end());
+
+            mSceneManager->getVFS()->prefetch(views);
+        }
+
         bool mIsExterior;
         ESM::ExteriorCellLocation mCellLocation;
         ESM::RefId mCellId;
@@ -234,7 +260,7 @@ namespace MWWorld
         clearAllTasks();
     }
 
-    void CellPreloader::preload(CellStore& cell, double timestamp)
+    void CellPreloader::preload(CellStore& cell, double timestamp, SceneUtil::WorkPriority priority)
     {
         if (!mWorkQueue)
         {
@@ -272,7 +298,7 @@ namespace MWWorld
 
             if (oldestTimestamp + threshold < timestamp)
             {
-                oldestCell->second.mWorkItem->abort();
+                oldestCell->second.mWorkItem->cancel();
                 mPreloadCells.erase(oldestCell);
                 ++mEvicted;
             }
@@ -282,7 +308,7 @@ namespace MWWorld
 
         osg::ref_ptr<PreloadItem> item(new PreloadItem(&cell, mResourceSystem->getSceneManager(), mBulletShapeManager,
             mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
-        mWorkQueue->addWorkItem(item);
+        mWorkQueue->addWorkItem(item, priority);
 
         mPreloadCells.emplace(&cell, PreloadEntry(timestamp, item));
         ++mAdded;
@@ -295,7 +321,7 @@ namespace MWWorld
         {
             if (found->second.mWorkItem)
             {
-                found->second.mWorkItem->abort();
+                found->second.mWorkItem->cancel();
                 found->second.mWorkItem = nullptr;
             }
 
@@ -310,7 +336,7 @@ namespace MWWorld
         {
             if (it->second.mWorkItem)
             {
-                it->second.mWorkItem->abort();
+                it->second.mWorkItem->cancel();
                 it->second.mWorkItem = nullptr;
             }
 
@@ -326,7 +352,7 @@ namespace MWWorld
             {
                 if (it->second.mWorkItem)
                 {
-                    it->second.mWorkItem->abort();
+                    it->second.mWorkItem->cancel();
                     it->second.mWorkItem = nullptr;
                 }
                 mPreloadCells.erase(it++);
@@ -341,7 +367,7 @@ namespace MWWorld
             // the resource cache is cleared from the worker thread so that we're not holding up the main thread with
             // delete operations
             mUpdateCacheItem = new UpdateCacheItem(mResourceSystem, timestamp);
-            mWorkQueue->addWorkItem(mUpdateCacheItem, true);
+            mWorkQueue->addWorkItem(mUpdateCacheItem, SceneUtil::WorkPriority::High);
             mLastResourceCacheUpdate = timestamp;
         }
 
@@ -410,7 +436,7 @@ namespace MWWorld
             if (!positions.empty())
             {
                 mTerrainPreloadItem = new TerrainPreloadItem(mTerrainViews, mTerrain, positions);
-                mWorkQueue->addWorkItem(mTerrainPreloadItem);
+                mWorkQueue->addWorkItem(mTerrainPreloadItem, SceneUtil::WorkPriority::Low);
             }
         }
     }
@@ -446,7 +472,7 @@ namespace MWWorld
         }
 
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end(); ++it)
-            it->second.mWorkItem->abort();
+            it->second.mWorkItem->cancel();
 
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end(); ++it)
             it->second.mWorkItem->waitTillDone();
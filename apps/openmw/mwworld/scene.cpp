@@ -1198,7 +1198,8 @@ namespace MWWorld
             {
                 try
                 {
-                    preloadCellWithSurroundings(mWorld.getWorldModel().getCell(door.getCellRef().getDestCell()));
+                    preloadCellWithSurroundings(
+                        mWorld.getWorldModel().getCell(door.getCellRef().getDestCell()), SceneUtil::WorkPriority::High);
                 }
                 catch (const std::exception& e)
                 {
@@ -1241,16 +1242,16 @@ namespace MWWorld
                 float loadDist = cellSize / 2 + cellSize - mCellLoadingThreshold + mPreloadDistance;
 
                 if (dist < loadDist)
-                    preloadCell(mWorld.getWorldModel().getExterior(cellIndex));
+                    preloadCell(mWorld.getWorldModel().getExterior(cellIndex), SceneUtil::WorkPriority::High);
             }
         }
     }
 
-    void Scene::preloadCellWithSurroundings(CellStore& cell)
+    void Scene::preloadCellWithSurroundings(CellStore& cell, SceneUtil::WorkPriority priority)
     {
         if (!cell.isExterior())
         {
-            mPreloader->preload(cell, mRendering.getReferenceTime());
+            mPreloader->preload(cell, mRendering.getReferenceTime(), priority);
             return;
         }
 
@@ -1281,12 +1282,12 @@ namespace MWWorld
         const ESM::RefId worldspace = cell.getCell()->getWorldSpace();
         for (const auto& [x, y] : cells)
             mPreloader->preload(mWorld.getWorldModel().getExterior(ESM::ExteriorCellLocation(x, y, worldspace)),
-                mRendering.getReferenceTime());
+                mRendering.getReferenceTime(), priority);
     }
 
-    void Scene::preloadCell(CellStore& cell)
+    void Scene::preloadCell(CellStore& cell, SceneUtil::WorkPriority priority)
     {
-        mPreloader->preload(cell, mRendering.getReferenceTime());
+        mPreloader->preload(cell, mRendering.getReferenceTime(), priority);
     }
 
     void Scene::preloadTerrain(const osg::Vec3f& pos, ESM::RefId worldspace, bool sync)
@@ -1355,13 +1356,14 @@ namespace MWWorld
         for (ESM::Transport::Dest& dest : listVisitor.mList)
         {
             if (!dest.mCellName.empty())
-                preloadCell(mWorld.getWorldModel().getInterior(dest.mCellName));
+                preloadCell(mWorld.getWorldModel().getInterior(dest.mCellName), SceneUtil::WorkPriority::Normal);
             else
             {
                 osg::Vec3f pos = dest.mPos.asVec3();
                 const ESM::ExteriorCellLocation cellIndex
                     = ESM::positionToExteriorCellLocation(pos.x(), pos.y(), extWorldspace);
-                preloadCellWithSurroundings(mWorld.getWorldModel().getExterior(cellIndex));
+                preloadCellWithSurroundings(
+                    mWorld.getWorldModel().getExterior(cellIndex), SceneUtil::WorkPriority::Normal);
                 exteriorPositions.push_back(PositionCellGrid{ pos, gridCenterToBounds(getNewGridCenter(pos)) });
             }
         }
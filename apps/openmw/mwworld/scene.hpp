@@ -15,6 +15,7 @@
 
 #include <components/esm/exteriorcelllocation.hpp>
 #include <components/misc/constants.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 namespace osg
 {
@@ -143,8 +144,8 @@ namespace MWWorld
 
         ~Scene();
 
-        void preloadCellWithSurroundings(MWWorld::CellStore& cell);
-        void preloadCell(MWWorld::CellStore& cell);
+        void preloadCellWithSurroundings(MWWorld::CellStore& cell, SceneUtil::WorkPriority priority);
+        void preloadCell(MWWorld::CellStore& cell, SceneUtil::WorkPriority priority);
         void preloadTerrain(const osg::Vec3f& pos, ESM::RefId worldspace, bool sync = false);
         void reloadTerrain();
 
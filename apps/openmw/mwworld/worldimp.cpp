@@ -522,7 +522,8 @@ namespace MWWorld
                     if (getPlayerPtr().getCell()->isExterior())
                         mWorldScene->preloadTerrain(getPlayerPtr().getRefData().getPosition().asVec3(),
                             getPlayerPtr().getCell()->getCell()->getWorldSpace());
-                    mWorldScene->preloadCellWithSurroundings(*getPlayerPtr().getCell());
+                    mWorldScene->preloadCellWithSurroundings(
+                        *getPlayerPtr().getCell(), SceneUtil::WorkPriority::High);
                 }
                 break;
             case ESM::REC_CSTA:
@@ -1713,6 +1714,10 @@ namespace MWWorld
             stats.setAttribute(frameNumber, "physicsworker_time_begin", 0);
             stats.setAttribute(frameNumber, "physicsworker_time_taken", 0);
             stats.setAttribute(frameNumber, "physicsworker_time_end", 0);
+            stats.setAttribute(frameNumber, "physicsworker_prestep_time", 0);
+            stats.setAttribute(frameNumber, "physicsworker_poststep_time", 0);
+            stats.setAttribute(frameNumber, "physicsworker_postsim_time", 0);
+            stats.setAttribute(frameNumber, "physicsworker_wait_time", 0);
         }
     }
 
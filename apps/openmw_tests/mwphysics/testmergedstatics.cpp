@@ -0,0 +1,244 @@
+#include "apps/openmw/mwclass/static.hpp"
+#include "apps/openmw/mwphysics/collisiontype.hpp"
+#include "apps/openmw/mwphysics/mergedstatics.hpp"
+#include "apps/openmw/mwphysics/mtphysics.hpp"
+#include "apps/openmw/mwphysics/object.hpp"
+#include "apps/openmw/mwworld/livecellref.hpp"
+#include "apps/openmw/mwworld/ptr.hpp"
+
+#include <components/bullethelpers/collisionobject.hpp>
+#include <components/esm3/cellref.hpp>
+#include <components/esm3/loadstat.hpp>
+#include <components/resource/bulletshape.hpp>
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+
+namespace MWPhysics
+{
+    namespace
+    {
+        using namespace testing;
+
+        constexpr int collisionType = CollisionType_World;
+        constexpr int collisionMask = CollisionType_Actor | CollisionType_HeightMap | CollisionType_Projectile;
+
+        bool isInWorld(const btCollisionWorld& collisionWorld, const btCollisionObject& collisionObject)
+        {
+            const btCollisionObjectArray& objects = collisionWorld.getCollisionObjectArray();
+            return objects.findLinearSearch(const_cast<btCollisionObject*>(&collisionObject)) < objects.size();
+        }
+
+        const btCompoundShape& getShape(const MergedStatics& mergedStatics)
+        {
+            return static_cast<const btCompoundShape&>(*mergedStatics.getCollisionObject().getCollisionShape());
+        }
+
+        struct MWPhysicsMergedStaticsTest : Test
+        {
+            btDefaultCollisionConfiguration mCollisionConfiguration;
+            btCollisionDispatcher mDispatcher{ &mCollisionConfiguration };
+            btDbvtBroadphase mBroadphase;
+            btCollisionWorld mCollisionWorld{ &mDispatcher, &mBroadphase, &mCollisionConfiguration };
+            PhysicsTaskScheduler mScheduler{ 1.0f / 60.0f, &mCollisionWorld, nullptr };
+            btBoxShape mBox{ btVector3(1, 1, 1) };
+            btBoxShape mOtherBox{ btVector3(2, 2, 2) };
+            std::array<std::unique_ptr<btCollisionObject>, 3> mObjects{
+                BulletHelpers::makeCollisionObject(&mBox, btVector3(0, 0, 0), btQuaternion::getIdentity()),
+                BulletHelpers::makeCollisionObject(&mOtherBox, btVector3(10, 0, 0), btQuaternion::getIdentity()),
+                BulletHelpers::makeCollisionObject(&mBox, btVector3(0, 20, 0), btQuaternion(btVector3(0, 0, 1), 1)),
+            };
+            MergedStatics mMergedStatics{ collisionType, collisionMask, &mScheduler };
+
+            void expectChild(int index, const btCollisionObject& object) const
+            {
+                const btCompoundShape& shape = getShape(mMergedStatics);
+                ASSERT_LT(index, shape.getNumChildShapes());
+                EXPECT_EQ(shape.getChildShape(index), object.getCollisionShape());
+                EXPECT_EQ(shape.getChildTransform(index), object.getWorldTransform());
+            }
+        };
+
+        TEST_F(MWPhysicsMergedStaticsTest, shouldNotBeInWorldWhenEmpty)
+        {
+            EXPECT_TRUE(mMergedStatics.empty());
+            EXPECT_FALSE(isInWorld(mCollisionWorld, mMergedStatics.getCollisionObject()));
+        }
+
+        TEST_F(MWPhysicsMergedStaticsTest, addShouldPutCompoundIntoWorld)
+        {
+            mMergedStatics.add(*mObjects[0]);
+            EXPECT_EQ(mMergedStatics.size(), 1);
+            EXPECT_TRUE(isInWorld(mCollisionWorld, mMergedStatics.getCollisionObject()));
+            EXPECT_EQ(mCollisionWorld.getNumCollisionObjects(), 1);
+            expectChild(0, *mObjects[0]);
+        }
+
+        TEST_F(MWPhysicsMergedStaticsTest, addSeveralShouldKeepChildrenInOrder)
+        {
+            for (const auto& object : mObjects)
+                mMergedStatics.add(*object);
+            EXPECT_EQ(mMergedStatics.size(), mObjects.size());
+            EXPECT_EQ(getShape(mMergedStatics).getNumChildShapes(), static_cast<int>(mObjects.size()));
+            EXPECT_EQ(mCollisionWorld.getNumCollisionObjects(), 1);
+            for (std::size_t i = 0; i < mObjects.size(); ++i)
+                expectChild(static_cast<int>(i), *mObjects[i]);
+        }
+
+        TEST_F(MWPhysicsMergedStaticsTest, removeMiddleShouldMoveLastChildInItsPlace)
+        {
+            for (const auto& object : mObjects)
+                mMergedStatics.add(*object);
+            mMergedStatics.remove(*mObjects[1]);
+            EXPECT_EQ(mMergedStatics.size(), 2);
+            EXPECT_EQ(getShape(mMergedStatics).getNumChildShapes(), 2);
+            EXPECT_TRUE(isInWorld(mCollisionWorld, mMergedStatics.getCollisionObject()));
+            expectChild(0, *mObjects[0]);
+            expectChild(1, *mObjects[2]);
+        }
+
+        TEST_F(MWPhysicsMergedStaticsTest, removeAfterMovingChildShouldRemoveMovedChild)
+        {
+            for (const auto& object : mObjects)
+                mMergedStatics.add(*object);
+            mMergedStatics.remove(*mObjects[0]);
+            mMergedStatics.remove(*mObjects[2]);
+            EXPECT_EQ(mMergedStatics.size(), 1);
+            EXPECT_EQ(getShape(mMergedStatics).getNumChildShapes(), 1);
+            expectChild(0, *mObjects[1]);
+        }
+
+        TEST_F(MWPhysicsMergedStaticsTest, removeLastChildShouldTakeCompoundOutOfWorld)
+        {
+            mMergedStatics.add(*mObjects[0]);
+            mMergedStatics.remove(*mObjects[0]);
+            EXPECT_TRUE(mMergedStatics.empty());
+            EXPECT_EQ(getShape(mMergedStatics).getNumChildShapes(), 0);
+            EXPECT_FALSE(isInWorld(mCollisionWorld, mMergedStatics.getCollisionObject()));
+            EXPECT_EQ(mCollisionWorld.getNumCollisionObjects(), 0);
+        }
+
+        TEST_F(MWPhysicsMergedStaticsTest, removeNotAddedShouldHaveNoEffect)
+        {
+            mMergedStatics.add(*mObjects[0]);
+            mMergedStatics.remove(*mObjects[1]);
+            EXPECT_EQ(mMergedStatics.size(), 1);
+            expectChild(0, *mObjects[0]);
+        }
+
+        TEST_F(MWPhysicsMergedStaticsTest, addAfterRemovingAllShouldPutCompoundBackIntoWorld)
+        {
+            mMergedStatics.add(*mObjects[0]);
+            mMergedStatics.remove(*mObjects[0]);
+            mMergedStatics.add(*mObjects[1]);
+            EXPECT_EQ(mMergedStatics.size(), 1);
+            EXPECT_TRUE(isInWorld(mCollisionWorld, mMergedStatics.getCollisionObject()));
+            expectChild(0, *mObjects[1]);
+
+            btVector3 aabbMin;
+            btVector3 aabbMax;
+            getShape(mMergedStatics).getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
+            EXPECT_GE(aabbMin.x(), 7);
+        }
+
+        TEST_F(MWPhysicsMergedStaticsTest, readdShouldAppendChild)
+        {
+            for (const auto& object : mObjects)
+                mMergedStatics.add(*object);
+            mMergedStatics.remove(*mObjects[0]);
+            mMergedStatics.add(*mObjects[0]);
+            EXPECT_EQ(mMergedStatics.size(), 3);
+            expectChild(0, *mObjects[2]);
+            expectChild(1, *mObjects[1]);
+            expectChild(2, *mObjects[0]);
+        }
+
+        TEST_F(MWPhysicsMergedStaticsTest, destructorShouldTakeNonEmptyCompoundOutOfWorld)
+        {
+            {
+                MergedStatics mergedStatics(collisionType, collisionMask, &mScheduler);
+                mergedStatics.add(*mObjects[0]);
+                EXPECT_EQ(mCollisionWorld.getNumCollisionObjects(), 1);
+            }
+            EXPECT_EQ(mCollisionWorld.getNumCollisionObjects(), 0);
+        }
+
+        struct MWPhysicsObjectUnmergeTest : MWPhysicsMergedStaticsTest
+        {
+            ESM::Static mStatic;
+            std::unique_ptr<MWWorld::LiveCellRef<ESM::Static>> mLiveCellRef;
+            osg::ref_ptr<Resource::BulletShape> mShape{ new Resource::BulletShape };
+
+            MWPhysicsObjectUnmergeTest()
+            {
+                MWClass::Static::registerSelf();
+                mStatic.blank();
+                mStatic.mId = ESM::RefId::stringRefId("static");
+                ESM::CellRef cellRef;
+                cellRef.blank();
+                cellRef.mRefID = mStatic.mId;
+                cellRef.mPos.pos[0] = 42;
+                mLiveCellRef = std::make_unique<MWWorld::LiveCellRef<ESM::Static>>(cellRef, &mStatic);
+                mShape->mCollisionShape.reset(new btBoxShape(btVector3(1, 1, 1)));
+            }
+
+            std::unique_ptr<Object> makeObject(MergedStatics* mergedStatics)
+            {
+                return std::make_unique<Object>(MWWorld::Ptr(mLiveCellRef.get()), Resource::makeInstance(mShape),
+                    osg::Quat(), collisionType, &mScheduler, mergedStatics);
+            }
+        };
+
+        TEST_F(MWPhysicsObjectUnmergeTest, mergedObjectShouldNotHaveOwnCollisionObjectInWorld)
+        {
+            const std::unique_ptr<Object> object = makeObject(&mMergedStatics);
+            EXPECT_EQ(object->getMergedStatics(), &mMergedStatics);
+            EXPECT_FALSE(isInWorld(mCollisionWorld, *object->getCollisionObject()));
+            EXPECT_TRUE(isInWorld(mCollisionWorld, mMergedStatics.getCollisionObject()));
+            expectChild(0, *object->getCollisionObject());
+        }
+
+        TEST_F(MWPhysicsObjectUnmergeTest, unmergeShouldMoveCollisionObjectIntoWorld)
+        {
+            mMergedStatics.add(*mObjects[0]);
+            const std::unique_ptr<Object> object = makeObject(&mMergedStatics);
+            object->unmerge();
+            EXPECT_EQ(object->getMergedStatics(), nullptr);
+            EXPECT_TRUE(isInWorld(mCollisionWorld, *object->getCollisionObject()));
+            EXPECT_EQ(mMergedStatics.size(), 1);
+            expectChild(0, *mObjects[0]);
+        }
+
+        TEST_F(MWPhysicsObjectUnmergeTest, unmergeLastObjectShouldTakeCompoundOutOfWorld)
+        {
+            const std::unique_ptr<Object> object = makeObject(&mMergedStatics);
+            object->unmerge();
+            EXPECT_TRUE(mMergedStatics.empty());
+            EXPECT_FALSE(isInWorld(mCollisionWorld, mMergedStatics.getCollisionObject()));
+            EXPECT_EQ(mCollisionWorld.getNumCollisionObjects(), 1);
+        }
+
+        TEST_F(MWPhysicsObjectUnmergeTest, destructorShouldRemoveUnmergedObjectFromWorld)
+        {
+            makeObject(&mMergedStatics)->unmerge();
+            EXPECT_EQ(mCollisionWorld.getNumCollisionObjects(), 0);
+        }
+
+        TEST_F(MWPhysicsObjectUnmergeTest, destructorShouldRemoveMergedObjectFromCompound)
+        {
+            mMergedStatics.add(*mObjects[0]);
+            makeObject(&mMergedStatics);
+            EXPECT_EQ(mMergedStatics.size(), 1);
+            expectChild(0, *mObjects[0]);
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "apps/openmw/mwphysics/collisiontype.hpp"
+#include "apps/openmw/mwphysics/raycastcache.hpp"
+
+namespace MWPhysics
+{
+    namespace
+    {
+        const RayCastCacheKey key{
+            .mFrom = osg::Vec3f(0, 0, 0),
+            .mTo = osg::Vec3f(1000, 100, 0),
+            .mMask = CollisionType_World | CollisionType_HeightMap,
+            .mGroup = CollisionType_AnyPhysical,
+        };
+
+        const RayCastCacheValue value{
+            .mHit = true,
+            .mHitPos = osg::Vec3f(500, 50, 0),
+            .mHitNormal = osg::Vec3f(-1, 0, 0),
+        };
+
+        TEST(MWPhysicsRayCastCacheTest, getShouldReturnNulloptForEmptyCache)
+        {
+            RayCastCache cache(1);
+            EXPECT_EQ(cache.get(key), std::nullopt);
+            const RayCastCacheStats stats = cache.getStats();
+            EXPECT_EQ(stats.mGetCount, 1);
+            EXPECT_EQ(stats.mHitCount, 0);
+        }
+
+        TEST(MWPhysicsRayCastCacheTest, getShouldReturnSetValue)
+        {
+            RayCastCache cache(1);
+            cache.set(key, value);
+            const std::optional<RayCastCacheValue> result = cache.get(key);
+            ASSERT_TRUE(result.has_value());
+            EXPECT_EQ(result->mHit, value.mHit);
+            EXPECT_EQ(result->mHitPos, value.mHitPos);
+            EXPECT_EQ(result->mHitNormal, value.mHitNormal);
+            EXPECT_EQ(cache.getStats().mHitCount, 1);
+        }
+
+        TEST(MWPhysicsRayCastCacheTest, setShouldBeNoopForZeroMaxSize)
+        {
+            RayCastCache cache(0);
+            cache.set(key, value);
+            EXPECT_EQ(cache.get(key), std::nullopt);
+        }
+
+        TEST(MWPhysicsRayCastCacheTest, setShouldIgnoreRayWithNonFiniteEndpoint)
+        {
+            RayCastCache cache(1);
+            RayCastCacheKey nonFinite = key;
+            nonFinite.mTo.x() = std::numeric_limits<float>::infinity();
+            cache.set(nonFinite, value);
+            EXPECT_EQ(cache.getStats().mSize, 0);
+        }
+
+        TEST(MWPhysicsRayCastCacheTest, setShouldIgnoreTooLongRay)
+        {
+            RayCastCache cache(1);
+            RayCastCacheKey tooLong = key;
+            tooLong.mTo = osg::Vec3f(100 * RayCastCache::sCellSize, 100 * RayCastCache::sCellSize, 0);
+            cache.set(tooLong, value);
+            EXPECT_EQ(cache.getStats().mSize, 0);
+        }
+
+        TEST(MWPhysicsRayCastCacheTest, setShouldDropAllValuesWhenFull)
+        {
+            RayCastCache cache(1);
+            cache.set(key, value);
+            RayCastCacheKey other = key;
+            other.mMask = CollisionType_World;
+            cache.set(other, value);
+            EXPECT_EQ(cache.get(key), std::nullopt);
+            EXPECT_NE(cache.get(other), std::nullopt);
+        }
+
+        TEST(MWPhysicsRayCastCacheTest, invalidateShouldDropRayIntersectingBounds)
+        {
+            RayCastCache cache(1);
+            cache.set(key, value);
+            cache.invalidate(osg::Vec3f(490, -10, -10), osg::Vec3f(510, 10, 10), CollisionType_World, ~0);
+            EXPECT_EQ(cache.get(key), std::nullopt);
+        }
+
+        TEST(MWPhysicsRayCastCacheTest, invalidateShouldKeepRayNotIntersectingBounds)
+        {
+            RayCastCache cache(1);
+            cache.set(key, value);
+            cache.invalidate(osg::Vec3f(490, 200, -10), osg::Vec3f(510, 210, 10), CollisionType_World, ~0);
+            EXPECT_NE(cache.get(key), std::nullopt);
+        }
+
+        TEST(MWPhysicsRayCastCacheTest, invalidateShouldKeepRayNotCollidingWithGroup)
+        {
+            RayCastCache cache(1);
+            cache.set(key, value);
+            cache.invalidate(osg::Vec3f(490, -10, -10), osg::Vec3f(510, 10, 10), CollisionType_Actor, ~0);
+            EXPECT_NE(cache.get(key), std::nullopt);
+        }
+
+        TEST(MWPhysicsRayCastCacheTest, invalidateShouldDropRayIntersectingHugeBounds)
+        {
+            RayCastCache cache(1);
+            cache.set(key, value);
+            const float infinity = std::numeric_limits<float>::infinity();
+            cache.invalidate(
+                osg::Vec3f(-infinity, -infinity, -10), osg::Vec3f(infinity, infinity, 10), CollisionType_World, ~0);
+            EXPECT_EQ(cache.get(key), std::nullopt);
+        }
+
+        TEST(MWPhysicsRayCastCacheTest, invalidateByGroupShouldDropOnlyRaysCollidingWithIt)
+        {
+            RayCastCache cache(2);
+            cache.set(key, value);
+            RayCastCacheKey actors = key;
+            actors.mMask = CollisionType_Actor;
+            cache.set(actors, value);
+            cache.invalidate(CollisionType_Actor, ~0);
+            EXPECT_NE(cache.get(key), std::nullopt);
+            EXPECT_EQ(cache.get(actors), std::nullopt);
+        }
+    }
+}
@@ -1,30 +1,13 @@
 #include "ba2dx10file.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 
-#include <lz4frame.h>
-
-#if defined(_MSC_VER)
-// why is this necessary? These are included with /external:I
-#pragma warning(push)
-#pragma warning(disable : 4706)
-#pragma warning(disable : 4702)
-#include <boost/iostreams/copy.hpp>
-#include <boost/iostreams/filter/zlib.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
-#include <boost/iostreams/filtering_streambuf.hpp>
-#pragma warning(pop)
-#else
-#include <boost/iostreams/copy.hpp>
-#include <boost/iostreams/filter/zlib.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
-#include <boost/iostreams/filtering_streambuf.hpp>
-#endif
-
-#include <boost/iostreams/device/array.hpp>
 #include <components/bsa/ba2file.hpp>
+#include <components/bsa/decompress.hpp>
 #include <components/bsa/memorystream.hpp>
 #include <components/esm/fourcc.hpp>
 #include <components/files/constrainedfilestream.hpp>
@@ -245,6 +228,13 @@ namespace Bsa
         fail("File not found: " + std::string(file->name()));
     }
 
+    void BA2DX10File::prefetchFile(const FileStruct* file) const
+    {
+        if (const auto fileRec = getFileRecord(file->name()))
+            for (const TextureChunkRecord& chunk : fileRec->texturesChunks)
+                prefetchRegion(chunk.offset, chunk.packedSize != 0 ? chunk.packedSize : chunk.size);
+    }
+
     void BA2DX10File::addFile(const std::string& filename, std::istream& file)
     {
         assert(false); // not implemented yet
@@ -412,6 +402,14 @@ namespace Bsa
 
     Files::IStreamPtr BA2DX10File::getFile(const FileRecord& fileRecord)
     {
+        if (fileRecord.texturesChunks.empty())
+            fail("Texture has no chunks");
+
+        // Textures are identified in the cache by the first chunk offset which is unique for each texture
+        const std::uint64_t cacheKey = static_cast<std::uint64_t>(fileRecord.texturesChunks.front().offset);
+        if (Files::IStreamPtr cached = findDecompressedFile(cacheKey))
+            return cached;
+
         DDSHeaderDX10 header;
         header.size = sizeof(DDSHeader);
         header.width = fileRecord.width;
@@ -645,41 +643,51 @@ namespace Bsa
         for (const auto& textureChunk : fileRecord.texturesChunks)
             textureSize += textureChunk.size;
 
-        auto memoryStreamPtr = std::make_unique<MemoryInputStream>(textureSize);
-        char* buff = memoryStreamPtr->getRawData();
+        std::vector<char> texture(textureSize);
+        char* buff = texture.data();
 
         uint32_t dds = ESM::fourCC("DDS ");
         buff = (char*)std::memcpy(buff, &dds, sizeof(uint32_t)) + sizeof(uint32_t);
         std::memcpy(buff, &header, headerSize);
 
-        size_t offset = sizeof(uint32_t) + headerSize;
         // append chunks
-        for (const auto& c : fileRecord.texturesChunks)
+        // Callers already load many files in parallel, so chunks are read serially to not oversubscribe the cores
+        char* output = texture.data() + sizeof(uint32_t) + headerSize;
+        for (const auto& chunk : fileRecord.texturesChunks)
         {
-            if (c.packedSize != 0)
-            {
-                Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, c.offset, c.packedSize);
-                std::istream* fileStream = streamPtr.get();
+            readChunk(chunk, output);
+            output += chunk.size;
+        }
 
-                boost::iostreams::filtering_streambuf<boost::iostreams::input> inputStreamBuf;
-                inputStreamBuf.push(boost::iostreams::zlib_decompressor());
-                inputStreamBuf.push(*fileStream);
+        return addDecompressedFile(cacheKey, std::move(texture));
+    }
 
-                boost::iostreams::basic_array_sink<char> sr(memoryStreamPtr->getRawData() + offset, c.size);
-                boost::iostreams::copy(inputStreamBuf, sr);
+    void BA2DX10File::readChunk(const TextureChunkRecord& chunk, char* output) const
+    {
+        if (chunk.packedSize != 0)
+        {
+            std::vector<char> buffer;
+            const std::span<const char> input = readRegion(chunk.offset, chunk.packedSize, buffer);
+            try
+            {
+                decompressZlib(input, std::span<char>(output, chunk.size));
             }
-            // uncompressed chunk
-            else
+            catch (const std::exception& e)
             {
-                Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, c.offset, c.size);
-                std::istream* fileStream = streamPtr.get();
-
-                fileStream->read(memoryStreamPtr->getRawData() + offset, c.size);
+                fail(e.what());
             }
-            offset += c.size;
         }
-
-        return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
+        // uncompressed chunk
+        else if (isMemoryMapped())
+        {
+            const std::span<const char> input = getMappedRegion(chunk.offset, chunk.size);
+            std::memcpy(output, input.data(), input.size());
+        }
+        else
+        {
+            Files::IStreamPtr streamPtr = openRegion(chunk.offset, chunk.size);
+            streamPtr->read(output, chunk.size);
+        }
     }
 
 } // namespace Bsa
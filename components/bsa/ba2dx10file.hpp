@@ -45,12 +45,17 @@ namespace Bsa
 
         Files::IStreamPtr getFile(const FileRecord& fileRecord);
 
+        void readChunk(const TextureChunkRecord& chunk, char* output) const;
+
         void loadFiles(uint32_t fileCount, std::istream& in);
 
     public:
         using BSAFile::getFilename;
         using BSAFile::getList;
+        using BSAFile::isMemoryMapped;
+        using BSAFile::mapIntoMemory;
         using BSAFile::open;
+        using BSAFile::setDecompressedFileCache;
 
         BA2DX10File();
         virtual ~BA2DX10File();
@@ -60,6 +65,7 @@ namespace Bsa
 
         Files::IStreamPtr getFile(const char* filePath);
         Files::IStreamPtr getFile(const FileStruct* fileStruct);
+        void prefetchFile(const FileStruct* fileStruct) const;
         void addFile(const std::string& filename, std::istream& file);
     };
 }
@@ -1,28 +1,12 @@
 #include "ba2gnrlfile.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <filesystem>
 #include <fstream>
 
-#include <lz4frame.h>
-
-#if defined(_MSC_VER)
-// why is this necessary? These are included with /external:I
-#pragma warning(push)
-#pragma warning(disable : 4706)
-#pragma warning(disable : 4702)
-#include <boost/iostreams/copy.hpp>
-#include <boost/iostreams/filter/zlib.hpp>
-#include <boost/iostreams/filtering_streambuf.hpp>
-#pragma warning(pop)
-#else
-#include <boost/iostreams/copy.hpp>
-#include <boost/iostreams/filter/zlib.hpp>
-#include <boost/iostreams/filtering_streambuf.hpp>
-#endif
-
-#include <boost/iostreams/device/array.hpp>
 #include <components/bsa/ba2file.hpp>
+#include <components/bsa/decompress.hpp>
 #include <components/bsa/memorystream.hpp>
 #include <components/esm/fourcc.hpp>
 #include <components/files/constrainedfilestream.hpp>
@@ -216,23 +200,32 @@ namespace Bsa
 
     Files::IStreamPtr BA2GNRLFile::getFile(const FileRecord& fileRecord)
     {
-        const uint32_t inputSize = fileRecord.packedSize ? fileRecord.packedSize : fileRecord.size;
-        Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.offset, inputSize);
-        auto memoryStreamPtr = std::make_unique<MemoryInputStream>(fileRecord.size);
-        if (fileRecord.packedSize)
+        if (!fileRecord.packedSize)
         {
-            boost::iostreams::filtering_streambuf<boost::iostreams::input> inputStreamBuf;
-            inputStreamBuf.push(boost::iostreams::zlib_decompressor());
-            inputStreamBuf.push(*streamPtr);
+            // Uncompressed data of memory mapped archive is served directly from the mapping
+            if (isMemoryMapped())
+                return openRegion(fileRecord.offset, fileRecord.size);
+            Files::IStreamPtr streamPtr = openRegion(fileRecord.offset, fileRecord.size);
+            auto memoryStreamPtr = std::make_unique<MemoryInputStream>(fileRecord.size);
+            streamPtr->read(memoryStreamPtr->getRawData(), fileRecord.size);
+            return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
+        }
 
-            boost::iostreams::basic_array_sink<char> sr(memoryStreamPtr->getRawData(), fileRecord.size);
-            boost::iostreams::copy(inputStreamBuf, sr);
+        if (Files::IStreamPtr cached = findDecompressedFile(fileRecord.offset))
+            return cached;
+
+        std::vector<char> buffer;
+        const std::span<const char> input = readRegion(fileRecord.offset, fileRecord.packedSize, buffer);
+        std::vector<char> result(fileRecord.size);
+        try
+        {
+            decompressZlib(input, result);
         }
-        else
+        catch (const std::exception& e)
         {
-            streamPtr->read(memoryStreamPtr->getRawData(), fileRecord.size);
+            fail(e.what());
         }
-        return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
+        return addDecompressedFile(fileRecord.offset, std::move(result));
     }
 
 } // namespace Bsa
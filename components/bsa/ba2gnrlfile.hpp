@@ -38,7 +38,11 @@ namespace Bsa
     public:
         using BSAFile::getFilename;
         using BSAFile::getList;
+        using BSAFile::isMemoryMapped;
+        using BSAFile::mapIntoMemory;
         using BSAFile::open;
+        using BSAFile::prefetchFile;
+        using BSAFile::setDecompressedFileCache;
 
         BA2GNRLFile();
         virtual ~BA2GNRLFile();
@@ -22,9 +22,11 @@
  */
 
 #include "bsa_file.hpp"
+#include "memorystream.hpp"
 
 #include <components/esm/fourcc.hpp>
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/memorystream.hpp>
 
 #include <algorithm>
 #include <cassert>
@@ -256,16 +258,97 @@ void BSAFile::open(const std::filesystem::path& file)
 void Bsa::BSAFile::close()
 {
     if (mHasChanged)
+    {
         writeHeader();
+        mHasChanged = false;
+    }
 
+    mMappedFile.reset();
+    if (mDecompressedFileCache != nullptr)
+        mDecompressedFileCache->erase(mArchiveId);
     mFiles.clear();
     mStringBuf.clear();
     mIsLoaded = false;
 }
 
+void Bsa::BSAFile::mapIntoMemory()
+{
+    if (!mIsLoaded)
+        fail("Unable to map the archive into memory: the archive is not opened");
+
+    mMappedFile = std::make_unique<Files::MemoryMappedFile>(mFilepath);
+}
+
+std::span<const char> Bsa::BSAFile::getMappedRegion(std::size_t offset, std::size_t size) const
+{
+    assert(mMappedFile != nullptr);
+    const std::span<const char> region = mMappedFile->getRegion(offset, size);
+    if (region.size() != size)
+        fail("Archive region [" + std::to_string(offset) + ", " + std::to_string(offset + size)
+            + ") is outside of the mapped file");
+    return region;
+}
+
+Files::IStreamPtr Bsa::BSAFile::openRegion(std::size_t offset, std::size_t size) const
+{
+    if (mMappedFile == nullptr)
+        return Files::openConstrainedFileStream(mFilepath, offset, size);
+    const std::span<const char> region = getMappedRegion(offset, size);
+    return std::make_unique<Files::IMemStream>(region.data(), region.size());
+}
+
+std::span<const char> Bsa::BSAFile::readRegion(std::size_t offset, std::size_t size, std::vector<char>& buffer) const
+{
+    if (mMappedFile != nullptr)
+        return getMappedRegion(offset, size);
+    buffer.resize(size);
+    Files::IStreamPtr stream = Files::openConstrainedFileStream(mFilepath, offset, size);
+    stream->read(buffer.data(), static_cast<std::streamsize>(size));
+    if (static_cast<std::size_t>(stream->gcount()) != size)
+        fail("Failed to read archive region [" + std::to_string(offset) + ", " + std::to_string(offset + size) + ")");
+    return buffer;
+}
+
+void Bsa::BSAFile::setDecompressedFileCache(std::shared_ptr<DecompressedFileCache> cache)
+{
+    if (mDecompressedFileCache != nullptr)
+        mDecompressedFileCache->erase(mArchiveId);
+    mDecompressedFileCache = std::move(cache);
+}
+
+Files::IStreamPtr Bsa::BSAFile::findDecompressedFile(std::uint64_t offset) const
+{
+    if (mDecompressedFileCache == nullptr)
+        return nullptr;
+    DecompressedFile file = mDecompressedFileCache->get(mArchiveId, offset);
+    if (file == nullptr)
+        return nullptr;
+    return std::make_unique<SharedMemoryInputStream>(std::move(file));
+}
+
+Files::IStreamPtr Bsa::BSAFile::addDecompressedFile(std::uint64_t offset, std::vector<char>&& content) const
+{
+    auto file = std::make_shared<const std::vector<char>>(std::move(content));
+    if (mDecompressedFileCache != nullptr)
+        mDecompressedFileCache->add(mArchiveId, offset, file);
+    return std::make_unique<SharedMemoryInputStream>(std::move(file));
+}
+
 Files::IStreamPtr Bsa::BSAFile::getFile(const FileStruct* file)
 {
-    return Files::openConstrainedFileStream(mFilepath, file->offset, file->fileSize);
+    return openRegion(file->offset, file->fileSize);
+}
+
+void Bsa::BSAFile::prefetchFile(const FileStruct* file) const
+{
+    prefetchRegion(file->offset, file->fileSize);
+}
+
+void Bsa::BSAFile::prefetchRegion(std::size_t offset, std::size_t size) const
+{
+    // Opening the archive for each prefetched file costs more than the prefetch saves
+    if (mMappedFile != nullptr)
+        mMappedFile->prefetch(offset, size);
 }
 
 void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
@@ -273,6 +356,9 @@ void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
     if (!mIsLoaded)
         fail("Unable to add file " + filename + " the archive is not opened");
 
+    // The archive is going to be modified, so the mapping becomes stale
+    mMappedFile.reset();
+
     auto newStartOfDataBuffer = 12 + (12 + 8) * (mFiles.size() + 1) + mStringBuf.size() + filename.size() + 1;
     if (mFiles.empty())
         std::filesystem::resize_file(mFilepath, newStartOfDataBuffer);
@@ -26,11 +26,15 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
+#include <components/bsa/decompressedfilecache.hpp>
 #include <components/files/conversion.hpp>
 #include <components/files/istreamptr.hpp>
+#include <components/files/memorymappedfile.hpp>
 
 namespace Bsa
 {
@@ -96,9 +100,38 @@ namespace Bsa
         /// Used for error messages
         std::filesystem::path mFilepath;
 
+        /// Archive content mapped into memory, file streams are used when not set
+        std::unique_ptr<Files::MemoryMappedFile> mMappedFile;
+
+        /// Optional cache of decompressed files, may be shared with other archives
+        std::shared_ptr<DecompressedFileCache> mDecompressedFileCache;
+
+        /// Distinguishes files of this archive in the cache
+        const std::uint64_t mArchiveId = DecompressedFileCache::generateArchiveId();
+
         /// Error handling
         [[noreturn]] void fail(const std::string& msg) const;
 
+        /// Returns a view of the archive region, the archive must be memory mapped.
+        std::span<const char> getMappedRegion(std::size_t offset, std::size_t size) const;
+
+        /// Open a stream reading the archive region. For memory mapped archive the stream reads directly
+        /// from the mapping without copying the data.
+        Files::IStreamPtr openRegion(std::size_t offset, std::size_t size) const;
+
+        /// Returns the archive region content. For memory mapped archive it is a view into the mapping, otherwise the
+        /// content is read into the buffer.
+        std::span<const char> readRegion(std::size_t offset, std::size_t size, std::vector<char>& buffer) const;
+
+        /// Hint the system to read the archive region in background. Does nothing for not memory mapped archive.
+        void prefetchRegion(std::size_t offset, std::size_t size) const;
+
+        /// Returns a stream reading the cached decompressed file located at the given offset or nullptr.
+        Files::IStreamPtr findDecompressedFile(std::uint64_t offset) const;
+
+        /// Put the decompressed file located at the given offset into the cache and returns a stream reading it.
+        Files::IStreamPtr addDecompressedFile(std::uint64_t offset, std::vector<char>&& content) const;
+
         /// Read header information from the input source
         virtual void readHeader();
         virtual void writeHeader();
@@ -124,6 +157,15 @@ namespace Bsa
 
         void close();
 
+        /// Map the whole opened archive into memory to serve files without file I/O.
+        /// @note Throws an exception if the mapping is not possible, the archive remains usable in this case.
+        void mapIntoMemory();
+
+        bool isMemoryMapped() const { return mMappedFile != nullptr; }
+
+        /// Set the cache for decompressed files of compressed archives.
+        void setDecompressedFileCache(std::shared_ptr<DecompressedFileCache> cache);
+
         /* -----------------------------------
          * Archive file routines
          * -----------------------------------
@@ -134,6 +176,11 @@ namespace Bsa
          */
         Files::IStreamPtr getFile(const FileStruct* file);
 
+        /** Hint the system that the file will be opened soon. Does not wait for the data to be read.
+         * @note Thread safe.
+         */
+        void prefetchFile(const FileStruct* file) const;
+
         void addFile(const std::string& filename, std::istream& file);
 
         /// Get a list of all files
@@ -24,30 +24,17 @@
  */
 #include "compressedbsafile.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 
-#include <lz4frame.h>
-
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 4706)
-#pragma warning(disable : 4702)
-#include <boost/iostreams/copy.hpp>
-#include <boost/iostreams/filter/zlib.hpp>
-#include <boost/iostreams/filtering_streambuf.hpp>
-#pragma warning(pop)
-#else
-#include <boost/iostreams/copy.hpp>
-#include <boost/iostreams/filter/zlib.hpp>
-#include <boost/iostreams/filtering_streambuf.hpp>
-#endif
-
-#include <boost/iostreams/device/array.hpp>
+#include <components/bsa/decompress.hpp>
 #include <components/bsa/memorystream.hpp>
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/memorystream.hpp>
 #include <components/misc/strings/lower.hpp>
 
 namespace Bsa
@@ -269,10 +256,17 @@ namespace Bsa
 
     Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
     {
+        const bool compressed = isCompressed(fileRecord);
+        if (compressed)
+            if (Files::IStreamPtr cached = findDecompressedFile(fileRecord.mOffset))
+                return cached;
+
+        if (isMemoryMapped())
+            return getMappedFile(fileRecord);
+
         size_t size = fileRecord.mSize & (~FileSizeFlag_Compression);
         size_t resultSize = size;
         Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.mOffset, size);
-        bool compressed = (fileRecord.mSize != size) == ((mHeader.mFlags & ArchiveFlag_Compress) == 0);
         if ((mHeader.mFlags & ArchiveFlag_EmbeddedNames) != 0)
         {
             // Skip over the embedded file name
@@ -285,44 +279,65 @@ namespace Bsa
         {
             streamPtr->read(reinterpret_cast<char*>(&resultSize), sizeof(uint32_t));
             size -= sizeof(uint32_t);
+
+            std::vector<char> input(size);
+            streamPtr->read(input.data(), size);
+            std::vector<char> result(resultSize);
+            decompress(input, result);
+            return addDecompressedFile(fileRecord.mOffset, std::move(result));
         }
+
         auto memoryStreamPtr = std::make_unique<MemoryInputStream>(resultSize);
+        streamPtr->read(memoryStreamPtr->getRawData(), size);
+        return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
+    }
 
-        if (compressed)
+    Files::IStreamPtr CompressedBSAFile::getMappedFile(const FileRecord& fileRecord)
+    {
+        const std::size_t size = fileRecord.mSize & (~FileSizeFlag_Compression);
+        std::span<const char> input = getMappedRegion(fileRecord.mOffset, size);
+        if ((mHeader.mFlags & ArchiveFlag_EmbeddedNames) != 0)
         {
-            if (mHeader.mVersion != Version_SSE)
-            {
-                boost::iostreams::filtering_streambuf<boost::iostreams::input> inputStreamBuf;
-                inputStreamBuf.push(boost::iostreams::zlib_decompressor());
-                inputStreamBuf.push(*streamPtr);
+            // Skip over the embedded file name
+            if (input.empty() || static_cast<std::uint8_t>(input.front()) >= input.size())
+                fail("Embedded file name is outside of the file record");
+            input = input.subspan(static_cast<std::uint8_t>(input.front()) + sizeof(std::uint8_t));
+        }
 
-                boost::iostreams::basic_array_sink<char> sr(memoryStreamPtr->getRawData(), resultSize);
-                boost::iostreams::copy(inputStreamBuf, sr);
-            }
+        // Uncompressed data is served directly from the mapping
+        if (!isCompressed(fileRecord))
+            return std::make_unique<Files::IMemStream>(input.data(), input.size());
+
+        std::uint32_t resultSize = 0;
+        if (input.size() < sizeof(resultSize))
+            fail("Compressed file record is too small");
+        std::memcpy(&resultSize, input.data(), sizeof(resultSize));
+        input = input.subspan(sizeof(resultSize));
+
+        std::vector<char> result(resultSize);
+        decompress(input, result);
+        return addDecompressedFile(fileRecord.mOffset, std::move(result));
+    }
+
+    bool CompressedBSAFile::isCompressed(const FileRecord& fileRecord) const
+    {
+        const std::uint32_t size = fileRecord.mSize & (~FileSizeFlag_Compression);
+        return (fileRecord.mSize != size) == ((mHeader.mFlags & ArchiveFlag_Compress) == 0);
+    }
+
+    void CompressedBSAFile::decompress(std::span<const char> input, std::span<char> output) const
+    {
+        try
+        {
+            if (mHeader.mVersion != Version_SSE)
+                decompressZlib(input, output);
             else
-            {
-                auto buffer = std::vector<char>(size);
-                streamPtr->read(buffer.data(), size);
-                LZ4F_decompressionContext_t context = nullptr;
-                LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
-                LZ4F_decompressOptions_t options = {};
-                LZ4F_errorCode_t errorCode = LZ4F_decompress(
-                    context, memoryStreamPtr->getRawData(), &resultSize, buffer.data(), &size, &options);
-                if (LZ4F_isError(errorCode))
-                    fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
-                        + "): " + LZ4F_getErrorName(errorCode));
-                errorCode = LZ4F_freeDecompressionContext(context);
-                if (LZ4F_isError(errorCode))
-                    fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
-                        + "): " + LZ4F_getErrorName(errorCode));
-            }
+                decompressLz4Frame(input, output);
         }
-        else
+        catch (const std::exception& e)
         {
-            streamPtr->read(memoryStreamPtr->getRawData(), size);
+            fail(e.what());
         }
-
-        return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
     }
 
     std::uint64_t CompressedBSAFile::generateHash(const std::filesystem::path& stem, std::string extension)
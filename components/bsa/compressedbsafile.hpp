@@ -28,6 +28,7 @@
 
 #include <limits>
 #include <map>
+#include <span>
 
 #include <components/bsa/bsa_file.hpp>
 #include <filesystem>
@@ -113,11 +114,18 @@ namespace Bsa
         /// \brief Normalizes given filename or folder and generates format-compatible hash.
         static std::uint64_t generateHash(const std::filesystem::path& stem, std::string extension);
         Files::IStreamPtr getFile(const FileRecord& fileRecord);
+        Files::IStreamPtr getMappedFile(const FileRecord& fileRecord);
+        bool isCompressed(const FileRecord& fileRecord) const;
+        void decompress(std::span<const char> input, std::span<char> output) const;
 
     public:
         using BSAFile::getFilename;
         using BSAFile::getList;
+        using BSAFile::isMemoryMapped;
+        using BSAFile::mapIntoMemory;
         using BSAFile::open;
+        using BSAFile::prefetchFile;
+        using BSAFile::setDecompressedFileCache;
 
         CompressedBSAFile() = default;
         virtual ~CompressedBSAFile() = default;
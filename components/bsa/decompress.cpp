@@ -0,0 +1,108 @@
+#include "decompress.hpp"
+
+#include <lz4frame.h>
+#include <zlib.h>
+
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace Bsa
+{
+    namespace
+    {
+        class ZlibContext
+        {
+        public:
+            ZlibContext()
+            {
+                if (const int code = inflateInit(&mStream); code != Z_OK)
+                    throw std::runtime_error(
+                        "Failed to initialize zlib decompression context: " + std::to_string(code));
+            }
+
+            ZlibContext(const ZlibContext&) = delete;
+
+            ~ZlibContext() { inflateEnd(&mStream); }
+
+            z_stream& get() { return mStream; }
+
+        private:
+            z_stream mStream{};
+        };
+
+        class Lz4Context
+        {
+        public:
+            Lz4Context()
+            {
+                const LZ4F_errorCode_t code = LZ4F_createDecompressionContext(&mContext, LZ4F_VERSION);
+                if (LZ4F_isError(code))
+                    throw std::runtime_error(
+                        std::string("Failed to create LZ4 decompression context: ") + LZ4F_getErrorName(code));
+            }
+
+            Lz4Context(const Lz4Context&) = delete;
+
+            ~Lz4Context() { LZ4F_freeDecompressionContext(mContext); }
+
+            LZ4F_decompressionContext_t get() const { return mContext; }
+
+        private:
+            LZ4F_decompressionContext_t mContext = nullptr;
+        };
+
+        // Worker threads live long enough to make per thread contexts reused by most of the calls
+        ZlibContext& getZlibContext()
+        {
+            thread_local ZlibContext context;
+            return context;
+        }
+
+        std::unique_ptr<Lz4Context>& getLz4Context()
+        {
+            thread_local std::unique_ptr<Lz4Context> context;
+            if (context == nullptr)
+                context = std::make_unique<Lz4Context>();
+            return context;
+        }
+    }
+
+    void decompressZlib(std::span<const char> input, std::span<char> output)
+    {
+        if (input.size() > std::numeric_limits<uInt>::max() || output.size() > std::numeric_limits<uInt>::max())
+            throw std::runtime_error("zlib decompression error: buffer is too large");
+
+        z_stream& stream = getZlibContext().get();
+        if (const int code = inflateReset(&stream); code != Z_OK)
+            throw std::runtime_error("zlib decompression error: failed to reset context: " + std::to_string(code));
+
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        stream.avail_in = static_cast<uInt>(input.size());
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = static_cast<uInt>(output.size());
+
+        const int code = inflate(&stream, Z_FINISH);
+        // Output buffer may be filled before the end of the stream is reached
+        if (code != Z_STREAM_END && !(stream.avail_out == 0 && (code == Z_OK || code == Z_BUF_ERROR)))
+            throw std::runtime_error("zlib decompression error: "
+                + (stream.msg != nullptr ? std::string(stream.msg) : std::to_string(code)));
+    }
+
+    void decompressLz4Frame(std::span<const char> input, std::span<char> output)
+    {
+        std::unique_ptr<Lz4Context>& context = getLz4Context();
+        LZ4F_decompressOptions_t options = {};
+        std::size_t inputSize = input.size();
+        std::size_t outputSize = output.size();
+        const LZ4F_errorCode_t code
+            = LZ4F_decompress(context->get(), output.data(), &outputSize, input.data(), &inputSize, &options);
+        // Context keeps the state of a partially decoded frame which happens on error or when output is full,
+        // such context can not be used for the next frame
+        if (code != 0)
+            context.reset();
+        if (LZ4F_isError(code))
+            throw std::runtime_error(std::string("LZ4 decompression error: ") + LZ4F_getErrorName(code));
+    }
+}
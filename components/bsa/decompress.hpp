@@ -0,0 +1,19 @@
+#ifndef OPENMW_COMPONENTS_BSA_DECOMPRESS_H
+#define OPENMW_COMPONENTS_BSA_DECOMPRESS_H
+
+#include <span>
+
+namespace Bsa
+{
+    /// Decompress zlib stream to fill the output buffer.
+    /// @note Thread safe. Decompression contexts are reused by the calls from the same thread.
+    /// @note Throws an exception on malformed input.
+    void decompressZlib(std::span<const char> input, std::span<char> output);
+
+    /// Decompress LZ4 frame to fill the output buffer.
+    /// @note Thread safe. Decompression contexts are reused by the calls from the same thread.
+    /// @note Throws an exception on malformed input.
+    void decompressLz4Frame(std::span<const char> input, std::span<char> output);
+}
+
+#endif
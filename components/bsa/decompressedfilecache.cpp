@@ -0,0 +1,93 @@
+#include "decompressedfilecache.hpp"
+
+#include <atomic>
+#include <functional>
+
+namespace Bsa
+{
+    DecompressedFileCache::DecompressedFileCache(std::size_t maxSize)
+        : mMaxSize(maxSize)
+    {
+    }
+
+    std::uint64_t DecompressedFileCache::generateArchiveId()
+    {
+        static std::atomic_uint64_t nextId{ 0 };
+        return nextId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::size_t DecompressedFileCache::KeyHash::operator()(const Key& key) const
+    {
+        const std::hash<std::uint64_t> hash;
+        return hash(key.mArchiveId) ^ (hash(key.mOffset) + 0x9e3779b9 + (key.mArchiveId << 6) + (key.mArchiveId >> 2));
+    }
+
+    DecompressedFile DecompressedFileCache::get(std::uint64_t archiveId, std::uint64_t offset)
+    {
+        const std::lock_guard lock(mMutex);
+        const auto it = mIndex.find(Key{ archiveId, offset });
+        if (it == mIndex.end())
+        {
+            ++mMisses;
+            return nullptr;
+        }
+        ++mHits;
+        mItems.splice(mItems.begin(), mItems, it->second);
+        return it->second->mFile;
+    }
+
+    void DecompressedFileCache::add(std::uint64_t archiveId, std::uint64_t offset, DecompressedFile file)
+    {
+        const std::size_t fileSize = file->size();
+        // Caching a file larger than the whole cache would only evict everything else
+        if (fileSize > mMaxSize)
+            return;
+
+        const std::lock_guard lock(mMutex);
+        const Key key{ archiveId, offset };
+        if (mIndex.contains(key))
+            return;
+
+        mSize += fileSize;
+        mItems.push_front(Item{ key, std::move(file) });
+        mIndex.emplace(key, mItems.begin());
+
+        while (mSize > mMaxSize)
+            removeLeastRecentlyUsed();
+    }
+
+    void DecompressedFileCache::erase(std::uint64_t archiveId)
+    {
+        const std::lock_guard lock(mMutex);
+        for (auto it = mItems.begin(); it != mItems.end();)
+        {
+            if (it->mKey.mArchiveId != archiveId)
+            {
+                ++it;
+                continue;
+            }
+            mSize -= it->mFile->size();
+            mIndex.erase(it->mKey);
+            it = mItems.erase(it);
+        }
+    }
+
+    DecompressedFileCacheStats DecompressedFileCache::getStats() const
+    {
+        const std::lock_guard lock(mMutex);
+        return DecompressedFileCacheStats{
+            .mSize = mSize,
+            .mCount = mItems.size(),
+            .mHits = mHits,
+            .mMisses = mMisses,
+        };
+    }
+
+    void DecompressedFileCache::removeLeastRecentlyUsed()
+    {
+        const Item& item = mItems.back();
+        mSize -= item.mFile->size();
+        mIndex.erase(item.mKey);
+        mItems.pop_back();
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef OPENMW_COMPONENTS_BSA_DECOMPRESSEDFILECACHE_H
+#define OPENMW_COMPONENTS_BSA_DECOMPRESSEDFILECACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Bsa
+{
+    using DecompressedFile = std::shared_ptr<const std::vector<char>>;
+
+    struct DecompressedFileCacheStats
+    {
+        std::size_t mSize = 0;
+        std::size_t mCount = 0;
+        std::size_t mHits = 0;
+        std::size_t mMisses = 0;
+    };
+
+    /// @brief LRU cache of decompressed archive files limited by the total size of the content.
+    /// @note Thread safe. May be shared by multiple archives.
+    class DecompressedFileCache
+    {
+    public:
+        explicit DecompressedFileCache(std::size_t maxSize);
+
+        /// Returns a unique id to distinguish files of different archives.
+        static std::uint64_t generateArchiveId();
+
+        DecompressedFile get(std::uint64_t archiveId, std::uint64_t offset);
+
+        void add(std::uint64_t archiveId, std::uint64_t offset, DecompressedFile file);
+
+        /// Remove all files of the given archive.
+        void erase(std::uint64_t archiveId);
+
+        DecompressedFileCacheStats getStats() const;
+
+    private:
+        struct Key
+        {
+            std::uint64_t mArchiveId;
+            std::uint64_t mOffset;
+
+            friend bool operator==(const Key& lhs, const Key& rhs) = default;
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()(const Key& key) const;
+        };
+
+        struct Item
+        {
+            Key mKey;
+            DecompressedFile mFile;
+        };
+
+        const std::size_t mMaxSize;
+        mutable std::mutex mMutex;
+        // Most recently used files are at the front
+        std::list<Item> mItems;
+        std::unordered_map<Key, std::list<Item>::iterator, KeyHash> mIndex;
+        std::size_t mSize = 0;
+        std::size_t mHits = 0;
+        std::size_t mMisses = 0;
+
+        void removeLeastRecentlyUsed();
+    };
+}
+
+#endif
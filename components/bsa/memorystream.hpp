@@ -28,6 +28,7 @@
 
 #include <components/files/memorystream.hpp>
 #include <istream>
+#include <memory>
 #include <vector>
 
 namespace Bsa
@@ -53,5 +54,26 @@ namespace Bsa
         char* getRawData() { return this->data(); }
     };
 
+    struct SharedBufferHolder
+    {
+        std::shared_ptr<const std::vector<char>> mBuffer;
+    };
+
+    /**
+        Allows to pass a memory buffer shared with other owners (e.g. a cache) as Files::IStreamPtr.
+
+        Memory buffer is kept alive while the class instance exists.
+     */
+    class SharedMemoryInputStream : private SharedBufferHolder, public Files::MemBuf, public std::istream
+    {
+    public:
+        explicit SharedMemoryInputStream(std::shared_ptr<const std::vector<char>> buffer)
+            : SharedBufferHolder{ std::move(buffer) }
+            , Files::MemBuf(mBuffer->data(), mBuffer->size())
+            , std::istream(static_cast<std::streambuf*>(this))
+        {
+        }
+    };
+
 }
 #endif
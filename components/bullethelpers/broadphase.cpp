@@ -0,0 +1,68 @@
+#include "broadphase.hpp"
+
+#include <BulletCollision/BroadphaseCollision/btAxisSweep3.h>
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/BroadphaseCollision/btOverlappingPairCache.h>
+
+#include <stdexcept>
+#include <string>
+
+namespace BulletHelpers
+{
+    namespace
+    {
+        // Morrowind cells are 8192 units wide, this covers 512x512 cells around the origin
+        constexpr btScalar worldHalfWidth = 1 << 22;
+        constexpr btScalar worldHalfHeight = 1 << 18;
+
+        // Each handle takes about 100 bytes
+        constexpr unsigned maxAxisSweepHandles = 1 << 18;
+
+        // Has to be constructed before the broadphase using it
+        struct NullPairCacheHolder
+        {
+            btNullPairCache mNullPairCache;
+        };
+
+        class DbvtBroadphase final : private NullPairCacheHolder, public btDbvtBroadphase
+        {
+        public:
+            DbvtBroadphase()
+                : btDbvtBroadphase(&mNullPairCache)
+            {
+                m_deferedcollide = true;
+            }
+        };
+
+        class AxisSweepBroadphase final : private NullPairCacheHolder, public bt32BitAxisSweep3
+        {
+        public:
+            AxisSweepBroadphase()
+                : bt32BitAxisSweep3(btVector3(-worldHalfWidth, -worldHalfWidth, -worldHalfHeight),
+                    btVector3(worldHalfWidth, worldHalfWidth, worldHalfHeight), maxAxisSweepHandles, &mNullPairCache)
+            {
+            }
+        };
+    }
+
+    std::optional<BroadphaseType> parseBroadphaseType(std::string_view value)
+    {
+        if (value == "dbvt")
+            return BroadphaseType::Dbvt;
+        if (value == "sap")
+            return BroadphaseType::AxisSweep;
+        return std::nullopt;
+    }
+
+    std::unique_ptr<btBroadphaseInterface> makeQueryBroadphase(BroadphaseType type)
+    {
+        switch (type)
+        {
+            case BroadphaseType::Dbvt:
+                return std::make_unique<DbvtBroadphase>();
+            case BroadphaseType::AxisSweep:
+                return std::make_unique<AxisSweepBroadphase>();
+        }
+        throw std::logic_error("Unsupported broadphase type: " + std::to_string(static_cast<int>(type)));
+    }
+}
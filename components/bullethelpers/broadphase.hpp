@@ -0,0 +1,27 @@
+#ifndef OPENMW_COMPONENTS_BULLETHELPERS_BROADPHASE_H
+#define OPENMW_COMPONENTS_BULLETHELPERS_BROADPHASE_H
+
+#include <memory>
+#include <optional>
+#include <string_view>
+
+class btBroadphaseInterface;
+
+namespace BulletHelpers
+{
+    enum class BroadphaseType
+    {
+        Dbvt,
+        AxisSweep,
+    };
+
+    std::optional<BroadphaseType> parseBroadphaseType(std::string_view value);
+
+    /// @brief Creates a broadphase for a collision world used only for queries: ray, convex sweep, contact and aabb
+    /// tests.
+    /// @par Overlapping pairs are not tracked, so inserting, moving and removing objects doesn't search for pairs.
+    /// Collision world must not be used to perform collision detection.
+    std::unique_ptr<btBroadphaseInterface> makeQueryBroadphase(BroadphaseType type);
+}
+
+#endif
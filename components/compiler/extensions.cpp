@@ -1,8 +1,11 @@
 #include "extensions.hpp"
 
 #include <cassert>
+#include <sstream>
 #include <stdexcept>
 
+#include <components/files/hash.hpp>
+
 #include "generator.hpp"
 #include "literals.hpp"
 
@@ -204,4 +207,23 @@ namespace Compiler
         for (const auto& mKeyword : mKeywords)
             keywords.push_back(mKeyword.first);
     }
+
+    std::array<std::uint64_t, 2> Extensions::getHash() const
+    {
+        std::ostringstream stream;
+        for (const auto& [keyword, index] : mKeywords)
+        {
+            stream << keyword << ' ' << index;
+            if (auto it = mFunctions.find(index); it != mFunctions.end())
+                stream << " f " << it->second.mReturn << ' ' << it->second.mArguments << ' ' << it->second.mCode << ' '
+                       << it->second.mCodeExplicit << ' ' << it->second.mSegment;
+            if (auto it = mInstructions.find(index); it != mInstructions.end())
+                stream << " i " << it->second.mArguments << ' ' << it->second.mCode << ' ' << it->second.mCodeExplicit
+                       << ' ' << it->second.mSegment;
+            stream << '\n';
+        }
+        const std::string signature = stream.str();
+        std::istringstream input(signature);
+        return Files::getHash("extensions", input);
+    }
 }
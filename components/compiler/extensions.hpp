@@ -1,6 +1,8 @@
 #ifndef COMPILER_EXTENSIONS_H_INCLUDED
 #define COMPILER_EXTENSIONS_H_INCLUDED
 
+#include <array>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -106,6 +108,9 @@ namespace Compiler
 
         void listKeywords(std::vector<std::string>& keywords) const;
         ///< Append all known keywords to \a kaywords.
+
+        std::array<std::uint64_t, 2> getHash() const;
+        ///< Return hash of all registered keywords together with their arguments and opcodes.
     };
 }
 
@@ -0,0 +1,348 @@
+#include "scriptcache.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+#include <components/version/version.hpp>
+
+#include "extensions.hpp"
+
+namespace Compiler
+{
+    namespace
+    {
+        constexpr std::uint32_t formatVersion = 2;
+        constexpr std::uint32_t maxSize = 16 * 1024 * 1024;
+        constexpr std::string_view localTypes = "slf";
+
+        template <class T>
+        void writeValue(std::ostream& stream, T value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void writeString(std::ostream& stream, std::string_view value)
+        {
+            writeValue(stream, static_cast<std::uint32_t>(value.size()));
+            stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+        }
+
+        template <class T>
+        void writeValues(std::ostream& stream, const std::vector<T>& values)
+        {
+            writeValue(stream, static_cast<std::uint32_t>(values.size()));
+            stream.write(
+                reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+        }
+
+        template <class T>
+        void readValue(std::istream& stream, T& value)
+        {
+            if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+                throw std::runtime_error("unexpected end of file");
+        }
+
+        std::uint32_t readSize(std::istream& stream)
+        {
+            std::uint32_t size = 0;
+            readValue(stream, size);
+            if (size > maxSize)
+                throw std::runtime_error("invalid size: " + std::to_string(size));
+            return size;
+        }
+
+        std::string readString(std::istream& stream)
+        {
+            std::string value(readSize(stream), '\0');
+            if (!stream.read(value.data(), static_cast<std::streamsize>(value.size())))
+                throw std::runtime_error("unexpected end of file");
+            return value;
+        }
+
+        template <class T>
+        void readValues(std::istream& stream, std::vector<T>& values)
+        {
+            values.resize(readSize(stream));
+            if (!stream.read(
+                    reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T))))
+                throw std::runtime_error("unexpected end of file");
+        }
+
+        std::string makeHeader(const Extensions& extensions, int warningsMode)
+        {
+            std::ostringstream stream;
+            stream.write("OMWS", 4);
+            writeValue(stream, formatVersion);
+            writeString(stream, Version::getVersion());
+            writeString(stream, Version::getCommitHash());
+            const std::array<std::uint64_t, 2> extensionsHash = extensions.getHash();
+            writeValue(stream, extensionsHash[0]);
+            writeValue(stream, extensionsHash[1]);
+            writeValue(stream, static_cast<std::int32_t>(warningsMode));
+            return stream.str();
+        }
+
+        void writeEntry(std::ostream& stream, const ScriptCache::Entry& entry)
+        {
+            writeValues(stream, entry.mProgram.mInstructions);
+            writeValues(stream, entry.mProgram.mIntegers);
+            writeValues(stream, entry.mProgram.mFloats);
+            writeValue(stream, static_cast<std::uint32_t>(entry.mProgram.mStrings.size()));
+            for (const std::string& value : entry.mProgram.mStrings)
+                writeString(stream, value);
+
+            for (const char type : localTypes)
+            {
+                const std::vector<std::string>& names = entry.mLocals.get(type);
+                writeValue(stream, static_cast<std::uint32_t>(names.size()));
+                for (const std::string& name : names)
+                    writeString(stream, name);
+            }
+
+            const ScriptDependencies& dependencies = entry.mDependencies;
+            writeValue(stream, static_cast<std::uint32_t>(dependencies.mGlobals.size()));
+            for (const auto& [name, type] : dependencies.mGlobals)
+            {
+                writeString(stream, name);
+                writeValue(stream, type);
+            }
+            writeValue(stream, static_cast<std::uint32_t>(dependencies.mMembers.size()));
+            for (const ScriptDependencies::Member& member : dependencies.mMembers)
+            {
+                writeString(stream, member.mName);
+                writeString(stream, member.mId.serializeText());
+                writeValue(stream, member.mType.first);
+                writeValue(stream, static_cast<std::uint8_t>(member.mType.second));
+            }
+            writeValue(stream, static_cast<std::uint32_t>(dependencies.mIds.size()));
+            for (const auto& [id, isId] : dependencies.mIds)
+            {
+                writeString(stream, id.serializeText());
+                writeValue(stream, static_cast<std::uint8_t>(isId));
+            }
+
+            writeValue(stream, static_cast<std::uint32_t>(entry.mWarnings.size()));
+            for (const std::string& warning : entry.mWarnings)
+                writeString(stream, warning);
+        }
+
+        ScriptCache::Entry readEntry(std::istream& stream)
+        {
+            ScriptCache::Entry entry;
+
+            readValues(stream, entry.mProgram.mInstructions);
+            readValues(stream, entry.mProgram.mIntegers);
+            readValues(stream, entry.mProgram.mFloats);
+            entry.mProgram.mStrings.resize(readSize(stream));
+            for (std::string& value : entry.mProgram.mStrings)
+                value = readString(stream);
+
+            for (const char type : localTypes)
+            {
+                const std::uint32_t count = readSize(stream);
+                for (std::uint32_t i = 0; i < count; ++i)
+                    entry.mLocals.declare(type, readString(stream));
+            }
+
+            ScriptDependencies& dependencies = entry.mDependencies;
+            dependencies.mGlobals.resize(readSize(stream));
+            for (auto& [name, type] : dependencies.mGlobals)
+            {
+                name = readString(stream);
+                readValue(stream, type);
+            }
+            dependencies.mMembers.resize(readSize(stream));
+            for (ScriptDependencies::Member& member : dependencies.mMembers)
+            {
+                member.mName = readString(stream);
+                member.mId = ESM::RefId::deserializeText(readString(stream));
+                std::uint8_t isReference = 0;
+                readValue(stream, member.mType.first);
+                readValue(stream, isReference);
+                member.mType.second = isReference != 0;
+            }
+            dependencies.mIds.resize(readSize(stream));
+            for (auto& [id, isId] : dependencies.mIds)
+            {
+                id = ESM::RefId::deserializeText(readString(stream));
+                std::uint8_t value = 0;
+                readValue(stream, value);
+                isId = value != 0;
+            }
+
+            entry.mWarnings.resize(readSize(stream));
+            for (std::string& warning : entry.mWarnings)
+                warning = readString(stream);
+
+            return entry;
+        }
+    }
+
+    bool ScriptDependencies::isSatisfied(const Context& context) const
+    {
+        for (const auto& [name, type] : mGlobals)
+            if (context.getGlobalType(name) != type)
+                return false;
+        for (const Member& member : mMembers)
+            if (context.getMemberType(member.mName, member.mId) != member.mType)
+                return false;
+        for (const auto& [id, isId] : mIds)
+            if (context.isId(id) != isId)
+                return false;
+        return true;
+    }
+
+    void ScriptDependencies::clear()
+    {
+        mGlobals.clear();
+        mMembers.clear();
+        mIds.clear();
+    }
+
+    void ScriptDependencies::removeDuplicates()
+    {
+        const auto removeDuplicates = [](auto& values) {
+            std::sort(values.begin(), values.end());
+            values.erase(std::unique(values.begin(), values.end()), values.end());
+        };
+        removeDuplicates(mGlobals);
+        removeDuplicates(mMembers);
+        removeDuplicates(mIds);
+    }
+
+    RecordingContext::RecordingContext(const Context& context)
+        : mContext(context)
+    {
+        setExtensions(context.getExtensions());
+    }
+
+    bool RecordingContext::canDeclareLocals() const
+    {
+        return mContext.canDeclareLocals();
+    }
+
+    char RecordingContext::getGlobalType(const std::string& name) const
+    {
+        const char type = mContext.getGlobalType(name);
+        mDependencies.mGlobals.emplace_back(name, type);
+        return type;
+    }
+
+    std::pair<char, bool> RecordingContext::getMemberType(const std::string& name, const ESM::RefId& id) const
+    {
+        const std::pair<char, bool> type = mContext.getMemberType(name, id);
+        mDependencies.mMembers.push_back(ScriptDependencies::Member{ name, id, type });
+        return type;
+    }
+
+    bool RecordingContext::isId(const ESM::RefId& name) const
+    {
+        const bool result = mContext.isId(name);
+        mDependencies.mIds.emplace_back(name, result);
+        return result;
+    }
+
+    void RecordingContext::clear()
+    {
+        mDependencies.clear();
+    }
+
+    ScriptCache::ScriptCache(const std::filesystem::path& path, const Extensions& extensions, int warningsMode)
+        : mPath(path)
+        , mHeader(makeHeader(extensions, warningsMode))
+    {
+        std::ifstream stream(mPath, std::ios_base::binary);
+        if (!stream.is_open())
+            return;
+
+        try
+        {
+            std::string header(mHeader.size(), '\0');
+            if (!stream.read(header.data(), static_cast<std::streamsize>(header.size())) || header != mHeader)
+                return;
+
+            const std::uint32_t count = readSize(stream);
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                Hash textHash;
+                readValue(stream, textHash[0]);
+                readValue(stream, textHash[1]);
+                mEntries.emplace(textHash, readEntry(stream));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read compiled scripts cache " << mPath << ": " << e.what();
+            mEntries.clear();
+        }
+    }
+
+    ScriptCache::Hash ScriptCache::getTextHash(std::string_view text)
+    {
+        std::istringstream stream{ std::string(text) };
+        return Files::getHash("script", stream);
+    }
+
+    const ScriptCache::Entry* ScriptCache::find(const Hash& textHash, const Context& context) const
+    {
+        const auto it = mEntries.find(textHash);
+        if (it == mEntries.end() || !it->second.mDependencies.isSatisfied(context))
+            return nullptr;
+        return &it->second;
+    }
+
+    void ScriptCache::insert(const Hash& textHash, Entry&& entry)
+    {
+        mEntries.insert_or_assign(textHash, std::move(entry));
+        mModified = true;
+    }
+
+    void ScriptCache::retain(const std::set<Hash>& textHashes)
+    {
+        const std::size_t removed
+            = std::erase_if(mEntries, [&](const auto& entry) { return !textHashes.contains(entry.first); });
+        if (removed > 0)
+            mModified = true;
+    }
+
+    void ScriptCache::write()
+    {
+        if (!mModified)
+            return;
+
+        // Write into a temporary file first to never leave a partially written cache behind
+        std::filesystem::path tempPath = mPath;
+        tempPath += ".tmp";
+
+        try
+        {
+            std::filesystem::create_directories(mPath.parent_path());
+
+            {
+                std::ofstream stream(tempPath, std::ios_base::binary | std::ios_base::trunc);
+                stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+                stream.write(mHeader.data(), static_cast<std::streamsize>(mHeader.size()));
+                writeValue(stream, static_cast<std::uint32_t>(mEntries.size()));
+                for (const auto& [textHash, entry] : mEntries)
+                {
+                    writeValue(stream, textHash[0]);
+                    writeValue(stream, textHash[1]);
+                    writeEntry(stream, entry);
+                }
+            }
+
+            std::filesystem::rename(tempPath, mPath);
+            mModified = false;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write compiled scripts cache " << mPath << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+        }
+    }
+}
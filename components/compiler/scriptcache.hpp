@@ -0,0 +1,125 @@
+#ifndef COMPILER_SCRIPTCACHE_H_INCLUDED
+#define COMPILER_SCRIPTCACHE_H_INCLUDED
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <components/esm/refid.hpp>
+#include <components/interpreter/program.hpp>
+
+#include "context.hpp"
+#include "locals.hpp"
+
+namespace Compiler
+{
+    class Extensions;
+
+    /// \brief Answers of the compiler context a script compilation result depends on
+
+    struct ScriptDependencies
+    {
+        struct Member
+        {
+            std::string mName;
+            ESM::RefId mId;
+            std::pair<char, bool> mType;
+
+            friend bool operator==(const Member& lhs, const Member& rhs) = default;
+            friend bool operator<(const Member& lhs, const Member& rhs)
+            {
+                return std::tie(lhs.mName, lhs.mId, lhs.mType) < std::tie(rhs.mName, rhs.mId, rhs.mType);
+            }
+        };
+
+        std::vector<std::pair<std::string, char>> mGlobals;
+        std::vector<Member> mMembers;
+        std::vector<std::pair<ESM::RefId, bool>> mIds;
+
+        bool isSatisfied(const Context& context) const;
+        ///< Does \a context give the same answers?
+
+        void clear();
+
+        void removeDuplicates();
+        ///< Keep only one copy of the answers recorded for the repeated queries.
+    };
+
+    /// \brief Context forwarding all queries to another context and recording the answers
+
+    class RecordingContext : public Context
+    {
+        const Context& mContext;
+        mutable ScriptDependencies mDependencies;
+
+    public:
+        explicit RecordingContext(const Context& context);
+
+        bool canDeclareLocals() const override;
+
+        char getGlobalType(const std::string& name) const override;
+
+        std::pair<char, bool> getMemberType(const std::string& name, const ESM::RefId& id) const override;
+
+        bool isId(const ESM::RefId& name) const override;
+
+        const ScriptDependencies& getDependencies() const { return mDependencies; }
+
+        void clear();
+        ///< Forget all recorded answers.
+    };
+
+    /// \brief Persistent cache of compiled scripts
+    ///
+    /// Scripts are identified by the hash of their text. An entry is used only when the compiler context gives the
+    /// same answers as it did during the compilation, so changes to the loaded content files are detected. The whole
+    /// cache is discarded when the engine version or the registered extensions change.
+
+    class ScriptCache
+    {
+    public:
+        using Hash = std::array<std::uint64_t, 2>;
+
+        struct Entry
+        {
+            Interpreter::Program mProgram;
+            Locals mLocals;
+            ScriptDependencies mDependencies;
+            std::vector<std::string> mWarnings;
+        };
+
+    private:
+        std::filesystem::path mPath;
+        std::string mHeader;
+        std::map<Hash, Entry> mEntries;
+        bool mModified = false;
+
+    public:
+        ScriptCache(const std::filesystem::path& path, const Extensions& extensions, int warningsMode);
+        ///< Read entries from \a path if it exists and was written with the same extensions and warnings mode.
+
+        static Hash getTextHash(std::string_view text);
+
+        const Entry* find(const Hash& textHash, const Context& context) const;
+        ///< Return compiled script with given text hash if it's valid for \a context, nullptr otherwise.
+
+        void insert(const Hash& textHash, Entry&& entry);
+
+        void retain(const std::set<Hash>& textHashes);
+        ///< Remove entries with text hash not in \a textHashes.
+
+        std::size_t size() const { return mEntries.size(); }
+
+        void write();
+        ///< Write entries to the file if anything was added since the last write.
+    };
+}
+
+#endif
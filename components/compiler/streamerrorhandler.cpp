@@ -12,46 +12,47 @@ namespace Compiler
 
     void StreamErrorHandler::report(const std::string& message, const TokenLoc& loc, Type type)
     {
-        Debug::Level logLevel = Debug::Info; // Usually script warnings are not too important
-        if (type == ErrorMessage)
-            logLevel = Debug::Error;
-
         std::stringstream text;
-
-        if (type == ErrorMessage)
-            text << "Error: ";
-        else
-            text << "Warning: ";
-
-        if (!mContext.empty())
-            text << mContext << " ";
-
         text << "line " << loc.mLine + 1 << ", column " << loc.mColumn + 1 << " (" << loc.mLiteral << "): " << message;
 
-        Log(logLevel) << text.str();
+        if (type == WarningMessage)
+            mWarnings.push_back(text.str());
+
+        log(text.str(), type);
     }
 
     // Report a file related error
 
     void StreamErrorHandler::report(const std::string& message, Type type)
     {
-        Debug::Level logLevel = Debug::Info;
+        std::stringstream text;
+        text << "file: " << message << std::endl;
+
+        if (type == WarningMessage)
+            mWarnings.push_back(text.str());
+
+        log(text.str(), type);
+    }
+
+    void StreamErrorHandler::log(const std::string& text, Type type) const
+    {
+        Debug::Level logLevel = Debug::Info; // Usually script warnings are not too important
         if (type == ErrorMessage)
             logLevel = Debug::Error;
 
-        std::stringstream text;
+        std::stringstream message;
 
         if (type == ErrorMessage)
-            text << "Error: ";
+            message << "Error: ";
         else
-            text << "Warning: ";
+            message << "Warning: ";
 
         if (!mContext.empty())
-            text << mContext << " ";
+            message << mContext << " ";
 
-        text << "file: " << message << std::endl;
+        message << text;
 
-        Log(logLevel) << text.str();
+        Log(logLevel) << message.str();
     }
 
     void StreamErrorHandler::setContext(const std::string& context)
@@ -59,6 +60,17 @@ namespace Compiler
         mContext = context;
     }
 
+    void StreamErrorHandler::reset()
+    {
+        ErrorHandler::reset();
+        mWarnings.clear();
+    }
+
+    void StreamErrorHandler::replayWarning(const std::string& warning) const
+    {
+        log(warning, WarningMessage);
+    }
+
     StreamErrorHandler::StreamErrorHandler() = default;
 
     ContextOverride::ContextOverride(StreamErrorHandler& handler, const std::string& context)
@@ -1,6 +1,9 @@
 #ifndef COMPILER_STREAMERRORHANDLER_H_INCLUDED
 #define COMPILER_STREAMERRORHANDLER_H_INCLUDED
 
+#include <string>
+#include <vector>
+
 #include "errorhandler.hpp"
 
 namespace Compiler
@@ -11,6 +14,7 @@ namespace Compiler
     class StreamErrorHandler : public ErrorHandler
     {
         std::string mContext;
+        std::vector<std::string> mWarnings;
 
         friend class ContextOverride;
         // not implemented
@@ -24,9 +28,19 @@ namespace Compiler
         void report(const std::string& message, Type type) override;
         ///< Report a file related error
 
+        void log(const std::string& text, Type type) const;
+
     public:
         void setContext(const std::string& context);
 
+        void reset() override;
+
+        const std::vector<std::string>& getWarnings() const { return mWarnings; }
+        ///< Return warnings reported since the last reset without the context.
+
+        void replayWarning(const std::string& warning) const;
+        ///< Report a warning returned by getWarnings() again with the current context.
+
         // constructors
 
         StreamErrorHandler();
@@ -24,6 +24,7 @@
 #include <set>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace DetourNavigator
 {
@@ -62,7 +63,8 @@ namespace DetourNavigator
             if (db == nullptr)
                 return nullptr;
             return std::make_unique<DbWorker>(updater, std::move(db), TileVersion(navMeshFormatVersion),
-                settings.mRecast, settings.mWriteToNavMeshDb);
+                settings.mRecast, settings.mWriteToNavMeshDb, settings.mDbTransactionInterval,
+                settings.mMaxDbTransactionSize);
         }
 
         std::size_t getNextJobId()
@@ -280,6 +282,9 @@ namespace DetourNavigator
         , mOffMeshConnectionsManager(offMeshConnectionsManager)
         , mShouldStop()
         , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
+        , mHeightfieldsCache(settings.mMaxHeightfieldsCacheSize == 0
+                  ? nullptr
+                  : std::make_unique<HeightfieldsCache>(settings.mMaxHeightfieldsCacheSize))
         , mDbWorker(makeDbWorker(*this, std::move(db), mSettings))
     {
         for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
@@ -443,6 +448,8 @@ namespace DetourNavigator
         if (mDbWorker != nullptr)
             result.mDb = mDbWorker->getStats();
         result.mCache = mNavMeshTilesCache.getStats();
+        if (mHeightfieldsCache != nullptr)
+            result.mHeightfields = mHeightfieldsCache->getStats();
         result.mDbGetTileHits = mDbGetTileHits.load(std::memory_order_relaxed);
         return result;
     }
@@ -578,8 +585,8 @@ namespace DetourNavigator
                 return JobStatus::MemoryCacheMiss;
             }
 
-            preparedNavMeshData = prepareNavMeshTileData(
-                *recastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = prepareNavMeshTileData(*recastMesh, job.mWorldspace, job.mChangedTile,
+                job.mAgentBounds, mSettings.get().mRecast, mHeightfieldsCache.get());
 
             if (preparedNavMeshData == nullptr)
             {
@@ -630,8 +637,8 @@ namespace DetourNavigator
 
         if (preparedNavMeshData == nullptr)
         {
-            preparedNavMeshData = prepareNavMeshTileData(
-                *job.mRecastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = prepareNavMeshTileData(*job.mRecastMesh, job.mWorldspace, job.mChangedTile,
+                job.mAgentBounds, mSettings.get().mRecast, mHeightfieldsCache.get());
             generatedNavMeshData = true;
         }
 
@@ -809,13 +816,16 @@ namespace DetourNavigator
         mHasJob.notify_all();
     }
 
-    std::optional<JobIt> DbJobQueue::pop()
+    std::optional<JobIt> DbJobQueue::pop(std::optional<std::chrono::steady_clock::time_point> deadline)
     {
         std::unique_lock lock(mMutex);
 
         const auto hasJob = [&] { return mShouldStop || mReading.size() > 0 || mWriting.size() > 0; };
 
-        mHasJob.wait(lock, hasJob);
+        if (!deadline.has_value())
+            mHasJob.wait(lock, hasJob);
+        else if (!mHasJob.wait_until(lock, *deadline, hasJob))
+            return std::nullopt;
 
         if (mShouldStop)
             return std::nullopt;
@@ -857,7 +867,8 @@ namespace DetourNavigator
     }
 
     DbWorker::DbWorker(AsyncNavMeshUpdater& updater, std::unique_ptr<NavMeshDb>&& db, TileVersion version,
-        const RecastSettings& recastSettings, bool writeToDb)
+        const RecastSettings& recastSettings, bool writeToDb, std::chrono::milliseconds transactionInterval,
+        std::size_t maxTransactionSize)
         : mUpdater(updater)
         , mRecastSettings(recastSettings)
         , mDb(std::move(db))
@@ -865,6 +876,8 @@ namespace DetourNavigator
         , mWriteToDb(writeToDb)
         , mNextTileId(mDb->getMaxTileId() + 1)
         , mNextShapeId(mDb->getMaxShapeId() + 1)
+        , mTransactionInterval(transactionInterval)
+        , mMaxTransactionSize(std::max<std::size_t>(maxTransactionSize, 1))
         , mThread([this] { run(); })
     {
     }
@@ -885,6 +898,9 @@ namespace DetourNavigator
         return DbWorkerStats{
             .mJobs = mQueue.getStats(),
             .mGetTileCount = mGetTileCount.load(std::memory_order_relaxed),
+            .mWriteCount = mWriteCount.load(std::memory_order_relaxed),
+            .mCommitCount = mCommitCount.load(std::memory_order_relaxed),
+            .mPendingWriteCount = mPendingWriteCount.load(std::memory_order_relaxed),
         };
     }
 
@@ -902,8 +918,24 @@ namespace DetourNavigator
         {
             try
             {
-                if (const auto job = mQueue.pop())
+                if (const auto job = mQueue.pop(getCommitDeadline()))
                     processJob(*job);
+                if (mTransaction.has_value()
+                    && (mPendingWriteCount >= mMaxTransactionSize
+                        || std::chrono::steady_clock::now() >= mTransactionStart + mTransactionInterval))
+                    commitTransaction();
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "DbWorker exception: " << e.what();
+            }
+        }
+
+        if (mTransaction.has_value())
+        {
+            try
+            {
+                commitTransaction();
             }
             catch (const std::exception& e)
             {
@@ -922,39 +954,7 @@ namespace DetourNavigator
             catch (const std::exception& e)
             {
                 Log(Debug::Error) << "DbWorker exception while processing job " << job->mId << ": " << e.what();
-                if (mWriteToDb)
-                {
-                    const std::string_view message(e.what());
-                    if (message.find("database or disk is full") != std::string_view::npos)
-                    {
-                        mWriteToDb = false;
-                        Log(Debug::Warning)
-                            << "Writes to navmeshdb are disabled because file size limit is reached or disk is full";
-                    }
-                    else if (message.find("database is locked") != std::string_view::npos)
-                    {
-                        mWriteToDb = false;
-                        Log(Debug::Warning)
-                            << "Writes to navmeshdb are disabled to avoid concurrent writes from multiple processes";
-                    }
-                    else if (message.find("UNIQUE constraint failed: tiles.tile_id") != std::string_view::npos)
-                    {
-                        Log(Debug::Warning) << "Found duplicate navmeshdb tile_id, please report the "
-                                               "issue to https://gitlab.com/OpenMW/openmw/-/issues, attach openmw.log: "
-                                            << mNextTileId;
-                        try
-                        {
-                            mNextTileId = TileId(mDb->getMaxTileId() + 1);
-                            Log(Debug::Info) << "Updated navmeshdb tile_id to: " << mNextTileId;
-                        }
-                        catch (const std::exception& e)
-                        {
-                            mWriteToDb = false;
-                            Log(Debug::Warning)
-                                << "Failed to update next tile_id, writes to navmeshdb are disabled: " << e.what();
-                        }
-                    }
-                }
+                handleWriteError(e.what());
             }
         };
 
@@ -1028,6 +1028,9 @@ namespace DetourNavigator
 
         Log(Debug::Debug) << "Processing db write job " << job->mId;
 
+        if (!mTransaction.has_value())
+            beginTransaction();
+
         if (job->mInput.empty())
         {
             Log(Debug::Debug) << "Serializing input for job " << job->mId;
@@ -1042,6 +1045,8 @@ namespace DetourNavigator
             Log(Debug::Debug) << "Update db tile by job " << job->mId;
             job->mGeneratedNavMeshData->mUserId = cachedTileData->mTileId;
             mDb->updateTile(cachedTileData->mTileId, mVersion, serialize(*job->mGeneratedNavMeshData));
+            ++mWriteCount;
+            ++mPendingWriteCount;
             return;
         }
 
@@ -1057,5 +1062,78 @@ namespace DetourNavigator
         mDb->insertTile(mNextTileId, job->mWorldspace, job->mChangedTile, mVersion, job->mInput,
             serialize(*job->mGeneratedNavMeshData));
         ++mNextTileId;
+        ++mWriteCount;
+        ++mPendingWriteCount;
+    }
+
+    void DbWorker::handleWriteError(std::string_view message)
+    {
+        if (!mWriteToDb)
+            return;
+        if (message.find("database or disk is full") != std::string_view::npos)
+        {
+            mWriteToDb = false;
+            Log(Debug::Warning)
+                << "Writes to navmeshdb are disabled because file size limit is reached or disk is full";
+        }
+        else if (message.find("database is locked") != std::string_view::npos)
+        {
+            mWriteToDb = false;
+            Log(Debug::Warning)
+                << "Writes to navmeshdb are disabled to avoid concurrent writes from multiple processes";
+        }
+        else if (message.find("UNIQUE constraint failed: tiles.tile_id") != std::string_view::npos)
+        {
+            Log(Debug::Warning) << "Found duplicate navmeshdb tile_id, please report the "
+                                   "issue to https://gitlab.com/OpenMW/openmw/-/issues, attach openmw.log: "
+                                << mNextTileId;
+            try
+            {
+                mNextTileId = TileId(mDb->getMaxTileId() + 1);
+                Log(Debug::Info) << "Updated navmeshdb tile_id to: " << mNextTileId;
+            }
+            catch (const std::exception& e)
+            {
+                mWriteToDb = false;
+                Log(Debug::Warning) << "Failed to update next tile_id, writes to navmeshdb are disabled: " << e.what();
+            }
+        }
+        if (!mWriteToDb && mTransaction.has_value())
+        {
+            // SQLite may have already rolled back the transaction on such errors, so there is nothing to commit
+            mTransaction.reset();
+            mPendingWriteCount = 0;
+        }
+    }
+
+    void DbWorker::beginTransaction()
+    {
+        mTransaction.emplace(mDb->startTransaction(Sqlite3::TransactionMode::Immediate));
+        mTransactionStart = std::chrono::steady_clock::now();
+    }
+
+    void DbWorker::commitTransaction()
+    {
+        std::optional<Sqlite3::Transaction> transaction = std::exchange(mTransaction, std::nullopt);
+        const std::size_t pendingWriteCount = mPendingWriteCount.exchange(0);
+        Log(Debug::Debug) << "Commit " << pendingWriteCount << " db writes";
+        try
+        {
+            transaction->commit();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "DbWorker failed to commit " << pendingWriteCount << " writes: " << e.what();
+            handleWriteError(e.what());
+            return;
+        }
+        ++mCommitCount;
+    }
+
+    std::optional<std::chrono::steady_clock::time_point> DbWorker::getCommitDeadline() const
+    {
+        if (!mTransaction.has_value())
+            return std::nullopt;
+        return mTransactionStart + mTransactionInterval;
     }
 }
@@ -4,6 +4,7 @@
 #include "agentbounds.hpp"
 #include "changetype.hpp"
 #include "guardednavmeshcacheitem.hpp"
+#include "heightfieldscache.hpp"
 #include "navmeshcacheitem.hpp"
 #include "navmeshdb.hpp"
 #include "navmeshtilescache.hpp"
@@ -27,6 +28,7 @@
 #include <mutex>
 #include <optional>
 #include <set>
+#include <string_view>
 #include <thread>
 #include <tuple>
 
@@ -134,7 +136,8 @@ namespace DetourNavigator
     public:
         void push(JobIt job);
 
-        std::optional<JobIt> pop();
+        std::optional<JobIt> pop(std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt);
+        ///< Wait for a job until \a deadline if it's set. Returns std::nullopt on timeout or stop.
 
         void update(TilePosition playerTile);
 
@@ -153,11 +156,15 @@ namespace DetourNavigator
 
     class AsyncNavMeshUpdater;
 
+    /// @brief Processes navmeshdb jobs in a single thread.
+    /// @par Writes are grouped into transactions committed when the given interval or number of writes is reached or
+    /// the worker is stopped to avoid syncing the file to disk for each tile.
     class DbWorker
     {
     public:
         DbWorker(AsyncNavMeshUpdater& updater, std::unique_ptr<NavMeshDb>&& db, TileVersion version,
-            const RecastSettings& recastSettings, bool writeToDb);
+            const RecastSettings& recastSettings, bool writeToDb, std::chrono::milliseconds transactionInterval,
+            std::size_t maxTransactionSize);
 
         ~DbWorker();
 
@@ -177,9 +184,16 @@ namespace DetourNavigator
         bool mWriteToDb;
         TileId mNextTileId;
         ShapeId mNextShapeId;
+        const std::chrono::milliseconds mTransactionInterval;
+        const std::size_t mMaxTransactionSize;
+        std::optional<Sqlite3::Transaction> mTransaction;
+        std::chrono::steady_clock::time_point mTransactionStart;
         DbJobQueue mQueue;
         std::atomic_bool mShouldStop{ false };
         std::atomic_size_t mGetTileCount{ 0 };
+        std::atomic_size_t mWriteCount{ 0 };
+        std::atomic_size_t mCommitCount{ 0 };
+        std::atomic_size_t mPendingWriteCount{ 0 };
         std::thread mThread;
 
         inline void run() noexcept;
@@ -189,6 +203,14 @@ namespace DetourNavigator
         inline void processReadingJob(JobIt job);
 
         inline void processWritingJob(JobIt job);
+
+        inline void handleWriteError(std::string_view message);
+
+        inline void beginTransaction();
+
+        inline void commitTransaction();
+
+        inline std::optional<std::chrono::steady_clock::time_point> getCommitDeadline() const;
     };
 
     class AsyncNavMeshUpdater
@@ -226,6 +248,7 @@ namespace DetourNavigator
         std::set<std::tuple<AgentBounds, TilePosition>> mPushed;
         Misc::ScopeGuarded<TilePosition> mPlayerTile;
         NavMeshTilesCache mNavMeshTilesCache;
+        std::unique_ptr<HeightfieldsCache> mHeightfieldsCache;
         Misc::ScopeGuarded<std::set<std::tuple<AgentBounds, TilePosition>>> mProcessingTiles;
         std::map<std::tuple<AgentBounds, TilePosition>, std::chrono::steady_clock::time_point> mLastUpdates;
         std::set<std::tuple<AgentBounds, TilePosition>> mPresentTiles;
@@ -0,0 +1,75 @@
+#include "heightfieldscache.hpp"
+#include "stats.hpp"
+
+namespace DetourNavigator
+{
+    std::size_t getSize(const RasterizedTile& value)
+    {
+        return sizeof(value) + value.mTriangles.mVertices.size() * sizeof(float)
+            + value.mTriangles.mAreas.size() * sizeof(unsigned char) + value.mColumns.size() * sizeof(std::uint32_t)
+            + value.mSpans.size() * sizeof(HeightfieldSpan);
+    }
+
+    HeightfieldsCache::HeightfieldsCache(std::size_t maxSize)
+        : mMaxSize(maxSize)
+    {
+    }
+
+    std::shared_ptr<const RasterizedTile> HeightfieldsCache::get(
+        const AgentBounds& agentBounds, const TilePosition& tilePosition)
+    {
+        const std::lock_guard lock(mMutex);
+
+        ++mGetCount;
+
+        const auto it = mIndex.find(Key(agentBounds, tilePosition));
+        if (it == mIndex.end())
+            return nullptr;
+
+        ++mHitCount;
+
+        mItems.splice(mItems.end(), mItems, it->second);
+
+        return it->second->mValue;
+    }
+
+    void HeightfieldsCache::set(const AgentBounds& agentBounds, const TilePosition& tilePosition,
+        std::shared_ptr<const RasterizedTile>&& value)
+    {
+        const std::size_t size = getSize(*value);
+        Key key(agentBounds, tilePosition);
+
+        const std::lock_guard lock(mMutex);
+
+        if (const auto it = mIndex.find(key); it != mIndex.end())
+            erase(it->second);
+
+        if (size > mMaxSize)
+            return;
+
+        while (!mItems.empty() && mSize + size > mMaxSize)
+            erase(mItems.begin());
+
+        const auto it = mItems.insert(mItems.end(), Item{ key, std::move(value), size });
+        mIndex.emplace(std::move(key), it);
+        mSize += size;
+    }
+
+    HeightfieldsCacheStats HeightfieldsCache::getStats() const
+    {
+        const std::lock_guard lock(mMutex);
+        return HeightfieldsCacheStats{
+            .mSize = mSize,
+            .mTiles = mItems.size(),
+            .mGetCount = mGetCount,
+            .mHitCount = mHitCount,
+        };
+    }
+
+    void HeightfieldsCache::erase(std::list<Item>::iterator it)
+    {
+        mSize -= it->mSize;
+        mIndex.erase(it->mKey);
+        mItems.erase(it);
+    }
+}
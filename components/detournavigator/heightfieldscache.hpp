@@ -0,0 +1,88 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_HEIGHTFIELDSCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_HEIGHTFIELDSCACHE_H
+
+#include "agentbounds.hpp"
+#include "tileposition.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace DetourNavigator
+{
+    struct HeightfieldsCacheStats;
+
+    struct HeightfieldSpan
+    {
+        unsigned short mMin;
+        unsigned short mMax;
+        unsigned char mArea;
+    };
+
+    /// Triangles in navmesh coordinates to be rasterized into a tile heightfield.
+    struct RasterizationTriangles
+    {
+        std::vector<float> mVertices; ///< 9 values per triangle
+        std::vector<unsigned char> mAreas; ///< 1 value per triangle
+    };
+
+    /// Rasterization input and resulting heightfield of a navmesh tile before applying any filters.
+    struct RasterizedTile
+    {
+        std::array<float, 3> mMin;
+        std::array<float, 3> mMax;
+        float mCellSize = 0;
+        float mCellHeight = 0;
+        int mWidth = 0;
+        int mHeight = 0;
+        int mFlagMergeThreshold = 0;
+        RasterizationTriangles mTriangles;
+        std::vector<std::uint32_t> mColumns; ///< Offsets of columns in mSpans, mWidth * mHeight + 1 values
+        std::vector<HeightfieldSpan> mSpans;
+    };
+
+    std::size_t getSize(const RasterizedTile& value);
+
+    /// @brief LRU cache of rasterized navmesh tiles limited by the total size.
+    /// @par Allows to rasterize only the part of a tile heightfield affected by changed triangles.
+    class HeightfieldsCache
+    {
+    public:
+        explicit HeightfieldsCache(std::size_t maxSize);
+
+        std::shared_ptr<const RasterizedTile> get(const AgentBounds& agentBounds, const TilePosition& tilePosition);
+
+        void set(const AgentBounds& agentBounds, const TilePosition& tilePosition,
+            std::shared_ptr<const RasterizedTile>&& value);
+
+        HeightfieldsCacheStats getStats() const;
+
+    private:
+        using Key = std::tuple<AgentBounds, TilePosition>;
+
+        struct Item
+        {
+            Key mKey;
+            std::shared_ptr<const RasterizedTile> mValue;
+            std::size_t mSize;
+        };
+
+        mutable std::mutex mMutex;
+        std::size_t mMaxSize;
+        std::size_t mSize = 0;
+        std::size_t mGetCount = 0;
+        std::size_t mHitCount = 0;
+        std::list<Item> mItems;
+        std::map<Key, std::list<Item>::iterator> mIndex;
+
+        void erase(std::list<Item>::iterator it);
+    };
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include "debug.hpp"
 #include "exceptions.hpp"
 #include "flags.hpp"
+#include "heightfieldscache.hpp"
 #include "navmeshdata.hpp"
 #include "navmeshdb.hpp"
 #include "navmeshtilescache.hpp"
@@ -24,6 +25,9 @@
 #include <array>
 #include <iomanip>
 #include <limits>
+#include <numeric>
+#include <optional>
+#include <tuple>
 
 namespace DetourNavigator
 {
@@ -198,36 +202,43 @@ namespace DetourNavigator
             return std::all_of(begin, end, isSupportedCoordinate);
         }
 
-        [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const Mesh& mesh, const RecastSettings& settings,
-            const RecastParams& params, rcHeightfield& solid)
+        [[nodiscard]] bool collectTriangles(RecastContext& context, const Mesh& mesh, const RecastSettings& settings,
+            RasterizationTriangles& triangles)
         {
             std::vector<unsigned char> areas(mesh.getAreaTypes().begin(), mesh.getAreaTypes().end());
             std::vector<float> vertices = mesh.getVertices();
 
-            constexpr std::size_t verticesPerTriangle = 3;
+            // Separate loops without early exits are vectorized
+            for (float& coordinate : vertices)
+                coordinate = toNavMeshCoordinates(settings, coordinate);
 
-            for (std::size_t i = 0; i < vertices.size(); i += verticesPerTriangle)
-            {
-                for (std::size_t j = 0; j < verticesPerTriangle; ++j)
-                {
-                    const float coordinate = toNavMeshCoordinates(settings, vertices[i + j]);
-                    if (!isSupportedCoordinate(coordinate))
-                        return false;
-                    vertices[i + j] = coordinate;
-                }
+            bool supported = true;
+            for (const float coordinate : vertices)
+                supported &= isSupportedCoordinate(coordinate);
+            if (!supported)
+                return false;
+
+            for (std::size_t i = 0; i < vertices.size(); i += 3)
                 std::swap(vertices[i + 1], vertices[i + 2]);
-            }
 
             rcClearUnwalkableTriangles(&context, settings.mMaxSlope, vertices.data(),
                 static_cast<int>(mesh.getVerticesCount()), mesh.getIndices().data(), static_cast<int>(areas.size()),
                 areas.data());
 
-            return rcRasterizeTriangles(&context, vertices.data(), static_cast<int>(mesh.getVerticesCount()),
-                mesh.getIndices().data(), areas.data(), static_cast<int>(areas.size()), solid, params.mWalkableClimb);
+            const std::vector<int>& indices = mesh.getIndices();
+            triangles.mVertices.reserve(triangles.mVertices.size() + indices.size() * 3);
+            for (const int index : indices)
+            {
+                const auto vertex = vertices.begin() + static_cast<std::ptrdiff_t>(index) * 3;
+                triangles.mVertices.insert(triangles.mVertices.end(), vertex, vertex + 3);
+            }
+            triangles.mAreas.insert(triangles.mAreas.end(), areas.begin(), areas.end());
+
+            return true;
         }
 
-        [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const Rectangle& rectangle, AreaType areaType,
-            const RecastParams& params, rcHeightfield& solid)
+        [[nodiscard]] bool collectTriangles(
+            const Rectangle& rectangle, AreaType areaType, RasterizationTriangles& triangles)
         {
             const std::array vertices{
                 rectangle.mBounds.mMin.x(), rectangle.mHeight, rectangle.mBounds.mMin.y(), // vertex 0
@@ -244,15 +255,16 @@ namespace DetourNavigator
                 0, 2, 3, // triangle 1
             };
 
-            const std::array<unsigned char, 2> areas{ areaType, areaType };
+            for (const int index : indices)
+                triangles.mVertices.insert(triangles.mVertices.end(), vertices.begin() + index * 3,
+                    vertices.begin() + index * 3 + 3);
+            triangles.mAreas.insert(triangles.mAreas.end(), indices.size() / 3, areaType);
 
-            return rcRasterizeTriangles(&context, vertices.data(), static_cast<int>(vertices.size() / 3),
-                indices.data(), areas.data(), static_cast<int>(areas.size()), solid, params.mWalkableClimb);
+            return true;
         }
 
-        [[nodiscard]] bool rasterizeTriangles(RecastContext& context, float agentHalfExtentsZ,
-            const std::vector<CellWater>& water, const RecastSettings& settings, const RecastParams& params,
-            const TileBounds& realTileBounds, rcHeightfield& solid)
+        [[nodiscard]] bool collectTriangles(float agentHalfExtentsZ, const std::vector<CellWater>& water,
+            const RecastSettings& settings, const TileBounds& realTileBounds, RasterizationTriangles& triangles)
         {
             for (const CellWater& cellWater : water)
             {
@@ -263,16 +275,16 @@ namespace DetourNavigator
                     const Rectangle rectangle{ toNavMeshCoordinates(settings, *intersection),
                         toNavMeshCoordinates(
                             settings, getSwimLevel(settings, cellWater.mWater.mLevel, agentHalfExtentsZ)) };
-                    if (!rasterizeTriangles(context, rectangle, AreaType_water, params, solid))
+                    if (!collectTriangles(rectangle, AreaType_water, triangles))
                         return false;
                 }
             }
             return true;
         }
 
-        [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const TileBounds& realTileBounds,
+        [[nodiscard]] bool collectTriangles(const TileBounds& realTileBounds,
             const std::vector<FlatHeightfield>& heightfields, const RecastSettings& settings,
-            const RecastParams& params, rcHeightfield& solid)
+            RasterizationTriangles& triangles)
         {
             for (const FlatHeightfield& heightfield : heightfields)
             {
@@ -281,36 +293,339 @@ namespace DetourNavigator
                 {
                     const Rectangle rectangle{ toNavMeshCoordinates(settings, *intersection),
                         toNavMeshCoordinates(settings, heightfield.mHeight) };
-                    if (!rasterizeTriangles(context, rectangle, AreaType_ground, params, solid))
+                    if (!collectTriangles(rectangle, AreaType_ground, triangles))
                         return false;
                 }
             }
             return true;
         }
 
-        [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const std::vector<Heightfield>& heightfields,
-            const RecastSettings& settings, const RecastParams& params, rcHeightfield& solid)
+        [[nodiscard]] bool collectTriangles(RecastContext& context, const std::vector<Heightfield>& heightfields,
+            const RecastSettings& settings, RasterizationTriangles& triangles)
         {
             for (const Heightfield& heightfield : heightfields)
             {
                 const Mesh mesh = makeMesh(heightfield);
-                if (!rasterizeTriangles(context, mesh, settings, params, solid))
+                if (!collectTriangles(context, mesh, settings, triangles))
                     return false;
             }
             return true;
         }
 
-        [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const TilePosition& tilePosition,
+        [[nodiscard]] bool collectTriangles(RecastContext& context, const TilePosition& tilePosition,
             float agentHalfExtentsZ, const RecastMesh& recastMesh, const RecastSettings& settings,
-            const RecastParams& params, rcHeightfield& solid)
+            RasterizationTriangles& triangles)
         {
             const TileBounds realTileBounds = makeRealTileBoundsWithBorder(settings, tilePosition);
-            return rasterizeTriangles(context, recastMesh.getMesh(), settings, params, solid)
-                && rasterizeTriangles(
-                    context, agentHalfExtentsZ, recastMesh.getWater(), settings, params, realTileBounds, solid)
-                && rasterizeTriangles(context, recastMesh.getHeightfields(), settings, params, solid)
-                && rasterizeTriangles(
-                    context, realTileBounds, recastMesh.getFlatHeightfields(), settings, params, solid);
+            return collectTriangles(context, recastMesh.getMesh(), settings, triangles)
+                && collectTriangles(agentHalfExtentsZ, recastMesh.getWater(), settings, realTileBounds, triangles)
+                && collectTriangles(context, recastMesh.getHeightfields(), settings, triangles)
+                && collectTriangles(realTileBounds, recastMesh.getFlatHeightfields(), settings, triangles);
+        }
+
+        [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const RasterizationTriangles& triangles,
+            const RecastParams& params, rcHeightfield& solid)
+        {
+            return rcRasterizeTriangles(&context, triangles.mVertices.data(), triangles.mAreas.data(),
+                static_cast<int>(triangles.mAreas.size()), solid, params.mWalkableClimb);
+        }
+
+        struct CellsRange
+        {
+            int mMinX;
+            int mMinZ;
+            int mMaxX;
+            int mMaxZ;
+
+            bool contains(int x, int z) const { return mMinX <= x && x <= mMaxX && mMinZ <= z && z <= mMaxZ; }
+
+            bool intersects(const CellsRange& other) const
+            {
+                return mMinX <= other.mMaxX && other.mMinX <= mMaxX && mMinZ <= other.mMaxZ && other.mMinZ <= mMaxZ;
+            }
+        };
+
+        // Rasterization may touch a cell outside of the triangle bounds due to rounding so add one more cell
+        CellsRange getTriangleCells(const RasterizedTile& tile, const float* vertices)
+        {
+            float minX = vertices[0];
+            float maxX = vertices[0];
+            float minZ = vertices[2];
+            float maxZ = vertices[2];
+            for (std::size_t i = 1; i < 3; ++i)
+            {
+                minX = std::min(minX, vertices[i * 3]);
+                maxX = std::max(maxX, vertices[i * 3]);
+                minZ = std::min(minZ, vertices[i * 3 + 2]);
+                maxZ = std::max(maxZ, vertices[i * 3 + 2]);
+            }
+            const auto toCell = [&](float value, std::size_t axis) {
+                return static_cast<int>(std::floor((value - tile.mMin[axis]) / tile.mCellSize));
+            };
+            return CellsRange{
+                .mMinX = std::max(toCell(minX, 0) - 1, 0),
+                .mMinZ = std::max(toCell(minZ, 2) - 1, 0),
+                .mMaxX = std::min(toCell(maxX, 0) + 1, tile.mWidth - 1),
+                .mMaxZ = std::min(toCell(maxZ, 2) + 1, tile.mHeight - 1),
+            };
+        }
+
+        bool hasSameHeightfield(const RasterizedTile& lhs, const RasterizedTile& rhs)
+        {
+            return std::tie(lhs.mMin, lhs.mMax, lhs.mCellSize, lhs.mCellHeight, lhs.mWidth, lhs.mHeight,
+                       lhs.mFlagMergeThreshold)
+                == std::tie(rhs.mMin, rhs.mMax, rhs.mCellSize, rhs.mCellHeight, rhs.mWidth, rhs.mHeight,
+                    rhs.mFlagMergeThreshold);
+        }
+
+        int compareTriangles(const RasterizationTriangles& lhs, std::size_t lhsIndex,
+            const RasterizationTriangles& rhs, std::size_t rhsIndex)
+        {
+            if (lhs.mAreas[lhsIndex] != rhs.mAreas[rhsIndex])
+                return lhs.mAreas[lhsIndex] < rhs.mAreas[rhsIndex] ? -1 : 1;
+            const float* const lhsVertices = lhs.mVertices.data() + lhsIndex * 9;
+            const float* const rhsVertices = rhs.mVertices.data() + rhsIndex * 9;
+            for (std::size_t i = 0; i < 9; ++i)
+            {
+                if (lhsVertices[i] < rhsVertices[i])
+                    return -1;
+                if (rhsVertices[i] < lhsVertices[i])
+                    return 1;
+            }
+            return 0;
+        }
+
+        std::vector<std::size_t> getSortedTriangles(const RasterizationTriangles& triangles)
+        {
+            std::vector<std::size_t> result(triangles.mAreas.size());
+            std::iota(result.begin(), result.end(), 0);
+            std::sort(result.begin(), result.end(), [&](std::size_t lhs, std::size_t rhs) {
+                return compareTriangles(triangles, lhs, triangles, rhs) < 0;
+            });
+            return result;
+        }
+
+        struct TrianglesDiff
+        {
+            bool mSameOrder = true;
+            std::optional<CellsRange> mChangedCells;
+        };
+
+        // Finds cells range covering all triangles present only in one of the tiles. Rasterization result depends on
+        // the order of triangles so also checks that triangles present in both tiles go in the same order.
+        TrianglesDiff getTrianglesDiff(const RasterizedTile& cached, const RasterizedTile& tile)
+        {
+            const std::vector<std::size_t> cachedTriangles = getSortedTriangles(cached.mTriangles);
+            const std::vector<std::size_t> tileTriangles = getSortedTriangles(tile.mTriangles);
+            std::vector<bool> cachedChanged(cachedTriangles.size(), false);
+            std::vector<bool> tileChanged(tileTriangles.size(), false);
+
+            TrianglesDiff result;
+
+            const auto add = [&](const RasterizationTriangles& triangles, std::size_t index) {
+                const CellsRange cells = getTriangleCells(tile, triangles.mVertices.data() + index * 9);
+                if (cells.mMinX > cells.mMaxX || cells.mMinZ > cells.mMaxZ)
+                    return;
+                if (!result.mChangedCells.has_value())
+                {
+                    result.mChangedCells = cells;
+                    return;
+                }
+                result.mChangedCells->mMinX = std::min(result.mChangedCells->mMinX, cells.mMinX);
+                result.mChangedCells->mMinZ = std::min(result.mChangedCells->mMinZ, cells.mMinZ);
+                result.mChangedCells->mMaxX = std::max(result.mChangedCells->mMaxX, cells.mMaxX);
+                result.mChangedCells->mMaxZ = std::max(result.mChangedCells->mMaxZ, cells.mMaxZ);
+            };
+
+            const auto addCached = [&](std::size_t index) {
+                cachedChanged[index] = true;
+                add(cached.mTriangles, index);
+            };
+
+            const auto addTile = [&](std::size_t index) {
+                tileChanged[index] = true;
+                add(tile.mTriangles, index);
+            };
+
+            auto cachedIt = cachedTriangles.begin();
+            auto tileIt = tileTriangles.begin();
+            while (cachedIt != cachedTriangles.end() || tileIt != tileTriangles.end())
+            {
+                if (tileIt == tileTriangles.end())
+                {
+                    addCached(*cachedIt++);
+                    continue;
+                }
+                if (cachedIt == cachedTriangles.end())
+                {
+                    addTile(*tileIt++);
+                    continue;
+                }
+                const int order = compareTriangles(cached.mTriangles, *cachedIt, tile.mTriangles, *tileIt);
+                if (order < 0)
+                    addCached(*cachedIt++);
+                else if (order > 0)
+                    addTile(*tileIt++);
+                else
+                {
+                    ++cachedIt;
+                    ++tileIt;
+                }
+            }
+
+            std::size_t cachedIndex = 0;
+            std::size_t tileIndex = 0;
+            while (true)
+            {
+                while (cachedIndex < cachedChanged.size() && cachedChanged[cachedIndex])
+                    ++cachedIndex;
+                while (tileIndex < tileChanged.size() && tileChanged[tileIndex])
+                    ++tileIndex;
+                if (cachedIndex == cachedChanged.size() || tileIndex == tileChanged.size())
+                    break;
+                if (compareTriangles(cached.mTriangles, cachedIndex, tile.mTriangles, tileIndex) != 0)
+                {
+                    result.mSameOrder = false;
+                    break;
+                }
+                ++cachedIndex;
+                ++tileIndex;
+            }
+
+            return result;
+        }
+
+        void readSpans(const rcHeightfield& solid, RasterizedTile& tile)
+        {
+            tile.mColumns.clear();
+            tile.mSpans.clear();
+            tile.mColumns.reserve(static_cast<std::size_t>(solid.width * solid.height) + 1);
+            for (int i = 0, n = solid.width * solid.height; i < n; ++i)
+            {
+                tile.mColumns.push_back(static_cast<std::uint32_t>(tile.mSpans.size()));
+                for (const rcSpan* span = solid.spans[i]; span != nullptr; span = span->next)
+                    tile.mSpans.push_back(HeightfieldSpan{ .mMin = static_cast<unsigned short>(span->smin),
+                        .mMax = static_cast<unsigned short>(span->smax),
+                        .mArea = static_cast<unsigned char>(span->area) });
+            }
+            tile.mColumns.push_back(static_cast<std::uint32_t>(tile.mSpans.size()));
+        }
+
+        // Takes spans of changed cells from the rasterized heightfield and the rest from the cached tile
+        void mergeSpans(
+            const RasterizedTile& cached, const rcHeightfield& changed, const CellsRange& cells, RasterizedTile& tile)
+        {
+            tile.mColumns.clear();
+            tile.mSpans.clear();
+            tile.mColumns.reserve(cached.mColumns.size());
+            tile.mSpans.reserve(cached.mSpans.size());
+            for (int z = 0; z < tile.mHeight; ++z)
+            {
+                for (int x = 0; x < tile.mWidth; ++x)
+                {
+                    const int i = x + z * tile.mWidth;
+                    tile.mColumns.push_back(static_cast<std::uint32_t>(tile.mSpans.size()));
+                    if (cells.contains(x, z))
+                    {
+                        for (const rcSpan* span = changed.spans[i]; span != nullptr; span = span->next)
+                            tile.mSpans.push_back(HeightfieldSpan{ .mMin = static_cast<unsigned short>(span->smin),
+                                .mMax = static_cast<unsigned short>(span->smax),
+                                .mArea = static_cast<unsigned char>(span->area) });
+                    }
+                    else
+                    {
+                        tile.mSpans.insert(tile.mSpans.end(), cached.mSpans.begin() + cached.mColumns[i],
+                            cached.mSpans.begin() + cached.mColumns[i + 1]);
+                    }
+                }
+            }
+            tile.mColumns.push_back(static_cast<std::uint32_t>(tile.mSpans.size()));
+        }
+
+        // Spans in a column don't overlap or touch so adding them in order never merges them
+        [[nodiscard]] bool writeSpans(RecastContext& context, const RasterizedTile& tile, rcHeightfield& solid)
+        {
+            for (int z = 0; z < tile.mHeight; ++z)
+            {
+                for (int x = 0; x < tile.mWidth; ++x)
+                {
+                    const std::size_t i = static_cast<std::size_t>(x + z * tile.mWidth);
+                    for (std::size_t j = tile.mColumns[i]; j < tile.mColumns[i + 1]; ++j)
+                    {
+                        const HeightfieldSpan& span = tile.mSpans[j];
+                        if (!rcAddSpan(&context, solid, x, z, span.mMin, span.mMax, span.mArea,
+                                tile.mFlagMergeThreshold))
+                            return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Rasterizes only triangles affecting cells where cached tile triangles differ from the new ones. Produces
+        // exactly the same heightfield as full rasterization because each column depends only on the triangles
+        // overlapping it and the order they are rasterized in.
+        [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const AgentBounds& agentBounds,
+            const TilePosition& tilePosition, HeightfieldsCache& cache, RasterizedTile&& tile, rcHeightfield& solid)
+        {
+            std::copy_n(solid.bmin, 3, tile.mMin.begin());
+            std::copy_n(solid.bmax, 3, tile.mMax.begin());
+            tile.mCellSize = solid.cs;
+            tile.mCellHeight = solid.ch;
+            tile.mWidth = solid.width;
+            tile.mHeight = solid.height;
+
+            const std::shared_ptr<const RasterizedTile> cached = cache.get(agentBounds, tilePosition);
+
+            TrianglesDiff diff{ .mSameOrder = false, .mChangedCells = std::nullopt };
+            if (cached != nullptr && hasSameHeightfield(*cached, tile))
+                diff = getTrianglesDiff(*cached, tile);
+
+            if (!diff.mSameOrder)
+            {
+                if (!rcRasterizeTriangles(&context, tile.mTriangles.mVertices.data(), tile.mTriangles.mAreas.data(),
+                        static_cast<int>(tile.mTriangles.mAreas.size()), solid, tile.mFlagMergeThreshold))
+                    return false;
+                readSpans(solid, tile);
+            }
+            else
+            {
+                if (const std::optional<CellsRange>& changedCells = diff.mChangedCells)
+                {
+                    RasterizationTriangles triangles;
+                    for (std::size_t i = 0, n = tile.mTriangles.mAreas.size(); i < n; ++i)
+                    {
+                        const float* const vertices = tile.mTriangles.mVertices.data() + i * 9;
+                        if (!getTriangleCells(tile, vertices).intersects(*changedCells))
+                            continue;
+                        triangles.mVertices.insert(triangles.mVertices.end(), vertices, vertices + 9);
+                        triangles.mAreas.push_back(tile.mTriangles.mAreas[i]);
+                    }
+
+                    rcHeightfield changed;
+                    if (!rcCreateHeightfield(&context, changed, solid.width, solid.height, solid.bmin, solid.bmax,
+                            solid.cs, solid.ch))
+                        return false;
+
+                    if (!rcRasterizeTriangles(&context, triangles.mVertices.data(), triangles.mAreas.data(),
+                            static_cast<int>(triangles.mAreas.size()), changed, tile.mFlagMergeThreshold))
+                        return false;
+
+                    mergeSpans(*cached, changed, *changedCells, tile);
+                }
+                else
+                {
+                    tile.mColumns = cached->mColumns;
+                    tile.mSpans = cached->mSpans;
+                }
+
+                if (!writeSpans(context, tile, solid))
+                    return false;
+            }
+
+            cache.set(agentBounds, tilePosition, std::make_shared<const RasterizedTile>(std::move(tile)));
+
+            return true;
         }
 
         bool isValidWalkableHeight(int value)
@@ -521,7 +836,8 @@ namespace DetourNavigator
     }
 
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
-        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings)
+        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings,
+        HeightfieldsCache* heightfieldsCache)
     {
         RecastContext context(worldspace, tilePosition, agentBounds, recastMesh.getVersion(), settings.mMaxLogLevel);
 
@@ -534,8 +850,19 @@ namespace DetourNavigator
 
         const RecastParams params = makeRecastParams(settings, agentBounds);
 
-        if (!rasterizeTriangles(
-                context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh, settings, params, solid))
+        RasterizedTile tile;
+        tile.mFlagMergeThreshold = params.mWalkableClimb;
+
+        if (!collectTriangles(
+                context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh, settings, tile.mTriangles))
+            return nullptr;
+
+        if (heightfieldsCache == nullptr)
+        {
+            if (!rasterizeTriangles(context, tile.mTriangles, params, solid))
+                return nullptr;
+        }
+        else if (!rasterizeTriangles(context, agentBounds, tilePosition, *heightfieldsCache, std::move(tile), solid))
             return nullptr;
 
         rcFilterLowHangingWalkableObstacles(&context, params.mWalkableClimb, solid);
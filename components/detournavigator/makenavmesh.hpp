@@ -20,6 +20,7 @@ namespace DetourNavigator
     struct OffMeshConnection;
     struct AgentBounds;
     struct RecastSettings;
+    class HeightfieldsCache;
 
     inline float getLength(const osg::Vec2i& value)
     {
@@ -44,7 +45,9 @@ namespace DetourNavigator
     }
 
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
-        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings);
+        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings,
+        HeightfieldsCache* heightfieldsCache = nullptr);
+    ///< Rasterizes only the changed part of the tile heightfield if it's present in \a heightfieldsCache.
 
     NavMeshData makeNavMeshTileData(const PreparedNavMeshData& data,
         const std::vector<OffMeshConnection>& offMeshConnections, const AgentBounds& agentBounds,
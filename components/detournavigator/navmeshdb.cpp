@@ -6,12 +6,19 @@
 #include <components/sqlite3/db.hpp>
 #include <components/sqlite3/request.hpp>
 
+#include <extern/smhasher/MurmurHash3.h>
+
 #include <DetourAlloc.h>
 
 #include <sqlite3.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <iterator>
+#include <limits>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 namespace DetourNavigator
@@ -29,12 +36,10 @@ namespace DetourNavigator
                 tile_position_y INTEGER NOT NULL,
                 version INTEGER NOT NULL,
                 input BLOB,
-                data BLOB
+                data BLOB,
+                input_hash BLOB
             );
 
-            CREATE UNIQUE INDEX IF NOT EXISTS index_unique_tiles_by_worldspace_and_tile_position_and_input
-                ON tiles (worldspace, tile_position_x, tile_position_y, input);
-
             CREATE INDEX IF NOT EXISTS index_tiles_by_worldspace_and_tile_position
                 ON tiles (worldspace, tile_position_x, tile_position_y);
 
@@ -51,31 +56,45 @@ namespace DetourNavigator
             COMMIT;
         )";
 
+        // Stored as user_version, 0 is for databases without tiles input_hash column
+        constexpr int schemaVersion = 1;
+
+        constexpr const char migrateToVersion1[] = R"(
+            DROP INDEX IF EXISTS index_unique_tiles_by_worldspace_and_tile_position_and_input;
+
+            CREATE UNIQUE INDEX IF NOT EXISTS index_unique_tiles_by_worldspace_and_tile_position_and_input_hash
+                ON tiles (worldspace, tile_position_x, tile_position_y, input_hash);
+
+            PRAGMA user_version = 1;
+        )";
+
         constexpr std::string_view getMaxTileIdQuery = R"(
             SELECT max(tile_id) FROM tiles
         )";
 
         constexpr std::string_view findTileQuery = R"(
-            SELECT tile_id, version
+            SELECT tile_id, version, input
               FROM tiles
              WHERE worldspace = :worldspace
                AND tile_position_x = :tile_position_x
                AND tile_position_y = :tile_position_y
-               AND input = :input
+               AND input_hash = :input_hash
         )";
 
         constexpr std::string_view getTileDataQuery = R"(
-            SELECT tile_id, version, data
+            SELECT tile_id, version, input, data
               FROM tiles
              WHERE worldspace = :worldspace
                AND tile_position_x = :tile_position_x
                AND tile_position_y = :tile_position_y
-               AND input = :input
+               AND input_hash = :input_hash
         )";
 
         constexpr std::string_view insertTileQuery = R"(
-            INSERT INTO tiles ( tile_id,  worldspace,  version,  tile_position_x,  tile_position_y,  input,  data)
-                   VALUES     (:tile_id, :worldspace, :version, :tile_position_x, :tile_position_y, :input, :data)
+            INSERT INTO tiles ( tile_id,  worldspace,  version,  tile_position_x,  tile_position_y,  input,  input_hash,
+                                data)
+                   VALUES     (:tile_id, :worldspace, :version, :tile_position_x, :tile_position_y, :input, :input_hash,
+                               :data)
         )";
 
         constexpr std::string_view updateTileQuery = R"(
@@ -152,6 +171,123 @@ namespace DetourNavigator
             if (const int ec = sqlite3_exec(&db, query.c_str(), nullptr, nullptr, nullptr); ec != SQLITE_OK)
                 throw std::runtime_error("Failed set max page count: " + std::string(sqlite3_errmsg(&db)));
         }
+
+        using InputHash = std::array<std::uint64_t, 2>;
+
+        InputHash getInputHash(const std::vector<std::byte>& input)
+        {
+            const InputHash seed{ 0, 0 };
+            InputHash result;
+            MurmurHash3_x64_128(input.data(), static_cast<int>(input.size()), seed.data(), result.data());
+            return result;
+        }
+
+        Sqlite3::ConstBlob toBlob(const InputHash& value)
+        {
+            return Sqlite3::ConstBlob{ reinterpret_cast<const char*>(value.data()), static_cast<int>(sizeof(value)) };
+        }
+
+        struct GetUserVersion
+        {
+            static std::string_view text() noexcept { return "pragma user_version;"; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct GetTilesColumns
+        {
+            static std::string_view text() noexcept { return "SELECT name FROM pragma_table_info('tiles');"; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct GetTilesInputs
+        {
+            static std::string_view text() noexcept
+            {
+                return "SELECT tile_id, input FROM tiles WHERE tile_id > :tile_id ORDER BY tile_id LIMIT 1000;";
+            }
+
+            static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId)
+            {
+                Sqlite3::bindParameter(db, statement, ":tile_id", tileId);
+            }
+        };
+
+        struct SetTileInputHash
+        {
+            static std::string_view text() noexcept
+            {
+                return "UPDATE tiles SET input_hash = :input_hash WHERE tile_id = :tile_id;";
+            }
+
+            static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, const Sqlite3::ConstBlob& inputHash)
+            {
+                Sqlite3::bindParameter(db, statement, ":tile_id", tileId);
+                Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
+            }
+        };
+
+        void executeQuery(sqlite3& db, const char* query)
+        {
+            if (const int ec = sqlite3_exec(&db, query, nullptr, nullptr, nullptr); ec != SQLITE_OK)
+                throw std::runtime_error("Failed to migrate navmesh database: " + std::string(sqlite3_errmsg(&db)));
+        }
+
+        void fillInputHashes(sqlite3& db)
+        {
+            Sqlite3::Statement<GetTilesInputs> getTilesInputs(db);
+            Sqlite3::Statement<SetTileInputHash> setTileInputHash(db);
+            std::vector<std::tuple<TileId, std::vector<std::byte>>> rows;
+            TileId lastTileId{ std::numeric_limits<std::int64_t>::min() };
+            std::size_t count = 0;
+            // Read by batches to not load the whole database into memory
+            do
+            {
+                rows.clear();
+                request(db, getTilesInputs, std::back_inserter(rows), std::numeric_limits<std::size_t>::max(),
+                    lastTileId);
+                for (const auto& [tileId, input] : rows)
+                {
+                    const InputHash inputHash = getInputHash(Misc::decompress(input));
+                    execute(db, setTileInputHash, tileId, toBlob(inputHash));
+                }
+                if (!rows.empty())
+                    lastTileId = std::get<0>(rows.back());
+                count += rows.size();
+            } while (!rows.empty());
+            Log(Debug::Info) << "Computed input hash for " << count << " navmesh tiles";
+        }
+
+        void migrate(sqlite3& db)
+        {
+            Sqlite3::Statement<GetUserVersion> getUserVersion(db);
+            int version = 0;
+            request(db, getUserVersion, &version, 1);
+            if (version >= schemaVersion)
+                return;
+
+            Sqlite3::Transaction transaction(db);
+
+            Sqlite3::Statement<GetTilesColumns> getTilesColumns(db);
+            std::vector<std::string> columns;
+            request(db, getTilesColumns, std::back_inserter(columns), std::numeric_limits<std::size_t>::max());
+            if (std::find(columns.begin(), columns.end(), "input_hash") == columns.end())
+            {
+                Log(Debug::Info) << "Migrating navmesh database to schema version " << schemaVersion;
+                executeQuery(db, "ALTER TABLE tiles ADD COLUMN input_hash BLOB;");
+                fillInputHashes(db);
+            }
+
+            executeQuery(db, migrateToVersion1);
+
+            transaction.commit();
+        }
+
+        Sqlite3::Db makeNavMeshDb(std::string_view path)
+        {
+            Sqlite3::Db db = Sqlite3::makeDb(path, schema);
+            migrate(*db);
+            return db;
+        }
     }
 
     std::ostream& operator<<(std::ostream& stream, ShapeType value)
@@ -167,7 +303,7 @@ namespace DetourNavigator
     }
 
     NavMeshDb::NavMeshDb(std::string_view path, std::uint64_t maxFileSize)
-        : mDb(Sqlite3::makeDb(path, schema))
+        : mDb(makeNavMeshDb(path))
         , mGetMaxTileId(*mDb, DbQueries::GetMaxTileId{})
         , mFindTile(*mDb, DbQueries::FindTile{})
         , mGetTileData(*mDb, DbQueries::GetTileData{})
@@ -203,9 +339,12 @@ namespace DetourNavigator
         ESM::RefId worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input)
     {
         Tile result;
-        auto row = std::tie(result.mTileId, result.mVersion);
-        const std::vector<std::byte> compressedInput = Misc::compress(input);
-        if (&row == request(*mDb, mFindTile, &row, 1, worldspace.serializeText(), tilePosition, compressedInput))
+        std::vector<std::byte> storedInput;
+        auto row = std::tie(result.mTileId, result.mVersion, storedInput);
+        const InputHash inputHash = getInputHash(input);
+        if (&row == request(*mDb, mFindTile, &row, 1, worldspace.serializeText(), tilePosition, toBlob(inputHash)))
+            return {};
+        if (Misc::decompress(storedInput) != input)
             return {};
         return result;
     }
@@ -214,9 +353,12 @@ namespace DetourNavigator
         ESM::RefId worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input)
     {
         TileData result;
-        auto row = std::tie(result.mTileId, result.mVersion, result.mData);
-        const std::vector<std::byte> compressedInput = Misc::compress(input);
-        if (&row == request(*mDb, mGetTileData, &row, 1, worldspace.serializeText(), tilePosition, compressedInput))
+        std::vector<std::byte> storedInput;
+        auto row = std::tie(result.mTileId, result.mVersion, storedInput, result.mData);
+        const InputHash inputHash = getInputHash(input);
+        if (&row == request(*mDb, mGetTileData, &row, 1, worldspace.serializeText(), tilePosition, toBlob(inputHash)))
+            return {};
+        if (Misc::decompress(storedInput) != input)
             return {};
         result.mData = Misc::decompress(result.mData);
         return result;
@@ -225,10 +367,11 @@ namespace DetourNavigator
     int NavMeshDb::insertTile(TileId tileId, ESM::RefId worldspace, const TilePosition& tilePosition,
         TileVersion version, const std::vector<std::byte>& input, const std::vector<std::byte>& data)
     {
+        const InputHash inputHash = getInputHash(input);
         const std::vector<std::byte> compressedInput = Misc::compress(input);
         const std::vector<std::byte> compressedData = Misc::compress(data);
         return execute(*mDb, mInsertTile, tileId, worldspace.serializeText(), tilePosition, version, compressedInput,
-            compressedData);
+            toBlob(inputHash), compressedData);
     }
 
     int NavMeshDb::updateTile(TileId tileId, TileVersion version, const std::vector<std::byte>& data)
@@ -290,12 +433,12 @@ namespace DetourNavigator
         }
 
         void FindTile::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-            const TilePosition& tilePosition, const std::vector<std::byte>& input)
+            const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash)
         {
             Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
             Sqlite3::bindParameter(db, statement, ":tile_position_x", tilePosition.x());
             Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
-            Sqlite3::bindParameter(db, statement, ":input", input);
+            Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
         }
 
         std::string_view GetTileData::text() noexcept
@@ -304,12 +447,12 @@ namespace DetourNavigator
         }
 
         void GetTileData::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-            const TilePosition& tilePosition, const std::vector<std::byte>& input)
+            const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash)
         {
             Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
             Sqlite3::bindParameter(db, statement, ":tile_position_x", tilePosition.x());
             Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
-            Sqlite3::bindParameter(db, statement, ":input", input);
+            Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
         }
 
         std::string_view InsertTile::text() noexcept
@@ -319,7 +462,7 @@ namespace DetourNavigator
 
         void InsertTile::bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, std::string_view worldspace,
             const TilePosition& tilePosition, TileVersion version, const std::vector<std::byte>& input,
-            const std::vector<std::byte>& data)
+            const Sqlite3::ConstBlob& inputHash, const std::vector<std::byte>& data)
         {
             Sqlite3::bindParameter(db, statement, ":tile_id", tileId);
             Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
@@ -327,6 +470,7 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
             Sqlite3::bindParameter(db, statement, ":version", version);
             Sqlite3::bindParameter(db, statement, ":input", input);
+            Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
             Sqlite3::bindParameter(db, statement, ":data", data);
         }
 
@@ -60,14 +60,14 @@ namespace DetourNavigator
         {
             static std::string_view text() noexcept;
             static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-                const TilePosition& tilePosition, const std::vector<std::byte>& input);
+                const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash);
         };
 
         struct GetTileData
         {
             static std::string_view text() noexcept;
             static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-                const TilePosition& tilePosition, const std::vector<std::byte>& input);
+                const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash);
         };
 
         struct InsertTile
@@ -75,7 +75,7 @@ namespace DetourNavigator
             static std::string_view text() noexcept;
             static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, std::string_view worldspace,
                 const TilePosition& tilePosition, TileVersion version, const std::vector<std::byte>& input,
-                const std::vector<std::byte>& data);
+                const Sqlite3::ConstBlob& inputHash, const std::vector<std::byte>& data);
         };
 
         struct UpdateTile
@@ -133,6 +133,8 @@ namespace DetourNavigator
         };
     }
 
+    /// Tiles are looked up by the hash of the uncompressed input, stored input is compared only for the found tile.
+    /// Databases created by older versions are migrated on opening.
     class NavMeshDb
     {
     public:
@@ -17,6 +17,7 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <limits>
 #include <sstream>
 #include <vector>
 
@@ -48,6 +49,113 @@ namespace DetourNavigator
                     return true;
             return false;
         }
+
+        // Triangles are stored by coordinate to make transformation and culling loops vectorizable
+        class TrianglesBatch
+        {
+        public:
+            static constexpr std::size_t sCapacity = 256;
+
+            bool isFull() const { return mSize == sCapacity; }
+
+            bool isEmpty() const { return mSize == 0; }
+
+            void add(const btVector3* vertices)
+            {
+                for (std::size_t i = 0; i < 3; ++i)
+                    for (std::size_t j = 0; j < 3; ++j)
+                        mCoordinates[i * 3 + j][mSize] = vertices[i][j];
+                mInside[mSize] = 1;
+                ++mSize;
+            }
+
+            void transform(const btTransform& transform)
+            {
+                const btMatrix3x3& basis = transform.getBasis();
+                const btScalar m00 = basis[0].x(), m01 = basis[0].y(), m02 = basis[0].z();
+                const btScalar m10 = basis[1].x(), m11 = basis[1].y(), m12 = basis[1].z();
+                const btScalar m20 = basis[2].x(), m21 = basis[2].y(), m22 = basis[2].z();
+                const btScalar ox = transform.getOrigin().x();
+                const btScalar oy = transform.getOrigin().y();
+                const btScalar oz = transform.getOrigin().z();
+                const std::size_t size = mSize;
+
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    btScalar* const x = mCoordinates[i * 3].data();
+                    btScalar* const y = mCoordinates[i * 3 + 1].data();
+                    btScalar* const z = mCoordinates[i * 3 + 2].data();
+                    for (std::size_t n = 0; n < size; ++n)
+                    {
+                        const btScalar vx = x[n];
+                        const btScalar vy = y[n];
+                        const btScalar vz = z[n];
+                        x[n] = vx * m00 + vy * m01 + vz * m02 + ox;
+                        y[n] = vx * m10 + vy * m11 + vz * m12 + oy;
+                        z[n] = vx * m20 + vy * m21 + vz * m22 + oz;
+                    }
+                }
+            }
+
+            // Same test as TestTriangleAgainstAabb2 does for a single triangle
+            void cull(const btVector3& aabbMin, const btVector3& aabbMax)
+            {
+                const std::size_t size = mSize;
+
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    const btScalar minValue = aabbMin[axis];
+                    const btScalar maxValue = aabbMax[axis];
+                    const btScalar* const v0 = mCoordinates[axis].data();
+                    const btScalar* const v1 = mCoordinates[3 + axis].data();
+                    const btScalar* const v2 = mCoordinates[6 + axis].data();
+                    for (std::size_t n = 0; n < size; ++n)
+                    {
+                        const btScalar lower = std::min(std::min(v0[n], v1[n]), v2[n]);
+                        const btScalar upper = std::max(std::max(v0[n], v1[n]), v2[n]);
+                        mInside[n] &= static_cast<unsigned char>(!(lower > maxValue) & !(upper < minValue));
+                    }
+                }
+            }
+
+            void flush(AreaType areaType, bool reverse, std::vector<RecastMeshTriangle>& triangles)
+            {
+                for (std::size_t n = 0; n < mSize; ++n)
+                {
+                    if (mInside[n] == 0)
+                        continue;
+                    RecastMeshTriangle& triangle = triangles.emplace_back();
+                    triangle.mAreaType = areaType;
+                    for (std::size_t i = 0; i < 3; ++i)
+                    {
+                        const std::size_t vertex = reverse ? 2 - i : i;
+                        triangle.mVertices[i] = osg::Vec3f(mCoordinates[vertex * 3][n],
+                            mCoordinates[vertex * 3 + 1][n], mCoordinates[vertex * 3 + 2][n]);
+                    }
+                }
+                mSize = 0;
+            }
+
+        private:
+            std::array<std::array<btScalar, sCapacity>, 9> mCoordinates;
+            std::array<unsigned char, sCapacity> mInside;
+            std::size_t mSize = 0;
+        };
+
+        template <class Function>
+        void processTriangles(
+            const btConcaveShape& shape, const btVector3& aabbMin, const btVector3& aabbMax, Function&& function)
+        {
+            TrianglesBatch batch;
+            auto callback = makeProcessTriangleCallback([&](btVector3* vertices, int, int) {
+                batch.add(vertices);
+                if (batch.isFull())
+                    function(batch);
+            });
+            shape.processAllTriangles(&callback, aabbMin, aabbMax);
+            if (!batch.isEmpty())
+                function(batch);
+        }
     }
 
     Mesh makeMesh(std::vector<RecastMeshTriangle>&& triangles, const osg::Vec3f& shift)
@@ -97,39 +205,70 @@ namespace DetourNavigator
 
     Mesh makeMesh(const Heightfield& heightfield)
     {
-        using BulletHelpers::makeProcessTriangleCallback;
-        using Misc::Convert::toOsg;
-
-        constexpr int upAxis = 2;
-        constexpr bool flipQuadEdges = false;
-#if BT_BULLET_VERSION < 310
-        std::vector<btScalar> heights(heightfield.mHeights.begin(), heightfield.mHeights.end());
-        btHeightfieldTerrainShape shape(static_cast<int>(heightfield.mHeights.size() / heightfield.mLength),
-            static_cast<int>(heightfield.mLength), heights.data(), 1, heightfield.mMinHeight, heightfield.mMaxHeight,
-            upAxis, PHY_FLOAT, flipQuadEdges);
-#else
-        btHeightfieldTerrainShape shape(static_cast<int>(heightfield.mHeights.size() / heightfield.mLength),
-            static_cast<int>(heightfield.mLength), heightfield.mHeights.data(), heightfield.mMinHeight,
-            heightfield.mMaxHeight, upAxis, flipQuadEdges);
-#endif
+        // Produces the same mesh as makeMesh for triangles of btHeightfieldTerrainShape without going through Bullet
+        // callbacks and sorting vertices. Intermediate values use btScalar to give exactly the same coordinates.
+        const std::size_t length = heightfield.mLength;
+        const std::size_t width = length == 0 ? 0 : heightfield.mHeights.size() / length;
+        if (width < 2 || length < 2)
+            return Mesh({}, {}, {});
+
         const float scale = getHeightfieldScale(heightfield.mCellSize, heightfield.mOriginalSize);
-        shape.setLocalScaling(btVector3(scale, scale, 1));
-        btVector3 aabbMin;
-        btVector3 aabbMax;
-        shape.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
-        std::vector<RecastMeshTriangle> triangles;
-        auto callback = makeProcessTriangleCallback([&](btVector3* vertices, int, int) {
-            triangles.emplace_back(makeRecastMeshTriangle(vertices, AreaType_ground));
-        });
-        shape.processAllTriangles(&callback, aabbMin, aabbMax);
-        const osg::Vec2f aabbShift
-            = (osg::Vec2f(aabbMax.x(), aabbMax.y()) - osg::Vec2f(aabbMin.x(), aabbMin.y())) * 0.5;
+        const btScalar scaledHalfWidth = static_cast<btScalar>(width - 1) * scale * btScalar(0.5);
+        const btScalar scaledHalfLength = static_cast<btScalar>(length - 1) * scale * btScalar(0.5);
+        const btScalar localOriginZ
+            = btScalar(0.5) * (static_cast<btScalar>(heightfield.mMinHeight) + heightfield.mMaxHeight);
+        const osg::Vec2f aabbShift(static_cast<float>(scaledHalfWidth), static_cast<float>(scaledHalfLength));
         const osg::Vec2f tileShift = osg::Vec2f(heightfield.mMinX, heightfield.mMinY) * scale;
         const osg::Vec2f localShift = aabbShift + tileShift;
         const float cellSize = static_cast<float>(heightfield.mCellSize);
-        const osg::Vec3f cellShift(heightfield.mCellPosition.x() * cellSize, heightfield.mCellPosition.y() * cellSize,
-            (heightfield.mMinHeight + heightfield.mMaxHeight) * 0.5f);
-        return makeMesh(std::move(triangles), cellShift + osg::Vec3f(localShift.x(), localShift.y(), 0));
+        const osg::Vec3f shift = osg::Vec3f(heightfield.mCellPosition.x() * cellSize,
+                                     heightfield.mCellPosition.y() * cellSize,
+                                     (heightfield.mMinHeight + heightfield.mMaxHeight) * 0.5f)
+            + osg::Vec3f(localShift.x(), localShift.y(), 0);
+
+        std::vector<float> xs(width);
+        for (std::size_t x = 0; x < width; ++x)
+            xs[x] = static_cast<float>((-static_cast<btScalar>(width - 1) / 2 + x) * scale) + shift.x();
+
+        std::vector<float> ys(length);
+        for (std::size_t y = 0; y < length; ++y)
+            ys[y] = static_cast<float>((-static_cast<btScalar>(length - 1) / 2 + y) * scale) + shift.y();
+
+        // Vertices are ordered by x and then by y like sorted unique vertices are
+        std::vector<float> vertices(3 * width * length);
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            float* const column = vertices.data() + 3 * x * length;
+            for (std::size_t y = 0; y < length; ++y)
+            {
+                column[3 * y] = xs[x];
+                column[3 * y + 1] = ys[y];
+                column[3 * y + 2]
+                    = static_cast<float>(heightfield.mHeights[x + y * width] - localOriginZ) + shift.z();
+            }
+        }
+
+        const auto index = [&](std::size_t x, std::size_t y) { return static_cast<int>(x * length + y); };
+
+        // Same triangles in the same order as btHeightfieldTerrainShape::processAllTriangles gives
+        std::vector<int> indices;
+        indices.reserve(6 * (width - 1) * (length - 1));
+        for (std::size_t y = 0; y + 1 < length; ++y)
+        {
+            for (std::size_t x = 0; x + 1 < width; ++x)
+            {
+                indices.push_back(index(x, y));
+                indices.push_back(index(x, y + 1));
+                indices.push_back(index(x + 1, y + 1));
+                indices.push_back(index(x, y));
+                indices.push_back(index(x + 1, y + 1));
+                indices.push_back(index(x + 1, y));
+            }
+        }
+
+        std::vector<AreaType> areaTypes(indices.size() / 3, AreaType_ground);
+
+        return Mesh(std::move(indices), std::move(vertices), std::move(areaTypes));
     }
 
     RecastMeshBuilder::RecastMeshBuilder(const TileBounds& bounds) noexcept
@@ -171,19 +310,51 @@ namespace DetourNavigator
     void RecastMeshBuilder::addObject(
         const btConcaveShape& shape, const btTransform& transform, const AreaType areaType)
     {
-        return addObject(shape, transform, makeProcessTriangleCallback([&](btVector3* vertices, int, int) {
-            RecastMeshTriangle triangle = makeRecastMeshTriangle(vertices, areaType);
-            std::reverse(triangle.mVertices.begin(), triangle.mVertices.end());
-            mTriangles.emplace_back(triangle);
-        }));
+        btVector3 aabbMin;
+        btVector3 aabbMax;
+
+        shape.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
+
+        const btVector3 boundsMin(mBounds.mMin.x(), mBounds.mMin.y(),
+            -std::numeric_limits<btScalar>::max() * std::numeric_limits<btScalar>::epsilon());
+        const btVector3 boundsMax(mBounds.mMax.x(), mBounds.mMax.y(),
+            std::numeric_limits<btScalar>::max() * std::numeric_limits<btScalar>::epsilon());
+
+        processTriangles(shape, aabbMin, aabbMax, [&](TrianglesBatch& batch) {
+            batch.transform(transform);
+            batch.cull(boundsMin, boundsMax);
+            batch.flush(areaType, true, mTriangles);
+        });
     }
 
     void RecastMeshBuilder::addObject(
         const btHeightfieldTerrainShape& shape, const btTransform& transform, const AreaType areaType)
     {
-        addObject(shape, transform, makeProcessTriangleCallback([&](btVector3* vertices, int, int) {
-            mTriangles.emplace_back(makeRecastMeshTriangle(vertices, areaType));
-        }));
+        using BulletHelpers::transformBoundingBox;
+
+        btVector3 aabbMin;
+        btVector3 aabbMax;
+
+        shape.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
+
+        transformBoundingBox(transform, aabbMin, aabbMax);
+
+        aabbMin.setX(std::max(static_cast<btScalar>(mBounds.mMin.x()), aabbMin.x()));
+        aabbMin.setX(std::min(static_cast<btScalar>(mBounds.mMax.x()), aabbMin.x()));
+        aabbMin.setY(std::max(static_cast<btScalar>(mBounds.mMin.y()), aabbMin.y()));
+        aabbMin.setY(std::min(static_cast<btScalar>(mBounds.mMax.y()), aabbMin.y()));
+
+        aabbMax.setX(std::max(static_cast<btScalar>(mBounds.mMin.x()), aabbMax.x()));
+        aabbMax.setX(std::min(static_cast<btScalar>(mBounds.mMax.x()), aabbMax.x()));
+        aabbMax.setY(std::max(static_cast<btScalar>(mBounds.mMin.y()), aabbMax.y()));
+        aabbMax.setY(std::min(static_cast<btScalar>(mBounds.mMax.y()), aabbMax.y()));
+
+        transformBoundingBox(transform.inverse(), aabbMin, aabbMax);
+
+        processTriangles(shape, aabbMin, aabbMax, [&](TrianglesBatch& batch) {
+            batch.transform(transform);
+            batch.flush(areaType, false, mTriangles);
+        });
     }
 
     void RecastMeshBuilder::addObject(const btBoxShape& shape, const btTransform& transform, const AreaType areaType)
@@ -277,62 +448,4 @@ namespace DetourNavigator
         return std::make_shared<RecastMesh>(version, std::move(mesh), std::move(mWater), std::move(mHeightfields),
             std::move(mFlatHeightfields), std::move(mSources));
     }
-
-    void RecastMeshBuilder::addObject(
-        const btConcaveShape& shape, const btTransform& transform, btTriangleCallback&& callback)
-    {
-        btVector3 aabbMin;
-        btVector3 aabbMax;
-
-        shape.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
-
-        const btVector3 boundsMin(mBounds.mMin.x(), mBounds.mMin.y(),
-            -std::numeric_limits<btScalar>::max() * std::numeric_limits<btScalar>::epsilon());
-        const btVector3 boundsMax(mBounds.mMax.x(), mBounds.mMax.y(),
-            std::numeric_limits<btScalar>::max() * std::numeric_limits<btScalar>::epsilon());
-
-        auto wrapper = makeProcessTriangleCallback([&](btVector3* triangle, int partId, int triangleIndex) {
-            std::array<btVector3, 3> transformed;
-            for (std::size_t i = 0; i < 3; ++i)
-                transformed[i] = transform(triangle[i]);
-            if (TestTriangleAgainstAabb2(transformed.data(), boundsMin, boundsMax))
-                callback.processTriangle(transformed.data(), partId, triangleIndex);
-        });
-
-        shape.processAllTriangles(&wrapper, aabbMin, aabbMax);
-    }
-
-    void RecastMeshBuilder::addObject(
-        const btHeightfieldTerrainShape& shape, const btTransform& transform, btTriangleCallback&& callback)
-    {
-        using BulletHelpers::transformBoundingBox;
-
-        btVector3 aabbMin;
-        btVector3 aabbMax;
-
-        shape.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
-
-        transformBoundingBox(transform, aabbMin, aabbMax);
-
-        aabbMin.setX(std::max(static_cast<btScalar>(mBounds.mMin.x()), aabbMin.x()));
-        aabbMin.setX(std::min(static_cast<btScalar>(mBounds.mMax.x()), aabbMin.x()));
-        aabbMin.setY(std::max(static_cast<btScalar>(mBounds.mMin.y()), aabbMin.y()));
-        aabbMin.setY(std::min(static_cast<btScalar>(mBounds.mMax.y()), aabbMin.y()));
-
-        aabbMax.setX(std::max(static_cast<btScalar>(mBounds.mMin.x()), aabbMax.x()));
-        aabbMax.setX(std::min(static_cast<btScalar>(mBounds.mMax.x()), aabbMax.x()));
-        aabbMax.setY(std::max(static_cast<btScalar>(mBounds.mMin.y()), aabbMax.y()));
-        aabbMax.setY(std::min(static_cast<btScalar>(mBounds.mMax.y()), aabbMax.y()));
-
-        transformBoundingBox(transform.inverse(), aabbMin, aabbMax);
-
-        auto wrapper = makeProcessTriangleCallback([&](btVector3* triangle, int partId, int triangleIndex) {
-            std::array<btVector3, 3> transformed;
-            for (std::size_t i = 0; i < 3; ++i)
-                transformed[i] = transform(triangle[i]);
-            callback.processTriangle(transformed.data(), partId, triangleIndex);
-        });
-
-        shape.processAllTriangles(&wrapper, aabbMin, aabbMax);
-    }
 }
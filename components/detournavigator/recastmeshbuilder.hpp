@@ -20,7 +20,6 @@ class btCollisionShape;
 class btCompoundShape;
 class btConcaveShape;
 class btHeightfieldTerrainShape;
-class btTriangleCallback;
 
 namespace DetourNavigator
 {
@@ -69,11 +68,6 @@ namespace DetourNavigator
         std::vector<MeshSource> mSources;
 
         inline void addObject(const btCollisionShape& shape, const btTransform& transform, const AreaType areaType);
-
-        void addObject(const btConcaveShape& shape, const btTransform& transform, btTriangleCallback&& callback);
-
-        void addObject(
-            const btHeightfieldTerrainShape& shape, const btTransform& transform, btTriangleCallback&& callback);
     };
 
     Mesh makeMesh(std::vector<RecastMeshTriangle>&& triangles, const osg::Vec3f& shift = osg::Vec3f());
@@ -96,6 +96,7 @@ namespace DetourNavigator
         result.mWaitUntilMinDistanceToPlayer = ::Settings::navigator().mWaitUntilMinDistanceToPlayer;
         result.mAsyncNavMeshUpdaterThreads = ::Settings::navigator().mAsyncNavMeshUpdaterThreads;
         result.mMaxNavMeshTilesCacheSize = ::Settings::navigator().mMaxNavMeshTilesCacheSize;
+        result.mMaxHeightfieldsCacheSize = ::Settings::navigator().mMaxHeightfieldsCacheSize;
         result.mEnableWriteRecastMeshToFile = ::Settings::navigator().mEnableWriteRecastMeshToFile;
         result.mEnableWriteNavMeshToFile = ::Settings::navigator().mEnableWriteNavMeshToFile;
         result.mRecastMeshPathPrefix = ::Settings::navigator().mRecastMeshPathPrefix;
@@ -106,6 +107,9 @@ namespace DetourNavigator
         result.mEnableNavMeshDiskCache = ::Settings::navigator().mEnableNavMeshDiskCache;
         result.mWriteToNavMeshDb = ::Settings::navigator().mWriteToNavmeshdb;
         result.mMaxDbFileSize = ::Settings::navigator().mMaxNavmeshdbFileSize;
+        result.mDbTransactionInterval
+            = std::chrono::milliseconds(::Settings::navigator().mNavmeshdbTransactionIntervalMs);
+        result.mMaxDbTransactionSize = static_cast<std::size_t>(::Settings::navigator().mMaxNavmeshdbTransactionSize);
 
         return result;
     }
@@ -50,10 +50,13 @@ namespace DetourNavigator
         int mMaxTilesNumber = 0;
         std::size_t mAsyncNavMeshUpdaterThreads = 0;
         std::size_t mMaxNavMeshTilesCacheSize = 0;
+        std::size_t mMaxHeightfieldsCacheSize = 0;
         std::string mRecastMeshPathPrefix;
         std::string mNavMeshPathPrefix;
         std::chrono::milliseconds mMinUpdateInterval;
         std::uint64_t mMaxDbFileSize = 0;
+        std::chrono::milliseconds mDbTransactionInterval{ 0 };
+        std::size_t mMaxDbTransactionSize = 1;
     };
 
     inline constexpr std::int64_t navMeshFormatVersion = 2;
@@ -24,6 +24,11 @@ namespace DetourNavigator
 
                 out.setAttribute(frameNumber, "NavMesh DbCache Get", static_cast<double>(stats.mDb->mGetTileCount));
                 out.setAttribute(frameNumber, "NavMesh DbCache Hit", static_cast<double>(stats.mDbGetTileHits));
+
+                out.setAttribute(frameNumber, "NavMesh DbWrite Count", static_cast<double>(stats.mDb->mWriteCount));
+                out.setAttribute(frameNumber, "NavMesh DbWrite Commit", static_cast<double>(stats.mDb->mCommitCount));
+                out.setAttribute(
+                    frameNumber, "NavMesh DbWrite Pending", static_cast<double>(stats.mDb->mPendingWriteCount));
             }
 
             out.setAttribute(frameNumber, "NavMesh CacheSize", static_cast<double>(stats.mCache.mNavMeshCacheSize));
@@ -31,6 +36,14 @@ namespace DetourNavigator
             out.setAttribute(frameNumber, "NavMesh CachedTiles", static_cast<double>(stats.mCache.mCachedNavMeshTiles));
             out.setAttribute(frameNumber, "NavMesh Cache Get", static_cast<double>(stats.mCache.mGetCount));
             out.setAttribute(frameNumber, "NavMesh Cache Hit", static_cast<double>(stats.mCache.mHitCount));
+
+            if (stats.mHeightfields.has_value())
+            {
+                out.setAttribute(
+                    frameNumber, "NavMesh Heightfields Tiles", static_cast<double>(stats.mHeightfields->mTiles));
+                out.setAttribute(
+                    frameNumber, "NavMesh Heightfields Hit", static_cast<double>(stats.mHeightfields->mHitCount));
+            }
         }
 
         void reportStats(const TileCachedRecastMeshManagerStats& stats, unsigned int frameNumber, osg::Stats& out)
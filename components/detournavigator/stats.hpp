@@ -28,6 +28,9 @@ namespace DetourNavigator
     {
         DbJobQueueStats mJobs;
         std::size_t mGetTileCount = 0;
+        std::size_t mWriteCount = 0;
+        std::size_t mCommitCount = 0;
+        std::size_t mPendingWriteCount = 0;
     };
 
     struct NavMeshTilesCacheStats
@@ -39,6 +42,14 @@ namespace DetourNavigator
         std::size_t mGetCount = 0;
     };
 
+    struct HeightfieldsCacheStats
+    {
+        std::size_t mSize = 0;
+        std::size_t mTiles = 0;
+        std::size_t mGetCount = 0;
+        std::size_t mHitCount = 0;
+    };
+
     struct AsyncNavMeshUpdaterStats
     {
         std::size_t mJobs = 0;
@@ -48,6 +59,7 @@ namespace DetourNavigator
         std::size_t mDbGetTileHits = 0;
         std::optional<DbWorkerStats> mDb;
         NavMeshTilesCacheStats mCache;
+        std::optional<HeightfieldsCacheStats> mHeightfields;
     };
 
     struct TileCachedRecastMeshManagerStats
@@ -0,0 +1,42 @@
+#include "memorymappedfile.hpp"
+#include "conversion.hpp"
+
+#include <components/platform/file.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Files
+{
+    MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& path)
+    {
+        const Platform::File::ScopedHandle handle = Platform::File::open(path);
+        mSize = Platform::File::size(handle);
+        if (mSize == 0)
+            return;
+        mData = static_cast<const char*>(Platform::File::map(handle, mSize));
+        if (mData == nullptr)
+            throw std::runtime_error(
+                "Memory mapping is not supported, failed to map '" + Files::pathToUnicodeString(path) + "'");
+    }
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        if (mData != nullptr)
+            Platform::File::unmap(mData, mSize);
+    }
+
+    std::span<const char> MemoryMappedFile::getRegion(std::size_t offset, std::size_t size) const
+    {
+        if (offset > mSize || size > mSize - offset)
+            return {};
+        return { mData + offset, size };
+    }
+
+    void MemoryMappedFile::prefetch(std::size_t offset, std::size_t size) const
+    {
+        if (offset >= mSize)
+            return;
+        Platform::File::prefetchMapped(mData + offset, std::min(size, mSize - offset));
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef OPENMW_COMPONENTS_FILES_MEMORYMAPPEDFILE_H
+#define OPENMW_COMPONENTS_FILES_MEMORYMAPPEDFILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace Files
+{
+    /// @brief Read-only view of the whole file content mapped into the process address space.
+    /// @note The mapping is immutable, so it is safe to read from multiple threads.
+    class MemoryMappedFile
+    {
+    public:
+        /// @note Throws an exception if the file can not be opened or mapped.
+        explicit MemoryMappedFile(const std::filesystem::path& path);
+
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+        ~MemoryMappedFile();
+
+        const char* data() const { return mData; }
+
+        std::size_t size() const { return mSize; }
+
+        /// Returns a view of the given region or an empty span if the region is not inside the file.
+        std::span<const char> getRegion(std::size_t offset, std::size_t size) const;
+
+        /// Hints the system to load the given region in background. The region is clamped to the file size.
+        void prefetch(std::size_t offset, std::size_t size) const;
+
+    private:
+        const char* mData = nullptr;
+        std::size_t mSize = 0;
+    };
+}
+
+#endif
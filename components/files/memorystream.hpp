@@ -2,6 +2,7 @@
 #define OPENMW_COMPONENTS_FILES_MEMORYSTREAM_H
 
 #include <istream>
+#include <span>
 
 namespace Files
 {
@@ -31,6 +32,9 @@ namespace Files
             return seekoff(pos, std::ios_base::beg, which);
         }
 
+        /// Returns the part of the buffer which is not read yet.
+        std::span<const char> getUnread() const { return { gptr(), static_cast<std::size_t>(egptr() - gptr()) }; }
+
     protected:
         char* bufferStart;
         char* bufferEnd;
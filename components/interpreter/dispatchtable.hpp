@@ -0,0 +1,59 @@
+#ifndef OPENMW_COMPONENTS_INTERPRETER_DISPATCHTABLE_H
+#define OPENMW_COMPONENTS_INTERPRETER_DISPATCHTABLE_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace Interpreter
+{
+    /// @brief Flat view over installed opcodes for the instruction dispatch.
+    /// @par Opcodes are not spread evenly over a segment, they are allocated sequentially from a few bases (0 for the
+    /// builtin instructions and 0x20000 or 0x2000000 for the extensions). Each such group is stored as an array
+    /// indexed by the opcode offset, so finding a handler takes a few comparisons instead of a tree lookup.
+    template <class T>
+    class DispatchTable
+    {
+    public:
+        /// Unused opcodes between two installed ones up to this number are stored as empty entries instead of
+        /// starting a new range.
+        static constexpr std::size_t sMaxGap = 256;
+
+        void build(const std::map<int, std::unique_ptr<T>>& handlers)
+        {
+            mRanges.clear();
+            for (const auto& [opcode, handler] : handlers)
+            {
+                const unsigned code = static_cast<unsigned>(opcode);
+                if (mRanges.empty() || code - mRanges.back().mBegin > mRanges.back().mHandlers.size() + sMaxGap)
+                    mRanges.push_back(Range{ .mBegin = code, .mHandlers = {} });
+                Range& range = mRanges.back();
+                range.mHandlers.resize(code - range.mBegin + 1, nullptr);
+                range.mHandlers.back() = handler.get();
+            }
+        }
+
+        /// Returns nullptr for not installed opcodes.
+        T* find(unsigned opcode) const
+        {
+            for (const Range& range : mRanges)
+                if (const unsigned offset = opcode - range.mBegin; offset < range.mHandlers.size())
+                    return range.mHandlers[offset];
+            return nullptr;
+        }
+
+        std::size_t getRangesCount() const { return mRanges.size(); }
+
+    private:
+        struct Range
+        {
+            unsigned mBegin;
+            std::vector<T*> mHandlers;
+        };
+
+        std::vector<Range> mRanges;
+    };
+}
+
+#endif
@@ -9,7 +9,7 @@
 
 namespace Interpreter
 {
-    [[noreturn]] static void abortUnknownCode(int segment, int opcode)
+    [[noreturn]] static void abortUnknownCode(unsigned int segment, unsigned int opcode)
     {
         const std::string error = "unknown opcode " + std::to_string(opcode) + " in segment " + std::to_string(segment);
         throw std::runtime_error(error);
@@ -22,14 +22,14 @@ namespace Interpreter
     }
 
     template <typename T>
-    auto& getDispatcher(const T& segment, unsigned int seg, int opcode)
+    T& getDispatcher(const DispatchTable<T>& table, unsigned int seg, unsigned int opcode)
     {
-        auto it = segment.find(opcode);
-        if (it == segment.end())
+        T* const dispatcher = table.find(opcode);
+        if (dispatcher == nullptr)
         {
             abortUnknownCode(seg, opcode);
         }
-        return it->second;
+        return *dispatcher;
     }
 
     void Interpreter::execute(Type_Code code)
@@ -40,18 +40,18 @@ namespace Interpreter
         {
             case 0:
             {
-                const int opcode = code >> 24;
+                const unsigned int opcode = code >> 24;
                 const unsigned int arg0 = code & 0xffffff;
 
-                return getDispatcher(mSegment0, 0, opcode)->execute(mRuntime, arg0);
+                return getDispatcher(mDispatchTable0, 0, opcode).execute(mRuntime, arg0);
             }
 
             case 2:
             {
-                const int opcode = (code >> 20) & 0x3ff;
+                const unsigned int opcode = (code >> 20) & 0x3ff;
                 const unsigned int arg0 = code & 0xfffff;
 
-                return getDispatcher(mSegment2, 2, opcode)->execute(mRuntime, arg0);
+                return getDispatcher(mDispatchTable2, 2, opcode).execute(mRuntime, arg0);
             }
         }
 
@@ -61,23 +61,32 @@ namespace Interpreter
         {
             case 0x30:
             {
-                const int opcode = (code >> 8) & 0x3ffff;
+                const unsigned int opcode = (code >> 8) & 0x3ffff;
                 const unsigned int arg0 = code & 0xff;
 
-                return getDispatcher(mSegment3, 3, opcode)->execute(mRuntime, arg0);
+                return getDispatcher(mDispatchTable3, 3, opcode).execute(mRuntime, arg0);
             }
 
             case 0x32:
             {
-                const int opcode = code & 0x3ffffff;
+                const unsigned int opcode = code & 0x3ffffff;
 
-                return getDispatcher(mSegment5, 5, opcode)->execute(mRuntime);
+                return getDispatcher(mDispatchTable5, 5, opcode).execute(mRuntime);
             }
         }
 
         abortUnknownSegment(code);
     }
 
+    void Interpreter::buildDispatchTables()
+    {
+        mDispatchTable0.build(mSegment0);
+        mDispatchTable2.build(mSegment2);
+        mDispatchTable3.build(mSegment3);
+        mDispatchTable5.build(mSegment5);
+        mDispatchTablesValid = true;
+    }
+
     void Interpreter::begin()
     {
         if (mRunning)
@@ -107,6 +116,9 @@ namespace Interpreter
 
     void Interpreter::run(const Program& program, Context& context)
     {
+        if (!mDispatchTablesValid)
+            buildDispatchTables();
+
         begin();
 
         try
@@ -9,6 +9,7 @@
 
 #include <components/misc/strings/format.hpp>
 
+#include "dispatchtable.hpp"
 #include "opcodes.hpp"
 #include "program.hpp"
 #include "runtime.hpp"
@@ -27,9 +28,16 @@ namespace Interpreter
         std::map<int, std::unique_ptr<Opcode1>> mSegment2;
         std::map<int, std::unique_ptr<Opcode1>> mSegment3;
         std::map<int, std::unique_ptr<Opcode0>> mSegment5;
+        DispatchTable<Opcode1> mDispatchTable0;
+        DispatchTable<Opcode1> mDispatchTable2;
+        DispatchTable<Opcode1> mDispatchTable3;
+        DispatchTable<Opcode0> mDispatchTable5;
+        bool mDispatchTablesValid = false;
 
         void execute(Type_Code code);
 
+        void buildDispatchTables();
+
         void begin();
 
         void end();
@@ -41,6 +49,7 @@ namespace Interpreter
                 throw std::invalid_argument(Misc::StringUtils::format(
                     "Duplicated interpreter instruction code in segment %s: 0x%x", name, code));
             segment.emplace(code, std::make_unique<T>(std::forward<Args>(args)...));
+            mDispatchTablesValid = false;
         }
 
     public:
@@ -1,20 +1,28 @@
 #ifndef OPENMW_BARRIER_H
 #define OPENMW_BARRIER_H
 
-#include <condition_variable>
-#include <mutex>
+#include <atomic>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
 
 namespace Misc
 {
     /// @brief Synchronize several threads
+    /// @par Waiting threads poll for a while before going to sleep. Usually all threads arrive within a short time
+    /// so most of them never sleep and there is no wakeup latency.
     class Barrier
     {
     public:
+        static constexpr unsigned sDefaultSpinCount = 4096;
+
         /// @param count number of threads to wait on
-        explicit Barrier(unsigned count)
+        /// @param spinCount number of polls before going to sleep
+        explicit Barrier(unsigned count, unsigned spinCount = sDefaultSpinCount)
             : mThreadCount(count)
-            , mRendezvousCount(0)
-            , mGeneration(0)
+            , mSpinCount(spinCount)
         {
         }
 
@@ -23,29 +31,46 @@ namespace Misc
         template <class Callback>
         void wait(Callback&& func)
         {
-            std::unique_lock lock(mMutex);
+            // Generation can't change before this thread arrives
+            const unsigned generation = mGeneration.load(std::memory_order_acquire);
 
-            ++mRendezvousCount;
-            const unsigned int currentGeneration = mGeneration;
-            if (mRendezvousCount == mThreadCount || mThreadCount == 0)
+            if (mRendezvousCount.fetch_add(1, std::memory_order_acq_rel) + 1 >= mThreadCount)
             {
-                ++mGeneration;
-                mRendezvousCount = 0;
+                mRendezvousCount.store(0, std::memory_order_relaxed);
                 func();
-                mRendezvous.notify_all();
+                mGeneration.store(generation + 1, std::memory_order_release);
+                mGeneration.notify_all();
+                return;
             }
-            else
+
+            for (unsigned i = 0; i < mSpinCount; ++i)
             {
-                mRendezvous.wait(lock, [&]() { return mGeneration != currentGeneration; });
+                if (mGeneration.load(std::memory_order_acquire) != generation)
+                    return;
+                relax(i);
             }
+
+            mGeneration.wait(generation, std::memory_order_acquire);
         }
 
     private:
-        unsigned int mThreadCount;
-        unsigned int mRendezvousCount;
-        unsigned int mGeneration;
-        mutable std::mutex mMutex;
-        std::condition_variable mRendezvous;
+        static constexpr unsigned sYieldInterval = 64;
+
+        const unsigned mThreadCount;
+        const unsigned mSpinCount;
+        std::atomic<unsigned> mRendezvousCount{ 0 };
+        std::atomic<unsigned> mGeneration{ 0 };
+
+        // Leave the core to the other hardware thread while polling and give up the time slice from time to time in
+        // case the threads to wait on are not running
+        static void relax(unsigned iteration)
+        {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+            _mm_pause();
+#endif
+            if (iteration % sYieldInterval == sYieldInterval - 1)
+                std::this_thread::yield();
+        }
     };
 }
 
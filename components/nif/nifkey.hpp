@@ -3,7 +3,8 @@
 #ifndef OPENMW_COMPONENTS_NIF_NIFKEY_HPP
 #define OPENMW_COMPONENTS_NIF_NIFKEY_HPP
 
-#include <map>
+#include <algorithm>
+#include <vector>
 
 #include "exception.hpp"
 #include "niffile.hpp"
@@ -36,23 +37,57 @@ namespace Nif
         float mContinuity; // Only for TBC interpolation
         */
     };
+    // Quaternion keys never have tangents, don't waste memory on them
+    template <>
+    struct KeyT<osg::Quat>
+    {
+        osg::Quat mValue;
+    };
+
     using FloatKey = KeyT<float>;
     using Vector3Key = KeyT<osg::Vec3f>;
     using Vector4Key = KeyT<osg::Vec4f>;
     using QuaternionKey = KeyT<osg::Quat>;
 
+    /// Keys sorted by time. Times and keys are stored in separate arrays to make search cache friendly.
     template <typename T, T (NIFStream::*getValue)()>
     struct KeyMapT
     {
-        using MapType = std::map<float, KeyT<T>>;
-
         using ValueType = T;
         using KeyType = KeyT<T>;
 
         std::string mFrameName;
         float mLegacyWeight;
         uint32_t mInterpolationType = InterpolationType_Unknown;
-        MapType mKeys;
+        std::vector<float> mTimes;
+        std::vector<KeyType> mKeys;
+
+        bool empty() const { return mTimes.empty(); }
+
+        std::size_t size() const { return mTimes.size(); }
+
+        /// Replaces existing key with the same time
+        void insert(float time, const KeyType& key)
+        {
+            // Keys are usually stored in order
+            if (mTimes.empty() || mTimes.back() < time)
+            {
+                mTimes.push_back(time);
+                mKeys.push_back(key);
+                return;
+            }
+
+            const auto it = std::lower_bound(mTimes.begin(), mTimes.end(), time);
+            const auto index = it - mTimes.begin();
+            if (*it == time)
+            {
+                mKeys[index] = key;
+                return;
+            }
+
+            mTimes.insert(it, time);
+            mKeys.insert(mKeys.begin() + index, key);
+        }
 
         // Read in a KeyGroup (see http://niftools.sourceforge.net/doc/nif/NiKeyframeData.html)
         void read(NIFStream* nif, bool morph = false)
@@ -81,6 +116,9 @@ namespace Nif
 
             KeyType key = {};
 
+            mTimes.reserve(count);
+            mKeys.reserve(count);
+
             if (mInterpolationType == InterpolationType_Linear || mInterpolationType == InterpolationType_Constant)
             {
                 for (size_t i = 0; i < count; i++)
@@ -88,7 +126,7 @@ namespace Nif
                     float time;
                     nif->read(time);
                     readValue(*nif, key);
-                    mKeys[time] = key;
+                    insert(time, key);
                 }
             }
             else if (mInterpolationType == InterpolationType_Quadratic)
@@ -98,7 +136,7 @@ namespace Nif
                     float time;
                     nif->read(time);
                     readQuadratic(*nif, key);
-                    mKeys[time] = key;
+                    insert(time, key);
                 }
             }
             else if (mInterpolationType == InterpolationType_TBC)
@@ -108,7 +146,7 @@ namespace Nif
                     float time;
                     nif->read(time);
                     readTBC(*nif, key);
-                    mKeys[time] = key;
+                    insert(time, key);
                 }
             }
             else if (mInterpolationType == InterpolationType_XYZ)
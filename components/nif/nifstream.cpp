@@ -1,9 +1,13 @@
 #include "nifstream.hpp"
 
+#include <cstring>
 #include <span>
+#include <string_view>
 
 #include "niffile.hpp"
 
+#include <components/files/memorystream.hpp>
+
 #include "../to_utf8/to_utf8.hpp"
 
 namespace
@@ -23,12 +27,12 @@ namespace
     // This one should be used if the type can be read contiguously as an array of a different type
     // (e.g. osg::VecXf can be read as a float array of X elements)
     template <class elementType, size_t numElements, class T>
-    void readAlignedRange(Files::IStreamPtr& stream, T* dest, size_t size)
+    void readAlignedRange(Nif::NIFStream& stream, T* dest, size_t size)
     {
         static_assert(std::is_standard_layout_v<T>);
         static_assert(std::alignment_of_v<T> == std::alignment_of_v<elementType>);
         static_assert(sizeof(T) == sizeof(elementType) * numElements);
-        Nif::readDynamicBufferOfType(stream, reinterpret_cast<elementType*>(dest), size * numElements);
+        stream.read(reinterpret_cast<elementType*>(dest), size * numElements);
     }
 
 }
@@ -36,6 +40,52 @@ namespace
 namespace Nif
 {
 
+    NIFStream::NIFStream(
+        const Reader& reader, Files::IStreamPtr&& stream, const ToUTF8::StatelessUtf8Encoder* encoder)
+        : mReader(reader)
+        , mStream(std::move(stream))
+        , mEncoder(encoder)
+    {
+        if (const auto* buffer = dynamic_cast<const Files::MemBuf*>(mStream->rdbuf()))
+        {
+            mMemory = buffer->getUnread();
+            mMemoryBacked = true;
+        }
+    }
+
+    void NIFStream::readChars(char* dest, std::size_t size, std::string_view what)
+    {
+        if (mMemoryBacked)
+        {
+            if (mMemory.size() < size)
+                throw std::runtime_error("Failed to read " + std::string(what) + " of " + std::to_string(size)
+                    + " chars: only " + std::to_string(mMemory.size()) + " bytes left");
+            std::memcpy(dest, mMemory.data(), size);
+            mMemory = mMemory.subspan(size);
+            return;
+        }
+        mStream->read(dest, size);
+        if (mStream->fail())
+            throw std::runtime_error("Failed to read " + std::string(what) + " of " + std::to_string(size)
+                + " chars: only " + std::to_string(mStream->gcount()) + " bytes left");
+    }
+
+    void NIFStream::skip(size_t size)
+    {
+        if (!mMemoryBacked)
+        {
+            mStream->ignore(size);
+            if (mStream->fail() || static_cast<std::size_t>(mStream->gcount()) < size)
+                throw std::runtime_error("Failed to skip " + std::to_string(size) + " bytes: only "
+                    + std::to_string(mStream->gcount()) + " bytes left");
+            return;
+        }
+        if (mMemory.size() < size)
+            throw std::runtime_error("Failed to skip " + std::to_string(size) + " bytes: only "
+                + std::to_string(mMemory.size()) + " bytes left");
+        mMemory = mMemory.subspan(size);
+    }
+
     unsigned int NIFStream::getVersion() const
     {
         return mReader.getVersion();
@@ -54,9 +104,7 @@ namespace Nif
     std::string NIFStream::getSizedString(size_t length)
     {
         std::string str(length, '\0');
-        mStream->read(str.data(), length);
-        if (mStream->bad())
-            throw std::runtime_error("Failed to read sized string of " + std::to_string(length) + " chars");
+        readChars(str.data(), length, "sized string");
         size_t end = str.find('\0');
         if (end != std::string::npos)
             str.erase(end);
@@ -75,6 +123,19 @@ namespace Nif
     std::string NIFStream::getVersionString()
     {
         std::string result;
+        if (mMemoryBacked)
+        {
+            const std::size_t end = std::string_view(mMemory.data(), mMemory.size()).find('\n');
+            if (end == std::string_view::npos)
+            {
+                result.assign(mMemory.data(), mMemory.size());
+                mMemory = {};
+                return result;
+            }
+            result.assign(mMemory.data(), end);
+            mMemory = mMemory.subspan(end + 1);
+            return result;
+        }
         std::getline(*mStream, result);
         if (mStream->bad())
             throw std::runtime_error("Failed to read version string");
@@ -85,34 +146,32 @@ namespace Nif
     {
         size_t size = get<uint32_t>();
         std::string str(size, '\0');
-        mStream->read(str.data(), size);
-        if (mStream->bad())
-            throw std::runtime_error("Failed to read string palette of " + std::to_string(size) + " chars");
+        readChars(str.data(), size, "string palette");
         return str;
     }
 
     template <>
     void NIFStream::read<osg::Vec2f>(osg::Vec2f& vec)
     {
-        readBufferOfType(mStream, vec._v);
+        readBuffer(vec._v);
     }
 
     template <>
     void NIFStream::read<osg::Vec3f>(osg::Vec3f& vec)
     {
-        readBufferOfType(mStream, vec._v);
+        readBuffer(vec._v);
     }
 
     template <>
     void NIFStream::read<osg::Vec4f>(osg::Vec4f& vec)
     {
-        readBufferOfType(mStream, vec._v);
+        readBuffer(vec._v);
     }
 
     template <>
     void NIFStream::read<Matrix3>(Matrix3& mat)
     {
-        readBufferOfType<9>(mStream, reinterpret_cast<float*>(&mat.mValues));
+        readBuffer<9>(reinterpret_cast<float*>(&mat.mValues));
     }
 
     template <>
@@ -178,25 +237,25 @@ namespace Nif
     template <>
     void NIFStream::read<osg::Vec2f>(osg::Vec2f* dest, size_t size)
     {
-        readAlignedRange<float, 2>(mStream, dest, size);
+        readAlignedRange<float, 2>(*this, dest, size);
     }
 
     template <>
     void NIFStream::read<osg::Vec3f>(osg::Vec3f* dest, size_t size)
     {
-        readAlignedRange<float, 3>(mStream, dest, size);
+        readAlignedRange<float, 3>(*this, dest, size);
     }
 
     template <>
     void NIFStream::read<osg::Vec4f>(osg::Vec4f* dest, size_t size)
     {
-        readAlignedRange<float, 4>(mStream, dest, size);
+        readAlignedRange<float, 4>(*this, dest, size);
     }
 
     template <>
     void NIFStream::read<Matrix3>(Matrix3* dest, size_t size)
     {
-        readAlignedRange<float, 9>(mStream, dest, size);
+        readAlignedRange<float, 9>(*this, dest, size);
     }
 
     template <>
@@ -5,7 +5,9 @@
 
 #include <array>
 #include <cassert>
+#include <cstring>
 #include <istream>
+#include <span>
 #include <stdexcept>
 #include <stdint.h>
 #include <string>
@@ -40,7 +42,7 @@ namespace Nif
             std::is_arithmetic_v<T> || std::is_same_v<T, Misc::float16_t>, "Buffer element type is not arithmetic");
         static_assert(!std::is_same_v<T, bool>, "Buffer element type is boolean");
         pIStream->read((char*)dest, numInstances * sizeof(T));
-        if (pIStream->bad())
+        if (pIStream->fail())
             throw std::runtime_error("Failed to read typed (" + std::string(typeid(T).name()) + ") buffer of "
                 + std::to_string(numInstances) + " instances");
         if constexpr (Misc::IS_BIG_ENDIAN)
@@ -61,7 +63,7 @@ namespace Nif
             std::is_arithmetic_v<T> || std::is_same_v<T, Misc::float16_t>, "Buffer element type is not arithmetic");
         static_assert(!std::is_same_v<T, bool>, "Buffer element type is boolean");
         pIStream->read((char*)dest, numInstances * sizeof(T));
-        if (pIStream->bad())
+        if (pIStream->fail())
             throw std::runtime_error("Failed to read typed (" + std::string(typeid(T).name()) + ") dynamic buffer of "
                 + std::to_string(numInstances) + " instances");
         if constexpr (Misc::IS_BIG_ENDIAN)
@@ -69,24 +71,71 @@ namespace Nif
                 Misc::swapEndiannessInplace(dest[i]);
     }
 
+    /// Read from the memory buffer advancing its beginning. Throws an exception if there is not enough data.
+    template <typename T>
+    inline void readDynamicBufferOfType(std::span<const char>& buffer, T* dest, std::size_t numInstances)
+    {
+        static_assert(
+            std::is_arithmetic_v<T> || std::is_same_v<T, Misc::float16_t>, "Buffer element type is not arithmetic");
+        static_assert(!std::is_same_v<T, bool>, "Buffer element type is boolean");
+        const std::size_t size = numInstances * sizeof(T);
+        if (buffer.size() < size)
+            throw std::runtime_error("Failed to read typed (" + std::string(typeid(T).name()) + ") buffer of "
+                + std::to_string(numInstances) + " instances: only " + std::to_string(buffer.size())
+                + " bytes left");
+        std::memcpy(dest, buffer.data(), size);
+        buffer = buffer.subspan(size);
+        if constexpr (Misc::IS_BIG_ENDIAN)
+            for (std::size_t i = 0; i < numInstances; i++)
+                Misc::swapEndiannessInplace(dest[i]);
+    }
+
     class NIFStream
     {
         const Reader& mReader;
         Files::IStreamPtr mStream;
+        // Not yet read part of the stream buffer when the stream reads from memory
+        std::span<const char> mMemory;
+        bool mMemoryBacked = false;
         const ToUTF8::StatelessUtf8Encoder* mEncoder;
         std::string mBuffer;
 
-    public:
-        explicit NIFStream(
-            const Reader& reader, Files::IStreamPtr&& stream, const ToUTF8::StatelessUtf8Encoder* encoder)
-            : mReader(reader)
-            , mStream(std::move(stream))
-            , mEncoder(encoder)
+        template <std::size_t numInstances, class T>
+        void readBuffer(T* dest)
         {
+            if (mMemoryBacked)
+                readDynamicBufferOfType(mMemory, dest, numInstances);
+            else
+                readBufferOfType<numInstances>(mStream, dest);
         }
 
+        template <std::size_t numInstances, class T>
+        void readBuffer(T (&dest)[numInstances])
+        {
+            readBuffer<numInstances>(static_cast<T*>(dest));
+        }
+
+        template <class T>
+        void readDynamicBuffer(T* dest, std::size_t numInstances)
+        {
+            if (mMemoryBacked)
+                readDynamicBufferOfType(mMemory, dest, numInstances);
+            else
+                readDynamicBufferOfType(mStream, dest, numInstances);
+        }
+
+        void readChars(char* dest, std::size_t size, std::string_view what);
+
+    public:
+        /// Streams reading from a memory buffer (Files::MemBuf) are parsed directly from the buffer without going
+        /// through the std::istream interface.
+        explicit NIFStream(
+            const Reader& reader, Files::IStreamPtr&& stream, const ToUTF8::StatelessUtf8Encoder* encoder);
+
         const Reader& getFile() const { return mReader; }
 
+        bool isMemoryBacked() const { return mMemoryBacked; }
+
         unsigned int getVersion() const;
         unsigned int getUserVersion() const;
         unsigned int getBethVersion() const;
@@ -97,27 +146,27 @@ namespace Nif
             return (major << 24) + (minor << 16) + (patch << 8) + rev;
         }
 
-        void skip(size_t size) { mStream->ignore(size); }
+        void skip(size_t size);
 
         /// Read into a single instance of type
         template <class T>
         void read(T& data)
         {
-            readBufferOfType<1>(mStream, &data);
+            readBuffer<1>(&data);
         }
 
         /// Read multiple instances of type into an array
         template <class T, size_t size>
         void readArray(std::array<T, size>& arr)
         {
-            readBufferOfType<size>(mStream, arr.data());
+            readBuffer<size>(arr.data());
         }
 
         /// Read instances of type into a dynamic buffer
         template <class T>
         void read(T* dest, size_t size)
         {
-            readDynamicBufferOfType<T>(mStream, dest, size);
+            readDynamicBuffer(dest, size);
         }
 
         /// Read multiple instances of type into a vector
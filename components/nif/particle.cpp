@@ -681,7 +681,10 @@ namespace Nif
         uint32_t numVisKeys;
         nif->read(numVisKeys);
         for (size_t i = 0; i < numVisKeys; i++)
-            mVisKeyList->mKeys[nif->get<float>()].mValue = nif->get<uint8_t>() != 0;
+        {
+            const float time = nif->get<float>();
+            mVisKeyList->insert(time, BoolKeyMap::KeyType{ .mValue = nif->get<uint8_t>() != 0 });
+        }
     }
 
     void NiPSysCollider::read(NIFStream* nif)
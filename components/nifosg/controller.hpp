@@ -1,8 +1,10 @@
 #ifndef COMPONENTS_NIFOSG_CONTROLLER_H
 #define COMPONENTS_NIFOSG_CONTROLLER_H
 
+#include <algorithm>
 #include <set>
 #include <type_traits>
+#include <vector>
 
 #include <osg/Texture2D>
 
@@ -38,23 +40,24 @@ namespace NifOsg
     template <typename MapT>
     class ValueInterpolator
     {
-        typename MapT::MapType::const_iterator retrieveKey(float time) const
+        // Return index of the first key with time not less than given. Time has to be greater than the first key time.
+        std::size_t retrieveKey(float time) const
         {
-            // retrieve the current position in the map, optimized for the most common case
+            const std::vector<float>& times = mKeys->mTimes;
+
+            // retrieve the current position in the track, optimized for the most common case
             // where time moves linearly along the keyframe track
-            if (mLastHighKey != mKeys->mKeys.end())
+            if (mLastHighKey != 0)
             {
-                if (time > mLastHighKey->first)
-                {
-                    // try if we're there by incrementing one
-                    ++mLastLowKey;
-                    ++mLastHighKey;
-                }
-                if (mLastHighKey != mKeys->mKeys.end() && time >= mLastLowKey->first && time <= mLastHighKey->first)
-                    return mLastHighKey;
+                std::size_t high = mLastHighKey;
+                // try if we're there by incrementing one
+                if (time > times[high])
+                    ++high;
+                if (high < times.size() && time >= times[high - 1] && time <= times[high])
+                    return high;
             }
 
-            return mKeys->mKeys.lower_bound(time);
+            return std::lower_bound(times.begin(), times.end(), time) - times.begin();
         }
 
     public:
@@ -74,22 +77,12 @@ namespace NifOsg
             if (interpolator->mData.empty())
                 return;
             mKeys = interpolator->mData->mKeyList;
-            if (mKeys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
         }
 
         ValueInterpolator(std::shared_ptr<const MapT> keys, ValueT defaultVal = ValueT())
-            : mKeys(keys)
+            : mKeys(std::move(keys))
             , mDefaultVal(defaultVal)
         {
-            if (keys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
         }
 
         ValueT interpKey(float time) const
@@ -97,29 +90,30 @@ namespace NifOsg
             if (empty())
                 return mDefaultVal;
 
-            const typename MapT::MapType& keys = mKeys->mKeys;
+            const std::vector<float>& times = mKeys->mTimes;
+            const std::vector<typename MapT::KeyType>& keys = mKeys->mKeys;
 
-            if (time <= keys.begin()->first)
-                return keys.begin()->second.mValue;
+            if (time <= times.front())
+                return keys.front().mValue;
 
-            typename MapT::MapType::const_iterator it = retrieveKey(time);
+            const std::size_t high = retrieveKey(time);
 
             // now do the actual interpolation
-            if (it != keys.end())
+            if (high < times.size())
             {
                 // cache for next time
-                mLastHighKey = it;
-                mLastLowKey = --it;
+                mLastHighKey = high;
+                const std::size_t low = high - 1;
 
-                float a = (time - mLastLowKey->first) / (mLastHighKey->first - mLastLowKey->first);
+                float a = (time - times[low]) / (times[high] - times[low]);
 
-                return interpolate(mLastLowKey->second, mLastHighKey->second, a, mKeys->mInterpolationType);
+                return interpolate(keys[low], keys[high], a, mKeys->mInterpolationType);
             }
 
-            return keys.rbegin()->second.mValue;
+            return keys.back().mValue;
         }
 
-        bool empty() const { return !mKeys || mKeys->mKeys.empty(); }
+        bool empty() const { return !mKeys || mKeys->empty(); }
 
     private:
         template <typename ValueType>
@@ -169,8 +163,8 @@ namespace NifOsg
             }
         }
 
-        mutable typename MapT::MapType::const_iterator mLastLowKey;
-        mutable typename MapT::MapType::const_iterator mLastHighKey;
+        // Zero when there is no cached position because the first key is never a high key
+        mutable std::size_t mLastHighKey = 0;
 
         std::shared_ptr<const MapT> mKeys;
 
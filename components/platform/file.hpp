@@ -30,6 +30,20 @@ namespace Platform::File
 
     size_t read(Handle handle, void* data, size_t size);
 
+    /// Maps the first \p size bytes of the file into memory for reading.
+    /// @return nullptr if memory mapping is not supported by the platform.
+    const void* map(Handle handle, size_t size);
+
+    void unmap(const void* data, size_t size);
+
+    /// Hints the system to start reading the file region in background to make the following reads faster.
+    /// @note Does nothing if not supported by the platform, errors are ignored.
+    void prefetch(Handle handle, size_t offset, size_t size);
+
+    /// Hints the system to start loading the memory mapped region in background.
+    /// @note Does nothing if not supported by the platform, errors are ignored.
+    void prefetchMapped(const void* data, size_t size);
+
     class ScopedHandle
     {
         Handle mHandle{ Handle::Invalid };
@@ -1,11 +1,15 @@
 #include "file.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <errno.h>
 #include <fcntl.h>
+#include <limits>
 #include <stdexcept>
 #include <string.h>
 #include <string>
+#include <sys/mman.h>
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -103,4 +107,50 @@ namespace Platform::File
         return amount;
     }
 
+    const void* map(Handle handle, size_t size)
+    {
+        auto nativeHandle = getNativeHandle(handle);
+
+        void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, nativeHandle, 0);
+        if (data == MAP_FAILED)
+        {
+            throw std::system_error(
+                errno, std::generic_category(), "An attempt to map " + std::to_string(size) + " bytes failed");
+        }
+        return data;
+    }
+
+    void unmap(const void* data, size_t size)
+    {
+        ::munmap(const_cast<void*>(data), size);
+    }
+
+    void prefetch(Handle handle, size_t offset, size_t size)
+    {
+        auto nativeHandle = getNativeHandle(handle);
+
+#if defined(POSIX_FADV_WILLNEED)
+        ::posix_fadvise(nativeHandle, static_cast<off_t>(offset), static_cast<off_t>(size), POSIX_FADV_WILLNEED);
+#elif defined(F_RDADVISE)
+        radvisory advisory;
+        advisory.ra_offset = static_cast<off_t>(offset);
+        advisory.ra_count = static_cast<int>(std::min<size_t>(size, std::numeric_limits<int>::max()));
+        ::fcntl(nativeHandle, F_RDADVISE, &advisory);
+#else
+        static_cast<void>(nativeHandle);
+        static_cast<void>(offset);
+        static_cast<void>(size);
+#endif
+    }
+
+    void prefetchMapped(const void* data, size_t size)
+    {
+        // madvise requires the address to be aligned to the page boundary
+        const auto pageSize = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+        const auto begin = reinterpret_cast<std::uintptr_t>(data) & ~(pageSize - 1);
+        const auto end = reinterpret_cast<std::uintptr_t>(data) + size;
+
+        ::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+    }
+
 }
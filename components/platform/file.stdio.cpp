@@ -93,4 +93,15 @@ namespace Platform::File
         return static_cast<size_t>(amount);
     }
 
+    const void* map(Handle /*handle*/, size_t /*size*/)
+    {
+        return nullptr;
+    }
+
+    void unmap(const void* /*data*/, size_t /*size*/) {}
+
+    void prefetch(Handle /*handle*/, size_t /*offset*/, size_t /*size*/) {}
+
+    void prefetchMapped(const void* /*data*/, size_t /*size*/) {}
+
 }
@@ -99,4 +99,44 @@ namespace Platform::File
 
         return bytesRead;
     }
+
+    const void* map(Handle handle, size_t size)
+    {
+        auto nativeHandle = getNativeHandle(handle);
+
+        HANDLE mapping = CreateFileMappingW(nativeHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+            throw std::runtime_error(
+                std::string("A file mapping creation failed: ") + std::to_string(GetLastError()));
+
+        // The view keeps the mapping object alive, so the handle is not needed anymore
+        const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+        const DWORD error = GetLastError();
+        CloseHandle(mapping);
+
+        if (data == nullptr)
+            throw std::runtime_error(std::string("A file view mapping failed: ") + std::to_string(error));
+
+        return data;
+    }
+
+    void unmap(const void* data, size_t /*size*/)
+    {
+        UnmapViewOfFile(data);
+    }
+
+    void prefetch(Handle /*handle*/, size_t /*offset*/, size_t /*size*/) {}
+
+    void prefetchMapped(const void* data, size_t size)
+    {
+#if _WIN32_WINNT >= _WIN32_WINNT_WIN8
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = const_cast<void*>(data);
+        range.NumberOfBytes = size;
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+        static_cast<void>(data);
+        static_cast<void>(size);
+#endif
+    }
 }
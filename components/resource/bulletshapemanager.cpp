@@ -7,6 +7,7 @@
 #include <osg/Transform>
 #include <osg/TriangleFunctor>
 
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
 #include <BulletCollision/CollisionShapes/btTriangleMesh.h>
 
 #include <components/misc/osguservalues.hpp>
@@ -25,6 +26,57 @@
 
 namespace Resource
 {
+    namespace
+    {
+        std::size_t getCollisionShapeCost(const btCollisionShape& shape)
+        {
+            if (shape.isCompound())
+            {
+                const btCompoundShape& compound = static_cast<const btCompoundShape&>(shape);
+                std::size_t result = sizeof(btCompoundShape);
+                for (int i = 0, n = compound.getNumChildShapes(); i < n; ++i)
+                    result += getCollisionShapeCost(*compound.getChildShape(i));
+                return result;
+            }
+
+            if (shape.getShapeType() != TRIANGLE_MESH_SHAPE_PROXYTYPE)
+                return sizeof(btCollisionShape);
+
+            // Count vertex and index data only, BVH is roughly proportional to it
+            const btStridingMeshInterface& mesh = *static_cast<const btBvhTriangleMeshShape&>(shape).getMeshInterface();
+            std::size_t result = sizeof(btBvhTriangleMeshShape);
+            for (int i = 0, n = mesh.getNumSubParts(); i < n; ++i)
+            {
+                const unsigned char* vertices = nullptr;
+                int verticesCount = 0;
+                PHY_ScalarType verticesType;
+                int verticesStride = 0;
+                const unsigned char* indices = nullptr;
+                int indicesStride = 0;
+                int facesCount = 0;
+                PHY_ScalarType indicesType;
+                mesh.getLockedReadOnlyVertexIndexBase(&vertices, verticesCount, verticesType, verticesStride,
+                    &indices, indicesStride, facesCount, indicesType, i);
+                result += static_cast<std::size_t>(verticesCount) * static_cast<std::size_t>(verticesStride)
+                    + static_cast<std::size_t>(facesCount) * static_cast<std::size_t>(indicesStride);
+                mesh.unLockReadOnlyVertexBase(i);
+            }
+            return result;
+        }
+
+        std::size_t getBulletShapeCost(const osg::Object& object)
+        {
+            const BulletShape* shape = dynamic_cast<const BulletShape*>(&object);
+            if (shape == nullptr)
+                return 0;
+            std::size_t result = sizeof(BulletShape);
+            if (shape->mCollisionShape != nullptr)
+                result += getCollisionShapeCost(*shape->mCollisionShape);
+            if (shape->mAvoidCollisionShape != nullptr)
+                result += getCollisionShapeCost(*shape->mAvoidCollisionShape);
+            return result;
+        }
+    }
 
     struct GetTriangleFunctor
     {
@@ -99,7 +151,7 @@ namespace Resource
 
     BulletShapeManager::BulletShapeManager(
         const VFS::Manager* vfs, SceneManager* sceneMgr, NifFileManager* nifFileManager, double expiryDelay)
-        : ResourceManager(vfs, expiryDelay)
+        : ResourceManager(vfs, expiryDelay, &getBulletShapeCost)
         , mInstanceCache(new MultiObjectCache)
         , mSceneManager(sceneMgr)
         , mNifFileManager(nifFileManager)
@@ -24,6 +24,8 @@ namespace Resource
             "Get",
             "Hit",
             "Expired",
+            "Evicted",
+            "Cost",
         };
 
         for (std::string_view suffix : suffixes)
@@ -36,5 +38,7 @@ namespace Resource
         dst.setAttribute(frameNumber, makeAttribute(prefix, "Get"), static_cast<double>(src.mGet));
         dst.setAttribute(frameNumber, makeAttribute(prefix, "Hit"), static_cast<double>(src.mHit));
         dst.setAttribute(frameNumber, makeAttribute(prefix, "Expired"), static_cast<double>(src.mExpired));
+        dst.setAttribute(frameNumber, makeAttribute(prefix, "Evicted"), static_cast<double>(src.mEvicted));
+        dst.setAttribute(frameNumber, makeAttribute(prefix, "Cost"), static_cast<double>(src.mCost));
     }
 }
@@ -42,13 +42,20 @@ namespace
         return warningImage;
     }
 
+    std::size_t getImageCost(const osg::Object& object)
+    {
+        if (const osg::Image* image = dynamic_cast<const osg::Image*>(&object))
+            return image->getTotalSizeInBytesIncludingMipmaps();
+        return 0;
+    }
+
 }
 
 namespace Resource
 {
 
     ImageManager::ImageManager(const VFS::Manager* vfs, double expiryDelay)
-        : ResourceManager(vfs, expiryDelay)
+        : ResourceManager(vfs, expiryDelay, &getImageCost)
         , mWarningImage(createWarningImage())
         , mOptions(new osgDB::Options("dds_flip dds_dxt1_detect_rgba ignoreTga2Fields"))
         , mOptionsNoFlip(new osgDB::Options("dds_dxt1_detect_rgba ignoreTga2Fields"))
@@ -12,6 +12,7 @@
 #include <components/misc/pathhelpers.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/misc/strings/conversion.hpp>
+#include <components/nifosg/controller.hpp>
 #include <components/nifosg/nifloader.hpp>
 #include <components/sceneutil/keyframe.hpp>
 #include <components/sceneutil/osgacontroller.hpp>
@@ -41,6 +42,21 @@ namespace Resource
                 time = Misc::StringUtils::toNumeric<double>(line.substr(spacePos + 1), time);
             return time;
         }
+
+        // Key data is shared with the NIF file controllers were created from and can't be measured without
+        // exposing interpolators internals, so the estimate covers only what the holder owns directly.
+        std::size_t getKeyframeHolderCost(const osg::Object& object)
+        {
+            const SceneUtil::KeyframeHolder* holder = dynamic_cast<const SceneUtil::KeyframeHolder*>(&object);
+            if (holder == nullptr)
+                return 0;
+            std::size_t result = sizeof(SceneUtil::KeyframeHolder);
+            for (const auto& [time, textKey] : holder->mTextKeys)
+                result += sizeof(time) + sizeof(textKey) + textKey.capacity();
+            for (const auto& [name, controller] : holder->mKeyframeControllers)
+                result += sizeof(name) + name.capacity() + sizeof(NifOsg::KeyframeController);
+            return result;
+        }
     }
 
     RetrieveAnimationsVisitor::RetrieveAnimationsVisitor(SceneUtil::KeyframeHolder& target,
@@ -200,7 +216,7 @@ namespace Resource
 
     KeyframeManager::KeyframeManager(const VFS::Manager* vfs, SceneManager* sceneManager, double expiryDelay,
         const ToUTF8::StatelessUtf8Encoder* encoder)
-        : ResourceManager(vfs, expiryDelay)
+        : ResourceManager(vfs, expiryDelay, &getKeyframeHolderCost)
         , mSceneManager(sceneManager)
         , mEncoder(encoder)
     {
@@ -46,12 +46,25 @@ namespace Resource
         if (obj != nullptr)
             return static_cast<NifFileHolder*>(obj.get())->mNifFile;
 
-        auto file = std::make_shared<Nif::NIFFile>(name);
-        Nif::Reader reader(*file, mEncoder);
-        reader.parse(mVFS->get(name));
-        obj = new NifFileHolder(file);
-        mCache->addEntryToObjectCache(name.value(), obj);
-        return file;
+        return load(name, mVFS->get(name));
+    }
+
+    Nif::NIFFilePtr NifFileManager::get(VFS::Path::NormalizedView name, Files::IStreamPtr&& file)
+    {
+        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(name);
+        if (obj != nullptr)
+            return static_cast<NifFileHolder*>(obj.get())->mNifFile;
+
+        return load(name, std::move(file));
+    }
+
+    Nif::NIFFilePtr NifFileManager::load(VFS::Path::NormalizedView name, Files::IStreamPtr&& file)
+    {
+        auto nifFile = std::make_shared<Nif::NIFFile>(name);
+        Nif::Reader reader(*nifFile, mEncoder);
+        reader.parse(std::move(file));
+        mCache->addEntryToObjectCache(name.value(), new NifFileHolder(nifFile));
+        return nifFile;
     }
 
     void NifFileManager::reportStats(unsigned int frameNumber, osg::Stats* stats) const
@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_NIFFILEMANAGER_H
 #define OPENMW_COMPONENTS_RESOURCE_NIFFILEMANAGER_H
 
+#include <components/files/istreamptr.hpp>
 #include <components/nif/niffile.hpp>
 
 #include "resourcemanager.hpp"
@@ -19,6 +20,8 @@ namespace Resource
     {
         const ToUTF8::StatelessUtf8Encoder* mEncoder;
 
+        Nif::NIFFilePtr load(VFS::Path::NormalizedView name, Files::IStreamPtr&& file);
+
     public:
         NifFileManager(const VFS::Manager* vfs, const ToUTF8::StatelessUtf8Encoder* encoder);
         ~NifFileManager();
@@ -28,6 +31,9 @@ namespace Resource
         /// to be done in advance by other managers accessing the NifFileManager.
         Nif::NIFFilePtr get(VFS::Path::NormalizedView name);
 
+        /// Same as above but parses the given already opened file stream if the NIF file is not cached yet.
+        Nif::NIFFilePtr get(VFS::Path::NormalizedView name, Files::IStreamPtr&& file);
+
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
     };
 
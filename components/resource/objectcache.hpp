@@ -3,6 +3,7 @@
 // - removeExpiredObjectsInCache no longer keeps a lock while the unref happens.
 // - template allows customized KeyType.
 // - objects with uninitialized time stamp are not removed.
+// - items are split into independently locked shards and may be evicted when over the memory budget.
 
 /* -*-c++-*- OpenSceneGraph - Copyright (C) 1998-2006 Robert Osfield
  *
@@ -27,10 +28,16 @@
 #include <osg/ref_ptr>
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
 #include <map>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace osg
@@ -47,33 +54,83 @@ namespace Resource
     {
         osg::ref_ptr<osg::Object> mValue;
         double mLastUsage;
+        std::size_t mCost = 0;
+    };
+
+    /// Selects a shard for the key. Defined only for the key types supporting std::hash.
+    template <class KeyType>
+    struct ObjectCacheKeyHash
+    {
+        std::size_t operator()(const KeyType& key) const
+            requires std::is_default_constructible_v<std::hash<KeyType>>
+        {
+            return std::hash<KeyType>()(key);
+        }
+    };
+
+    /// String keys are looked up by string views and VFS paths, all of them have to give the same hash.
+    template <>
+    struct ObjectCacheKeyHash<std::string>
+    {
+        template <class K>
+        std::size_t operator()(const K& key) const
+        {
+            if constexpr (std::is_convertible_v<const K&, std::string_view>)
+                return std::hash<std::string_view>()(key);
+            else
+                return std::hash<std::string_view>()(key.value());
+        }
     };
 
     template <typename KeyType>
     class GenericObjectCache : public osg::Referenced
     {
     public:
+        /// Returns estimated number of bytes used by the object.
+        using CostFunction = std::size_t (*)(const osg::Object& object);
+
+        static constexpr bool sCanBeSharded
+            = requires(const KeyType& key) { ObjectCacheKeyHash<KeyType>()(key); };
+
+        /// @param shardsCount Items are split into this number of independently locked parts to reduce contention
+        /// between threads. Ignored for key types without hash.
+        /// @param getCost Used to account memory of the items, when not set items do not count towards the budget.
+        explicit GenericObjectCache(std::size_t shardsCount = 1, CostFunction getCost = nullptr)
+            : mShards(sCanBeSharded ? std::max<std::size_t>(shardsCount, 1) : 1)
+            , mGetCost(getCost)
+        {
+        }
+
         // Update last usage timestamp using referenceTime for each cache time if they are not nullptr and referenced
         // from somewhere else. Remove items with last usage > expiryTime. Note: last usage might be updated from other
         // places so nullptr or not references elsewhere items are not always removed.
+        // Then remove least recently used not referenced from somewhere else items until the total cost fits into the
+        // budget.
         void update(double referenceTime, double expiryDelay)
         {
             std::vector<osg::ref_ptr<osg::Object>> objectsToRemove;
+            const double expiryTime = referenceTime - expiryDelay;
+            for (Shard& shard : mShards)
             {
-                const double expiryTime = referenceTime - expiryDelay;
-                std::lock_guard<std::mutex> lock(mMutex);
-                std::erase_if(mItems, [&](auto& v) {
-                    Item& item = v.second;
-                    if ((item.mValue != nullptr && item.mValue->referenceCount() > 1) || item.mLastUsage == 0)
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                for (auto it = shard.mItems.begin(); it != shard.mItems.end();)
+                {
+                    Item& item = it->second;
+                    if (isReferencedElsewhere(item) || item.mLastUsage == 0)
                         item.mLastUsage = referenceTime;
                     if (item.mLastUsage > expiryTime)
-                        return false;
-                    ++mExpired;
+                    {
+                        ++it;
+                        continue;
+                    }
+                    ++shard.mExpired;
+                    shard.mCost -= item.mCost;
                     if (item.mValue != nullptr)
                         objectsToRemove.push_back(std::move(item.mValue));
-                    return true;
-                });
+                    it = shard.mItems.erase(it);
+                }
             }
+            evictOverBudget(objectsToRemove);
             // note, actual unref happens outside of the lock
             objectsToRemove.clear();
         }
@@ -81,44 +138,60 @@ namespace Resource
         /** Remove all objects in the cache regardless of having external references or expiry times.*/
         void clear()
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            mItems.clear();
+            for (Shard& shard : mShards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                shard.mItems.clear();
+                shard.mCost = 0;
+            }
         }
 
         /** Add a key,object,timestamp triple to the Registry::ObjectCache.*/
         template <class K>
         void addEntryToObjectCache(K&& key, osg::Object* object, double timestamp = 0.0)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            const auto it = mItems.find(key);
-            if (it == mItems.end())
-                mItems.emplace_hint(it, std::forward<K>(key), Item{ object, timestamp });
+            const std::size_t cost = mGetCost != nullptr && object != nullptr ? mGetCost(*object) : 0;
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            const auto it = shard.mItems.find(key);
+            if (it == shard.mItems.end())
+                shard.mItems.emplace_hint(it, std::forward<K>(key), Item{ object, timestamp, cost });
             else
-                it->second = Item{ object, timestamp };
+            {
+                shard.mCost -= it->second.mCost;
+                it->second = Item{ object, timestamp, cost };
+            }
+            shard.mCost += cost;
         }
 
         /** Remove Object from cache.*/
         void removeFromObjectCache(const auto& key)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            const auto itr = mItems.find(key);
-            if (itr != mItems.end())
-                mItems.erase(itr);
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            const auto itr = shard.mItems.find(key);
+            if (itr != shard.mItems.end())
+            {
+                shard.mCost -= itr->second.mCost;
+                shard.mItems.erase(itr);
+            }
         }
 
         /** Get an ref_ptr<Object> from the object cache*/
         osg::ref_ptr<osg::Object> getRefFromObjectCache(const auto& key)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            if (Item* const item = find(key))
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            if (Item* const item = shard.find(key))
                 return item->mValue;
             return nullptr;
         }
 
         std::optional<osg::ref_ptr<osg::Object>> getRefFromObjectCacheOrNone(const auto& key)
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
-            if (Item* const item = find(key))
+            Shard& shard = getShard(key);
+            const std::lock_guard<std::mutex> lock(shard.mMutex);
+            if (Item* const item = shard.find(key))
                 return item->mValue;
             return std::nullopt;
         }
@@ -126,8 +199,9 @@ namespace Resource
         /** Check if an object is in the cache, and if it is, update its usage time stamp. */
         bool checkInObjectCache(const auto& key, double timeStamp)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            if (Item* const item = find(key))
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            if (Item* const item = shard.find(key))
             {
                 item->mLastUsage = timeStamp;
                 return true;
@@ -138,68 +212,166 @@ namespace Resource
         /** call releaseGLObjects on all objects attached to the object cache.*/
         void releaseGLObjects(osg::State* state)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            for (const auto& [k, v] : mItems)
-                v.mValue->releaseGLObjects(state);
+            for (Shard& shard : mShards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                for (const auto& [k, v] : shard.mItems)
+                    v.mValue->releaseGLObjects(state);
+            }
         }
 
         /** call node->accept(nv); for all nodes in the objectCache. */
         void accept(osg::NodeVisitor& nv)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            for (const auto& [k, v] : mItems)
-                if (osg::Object* const object = v.mValue.get())
-                    if (osg::Node* const node = dynamic_cast<osg::Node*>(object))
-                        node->accept(nv);
+            for (Shard& shard : mShards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                for (const auto& [k, v] : shard.mItems)
+                    if (osg::Object* const object = v.mValue.get())
+                        if (osg::Node* const node = dynamic_cast<osg::Node*>(object))
+                            node->accept(nv);
+            }
         }
 
-        /** call operator()(KeyType, osg::Object*) for each object in the cache. */
+        /** call operator()(KeyType, osg::Object*) for each object in the cache. Objects are ordered by key within
+         * each shard. */
         template <class Functor>
         void call(Functor&& f)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            for (const auto& [k, v] : mItems)
-                f(k, v.mValue.get());
+            for (Shard& shard : mShards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                for (const auto& [k, v] : shard.mItems)
+                    f(k, v.mValue.get());
+            }
         }
 
         template <class K>
         std::optional<std::pair<KeyType, osg::ref_ptr<osg::Object>>> lowerBound(K&& key)
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
-            const auto it = mItems.lower_bound(std::forward<K>(key));
-            if (it == mItems.end())
-                return std::nullopt;
-            return std::pair(it->first, it->second.mValue);
+            std::optional<std::pair<KeyType, osg::ref_ptr<osg::Object>>> result;
+            for (Shard& shard : mShards)
+            {
+                const std::lock_guard<std::mutex> lock(shard.mMutex);
+                const auto it = shard.mItems.lower_bound(key);
+                if (it != shard.mItems.end() && (!result.has_value() || std::less<>()(it->first, result->first)))
+                    result.emplace(it->first, it->second.mValue);
+            }
+            return result;
         }
 
+        /// Set the total cost of the items to keep in the cache when they are not referenced from somewhere else.
+        void setMaxCost(std::size_t value) { mMaxCost = value; }
+
         CacheStats getStats() const
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
-            return CacheStats{
-                .mSize = mItems.size(),
-                .mGet = mGet,
-                .mHit = mHit,
-                .mExpired = mExpired,
-            };
+            CacheStats result;
+            for (const Shard& shard : mShards)
+            {
+                const std::lock_guard<std::mutex> lock(shard.mMutex);
+                result.mSize += shard.mItems.size();
+                result.mGet += shard.mGet;
+                result.mHit += shard.mHit;
+                result.mExpired += shard.mExpired;
+                result.mEvicted += shard.mEvicted;
+                result.mCost += shard.mCost;
+            }
+            return result;
         }
 
     protected:
         using Item = GenericObjectCacheItem;
 
-        std::map<KeyType, Item, std::less<>> mItems;
-        mutable std::mutex mMutex;
-        std::size_t mGet = 0;
-        std::size_t mHit = 0;
-        std::size_t mExpired = 0;
+        struct Shard
+        {
+            std::map<KeyType, Item, std::less<>> mItems;
+            mutable std::mutex mMutex;
+            std::size_t mCost = 0;
+            std::size_t mGet = 0;
+            std::size_t mHit = 0;
+            std::size_t mExpired = 0;
+            std::size_t mEvicted = 0;
+
+            Item* find(const auto& key)
+            {
+                ++mGet;
+                const auto it = mItems.find(key);
+                if (it == mItems.end())
+                    return nullptr;
+                ++mHit;
+                return &it->second;
+            }
+        };
+
+        std::vector<Shard> mShards;
+        const CostFunction mGetCost;
+        std::atomic_size_t mMaxCost{ std::numeric_limits<std::size_t>::max() };
+
+        static bool isReferencedElsewhere(const Item& item)
+        {
+            return item.mValue != nullptr && item.mValue->referenceCount() > 1;
+        }
+
+        Shard& getShard(const auto& key)
+        {
+            if constexpr (sCanBeSharded)
+                if (mShards.size() > 1)
+                    return mShards[ObjectCacheKeyHash<KeyType>()(key) % mShards.size()];
+            return mShards.front();
+        }
 
-        Item* find(const auto& key)
+        void evictOverBudget(std::vector<osg::ref_ptr<osg::Object>>& objectsToRemove)
         {
-            ++mGet;
-            const auto it = mItems.find(key);
-            if (it == mItems.end())
-                return nullptr;
-            ++mHit;
-            return &it->second;
+            const std::size_t maxCost = mMaxCost;
+            if (maxCost == std::numeric_limits<std::size_t>::max())
+                return;
+
+            struct Candidate
+            {
+                double mLastUsage;
+                Shard* mShard;
+                KeyType mKey;
+            };
+
+            std::size_t totalCost = 0;
+            for (Shard& shard : mShards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                totalCost += shard.mCost;
+            }
+
+            if (totalCost <= maxCost)
+                return;
+
+            std::vector<Candidate> candidates;
+            for (Shard& shard : mShards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                for (const auto& [key, item] : shard.mItems)
+                    if (item.mCost > 0 && !isReferencedElsewhere(item))
+                        candidates.push_back(Candidate{ item.mLastUsage, &shard, key });
+            }
+
+            std::sort(candidates.begin(), candidates.end(),
+                [](const Candidate& l, const Candidate& r) { return l.mLastUsage < r.mLastUsage; });
+
+            for (const Candidate& candidate : candidates)
+            {
+                if (totalCost <= maxCost)
+                    break;
+                Shard& shard = *candidate.mShard;
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                const auto it = shard.mItems.find(candidate.mKey);
+                // Item might be replaced or taken by other thread after the candidates were collected
+                if (it == shard.mItems.end() || isReferencedElsewhere(it->second))
+                    continue;
+                totalCost -= std::min(totalCost, it->second.mCost);
+                shard.mCost -= it->second.mCost;
+                ++shard.mEvicted;
+                if (it->second.mValue != nullptr)
+                    objectsToRemove.push_back(std::move(it->second.mValue));
+                shard.mItems.erase(it);
+            }
         }
     };
 }
@@ -3,6 +3,9 @@
 
 #include <osg/ref_ptr>
 
+#include <cstddef>
+#include <limits>
+
 #include <components/vfs/pathutil.hpp>
 
 #include "objectcache.hpp"
@@ -28,6 +31,7 @@ namespace Resource
         virtual void updateCache(double referenceTime) = 0;
         virtual void clearCache() = 0;
         virtual void setExpiryDelay(double expiryDelay) = 0;
+        virtual void setCacheBudget(std::size_t bytes) = 0;
         virtual void reportStats(unsigned int frameNumber, osg::Stats* stats) const = 0;
         virtual void releaseGLObjects(osg::State* state) = 0;
     };
@@ -41,9 +45,10 @@ namespace Resource
     public:
         typedef GenericObjectCache<KeyType> CacheType;
 
-        explicit GenericResourceManager(const VFS::Manager* vfs, double expiryDelay)
+        explicit GenericResourceManager(const VFS::Manager* vfs, double expiryDelay, std::size_t shardsCount = 1,
+            typename CacheType::CostFunction getCost = nullptr)
             : mVFS(vfs)
-            , mCache(new CacheType)
+            , mCache(new CacheType(shardsCount, getCost))
             , mExpiryDelay(expiryDelay)
         {
         }
@@ -60,6 +65,13 @@ namespace Resource
         void setExpiryDelay(double expiryDelay) final { mExpiryDelay = expiryDelay; }
         double getExpiryDelay() const { return mExpiryDelay; }
 
+        /// Evict least recently used not referenced objects when their total cost exceeds this value on update.
+        /// Only objects with cost are accounted, see CacheType::CostFunction. 0 disables the budget.
+        void setCacheBudget(std::size_t bytes) final
+        {
+            mCache->setMaxCost(bytes == 0 ? std::numeric_limits<std::size_t>::max() : bytes);
+        }
+
         const VFS::Manager* getVFS() const { return mVFS; }
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override {}
@@ -75,8 +87,13 @@ namespace Resource
     class ResourceManager : public GenericResourceManager<std::string>
     {
     public:
-        explicit ResourceManager(const VFS::Manager* vfs, double expiryDelay)
-            : GenericResourceManager(vfs, expiryDelay)
+        /// Resources are loaded from many threads (main, cell preloader, work queue), so split the cache to reduce
+        /// lock contention.
+        static constexpr std::size_t sShardsCount = 8;
+
+        explicit ResourceManager(
+            const VFS::Manager* vfs, double expiryDelay, CacheType::CostFunction getCost = nullptr)
+            : GenericResourceManager(vfs, expiryDelay, sShardsCount, getCost)
         {
         }
     };
@@ -2,8 +2,12 @@
 
 #include <algorithm>
 
+#include <components/bsa/decompressedfilecache.hpp>
+#include <components/vfs/manager.hpp>
+
 #include "animblendrulesmanager.hpp"
 #include "bgsmfilemanager.hpp"
+#include "cachestats.hpp"
 #include "imagemanager.hpp"
 #include "keyframemanager.hpp"
 #include "niffilemanager.hpp"
@@ -118,6 +122,19 @@ namespace Resource
         for (std::vector<BaseResourceManager*>::const_iterator it = mResourceManagers.begin();
              it != mResourceManagers.end(); ++it)
             (*it)->reportStats(frameNumber, stats);
+
+        if (const Bsa::DecompressedFileCache* cache = mVFS->getDecompressedFileCache())
+        {
+            const Bsa::DecompressedFileCacheStats cacheStats = cache->getStats();
+            Resource::reportStats("Decompressed File", frameNumber,
+                CacheStats{
+                    .mSize = cacheStats.mCount,
+                    .mGet = cacheStats.mHits + cacheStats.mMisses,
+                    .mHit = cacheStats.mHits,
+                    .mCost = cacheStats.mSize,
+                },
+                *stats);
+        }
     }
 
     void ResourceSystem::releaseGLObjects(osg::State* state)
@@ -5,6 +5,7 @@
 
 #include <osg/AlphaFunc>
 #include <osg/ColorMaski>
+#include <osg/Geometry>
 #include <osg/Group>
 #include <osg/Node>
 #include <osg/UserDataContainer>
@@ -60,6 +61,7 @@
 #include "imagemanager.hpp"
 #include "niffilemanager.hpp"
 #include "objectcache.hpp"
+#include "templatediskcache.hpp"
 
 namespace
 {
@@ -129,6 +131,32 @@ namespace
     private:
         unsigned int mMask;
     };
+
+    std::size_t getNodeCost(const osg::Node& node)
+    {
+        std::size_t result = sizeof(osg::Node);
+        if (const osg::Geometry* geometry = node.asGeometry())
+        {
+            osg::Geometry::ArrayList arrays;
+            geometry->getArrayList(arrays);
+            for (const osg::ref_ptr<osg::Array>& array : arrays)
+                result += array->getTotalDataSize();
+            for (const osg::ref_ptr<osg::PrimitiveSet>& primitiveSet : geometry->getPrimitiveSetList())
+                result += primitiveSet->getTotalDataSize();
+        }
+        if (const osg::Group* group = node.asGroup())
+            for (unsigned i = 0; i < group->getNumChildren(); ++i)
+                result += getNodeCost(*group->getChild(i));
+        return result;
+    }
+
+    // Textures are accounted by the ImageManager
+    std::size_t getTemplateCost(const osg::Object& object)
+    {
+        if (const osg::Node* node = dynamic_cast<const osg::Node*>(&object))
+            return getNodeCost(*node);
+        return 0;
+    }
 }
 
 namespace Resource
@@ -444,7 +472,7 @@ namespace Resource
 
     SceneManager::SceneManager(const VFS::Manager* vfs, Resource::ImageManager* imageManager,
         Resource::NifFileManager* nifFileManager, Resource::BgsmFileManager* bgsmFileManager, double expiryDelay)
-        : ResourceManager(vfs, expiryDelay)
+        : ResourceManager(vfs, expiryDelay, &getTemplateCost)
         , mShaderManager(new Shader::ShaderManager)
         , mForceShaders(false)
         , mClampLighting(true)
@@ -942,6 +970,32 @@ namespace Resource
         return options;
     }
 
+    void SceneManager::setTemplateDiskCacheDir(const std::filesystem::path& path)
+    {
+        if (path.empty())
+            mTemplateDiskCache = nullptr;
+        else
+            mTemplateDiskCache = std::make_unique<TemplateDiskCache>(path, new ImageReadCallback(mImageManager));
+    }
+
+    osg::ref_ptr<osg::Node> SceneManager::loadTemplate(VFS::Path::NormalizedView path)
+    {
+        if (mTemplateDiskCache == nullptr || Misc::getFileExtension(path.value()) != "nif")
+            return load(path, mVFS, mImageManager, mNifFileManager, mBgsmFileManager);
+
+        // Hashing the content requires reading the file which is still much faster than parsing it. On a miss the
+        // same stream is parsed to not open and possibly decompress the file twice.
+        Files::IStreamPtr file = mVFS->get(path);
+        const TemplateDiskCache::ContentHash contentHash = Files::getHash(path.value(), *file);
+        if (osg::ref_ptr<osg::Node> cached = mTemplateDiskCache->read(path, contentHash))
+            return cached;
+
+        osg::ref_ptr<osg::Node> loaded
+            = NifOsg::Loader::load(*mNifFileManager->get(path, std::move(file)), mImageManager, mBgsmFileManager);
+        mTemplateDiskCache->write(path, contentHash, *loaded);
+        return loaded;
+    }
+
     void SceneManager::shareState(osg::ref_ptr<osg::Node> node)
     {
         mSharedStateMutex.lock();
@@ -989,7 +1043,7 @@ namespace Resource
             osg::ref_ptr<osg::Node> loaded;
             try
             {
-                loaded = load(path, mVFS, mImageManager, mNifFileManager, mBgsmFileManager);
+                loaded = loadTemplate(path);
 
                 SceneUtil::ProcessExtraDataVisitor extraDataVisitor(this);
                 loaded->accept(extraDataVisitor);
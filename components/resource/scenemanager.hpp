@@ -34,6 +34,7 @@ namespace Resource
     class NifFileManager;
     class BgsmFileManager;
     class SharedStateManager;
+    class TemplateDiskCache;
 }
 
 namespace osgUtil
@@ -151,6 +152,11 @@ namespace Resource
 
         void setShaderPath(const std::filesystem::path& path);
 
+        /// Store scene graphs created from NIF files in the given directory and use them instead of parsing the same
+        /// files again. Empty path disables the cache.
+        /// @see TemplateDiskCache
+        void setTemplateDiskCacheDir(const std::filesystem::path& path);
+
         /// Check if a given scene is loaded and if so, update its usage timestamp to prevent it from being unloaded
         bool checkLoaded(VFS::Path::NormalizedView name, double referenceTime);
 
@@ -234,6 +240,7 @@ namespace Resource
 
     private:
         osg::ref_ptr<Shader::ShaderVisitor> createShaderVisitor(const std::string& shaderPrefix = "objects");
+        osg::ref_ptr<osg::Node> loadTemplate(VFS::Path::NormalizedView path);
         osg::ref_ptr<osg::Node> loadErrorMarker();
         osg::ref_ptr<osg::Node> cloneErrorMarker();
 
@@ -261,6 +268,7 @@ namespace Resource
         Resource::ImageManager* mImageManager;
         Resource::NifFileManager* mNifFileManager;
         Resource::BgsmFileManager* mBgsmFileManager;
+        std::unique_ptr<TemplateDiskCache> mTemplateDiskCache;
 
         osg::Texture::FilterMode mMinFilter;
         osg::Texture::FilterMode mMagFilter;
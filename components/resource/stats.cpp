@@ -58,6 +58,8 @@ namespace Resource
                 "Compiling",
                 "WorkQueue",
                 "WorkThread",
+                "WorkQueue Stolen",
+                "WorkQueue Cancelled",
                 "UnrefQueue",
                 "",
                 "Texture",
@@ -74,8 +76,6 @@ namespace Resource
                 "",
                 "Lua UsedMemory",
                 "",
-                "",
-                "",
             };
 
             static_assert(std::size(firstPage) == itemsPerPage);
@@ -94,6 +94,7 @@ namespace Resource
                 "Terrain Texture",
                 "Land",
                 "Blending Rules",
+                "Decompressed File",
             };
 
             constexpr std::string_view cellPreloader[] = {
@@ -104,6 +105,20 @@ namespace Resource
                 "CellPreloader Expired",
             };
 
+            constexpr std::string_view animation[] = {
+                "Skinning Get",
+                "Skinning Hit",
+                "",
+                "Animation Updated",
+                "Animation Skipped",
+            };
+
+            constexpr std::string_view physics[] = {
+                "Physics RayCastCache Count",
+                "Physics RayCastCache Get",
+                "Physics RayCastCache Hit",
+            };
+
             constexpr std::string_view navMesh[] = {
                 "NavMesh Jobs",
                 "NavMesh Removing",
@@ -115,11 +130,16 @@ namespace Resource
                 "NavMesh DbJobs Read",
                 "NavMesh DbCache Get",
                 "NavMesh DbCache Hit",
+                "NavMesh DbWrite Count",
+                "NavMesh DbWrite Commit",
+                "NavMesh DbWrite Pending",
                 "NavMesh CacheSize",
                 "NavMesh UsedTiles",
                 "NavMesh CachedTiles",
                 "NavMesh Cache Get",
                 "NavMesh Cache Hit",
+                "NavMesh Heightfields Tiles",
+                "NavMesh Heightfields Hit",
                 "NavMesh Recast Tiles",
                 "NavMesh Recast Objects",
                 "NavMesh Recast Heightfields",
@@ -131,16 +151,31 @@ namespace Resource
             for (std::string_view name : firstPage)
                 statNames.emplace_back(name);
 
+            constexpr std::size_t cachesPerPage = 3;
+
             for (std::size_t i = 0; i < std::size(caches); ++i)
             {
                 Resource::addCacheStatsAttibutes(caches[i], statNames);
-                if ((i + 1) % 5 != 0)
+                if ((i + 1) % cachesPerPage != 0)
                     statNames.emplace_back();
+                else
+                    while (statNames.size() % itemsPerPage != 0)
+                        statNames.emplace_back();
             }
 
             for (std::string_view name : cellPreloader)
                 statNames.emplace_back(name);
 
+            statNames.emplace_back();
+
+            for (std::string_view name : animation)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : physics)
+                statNames.emplace_back(name);
+
             while (statNames.size() % itemsPerPage != 0)
                 statNames.emplace_back();
 
@@ -0,0 +1,308 @@
+#include "templatediskcache.hpp"
+
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <typeindex>
+#include <unordered_set>
+
+#include <osg/AlphaFunc>
+#include <osg/BlendFunc>
+#include <osg/CullFace>
+#include <osg/Depth>
+#include <osg/FrontFace>
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/LOD>
+#include <osg/Material>
+#include <osg/MatrixTransform>
+#include <osg/Node>
+#include <osg/PolygonMode>
+#include <osg/PolygonOffset>
+#include <osg/Sequence>
+#include <osg/StateSet>
+#include <osg/Stencil>
+#include <osg/Switch>
+#include <osg/TexEnv>
+#include <osg/TexEnvCombine>
+#include <osg/TexGen>
+#include <osg/TexMat>
+#include <osg/Texture2D>
+#include <osg/UserDataContainer>
+#include <osg/ValueObject>
+#include <osg/Version>
+
+#include <osgDB/Options>
+#include <osgDB/Registry>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+#include <components/nifosg/fog.hpp>
+#include <components/nifosg/matrixtransform.hpp>
+#include <components/nifosg/nifloader.hpp>
+#include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/serialize.hpp>
+#include <components/sceneutil/texturetype.hpp>
+#include <components/version/version.hpp>
+
+#ifdef OSG_LIBRARY_STATIC
+// The binary format is implemented by the osg plugin under a separate name.
+USE_OSGPLUGIN(osg2)
+#endif
+
+namespace Resource
+{
+    namespace
+    {
+        constexpr std::uint32_t formatVersion = 1;
+
+        template <class T>
+        void appendValue(std::string& out, T value)
+        {
+            out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void appendString(std::string& out, std::string_view value)
+        {
+            appendValue(out, static_cast<std::uint32_t>(value.size()));
+            out.append(value);
+        }
+
+        // Everything the stored scene graph depends on besides the node classes implementation
+        std::string makeHeader(VFS::Path::NormalizedView path, const TemplateDiskCache::ContentHash& contentHash)
+        {
+            std::string result = "OMWT";
+            appendValue(result, formatVersion);
+            appendString(result, Version::getVersion());
+            appendString(result, Version::getCommitHash());
+            appendValue(result, static_cast<std::uint32_t>(OPENSCENEGRAPH_SOVERSION));
+            appendValue(result, static_cast<std::uint32_t>(NifOsg::Loader::getHiddenNodeMask()));
+            appendValue(result, static_cast<std::uint32_t>(NifOsg::Loader::getIntersectionDisabledNodeMask()));
+            appendValue(result, static_cast<std::uint8_t>(NifOsg::Loader::getShowMarkers()));
+            appendValue(result, static_cast<std::uint8_t>(SceneUtil::AutoDepth::isReversed()));
+            appendString(result, path.value());
+            appendValue(result, contentHash[0]);
+            appendValue(result, contentHash[1]);
+            return result;
+        }
+
+        osgDB::ReaderWriter* getReaderWriter()
+        {
+            return osgDB::Registry::instance()->getReaderWriterForExtension("osgb");
+        }
+
+        bool isLosslessType(const osg::Object& object)
+        {
+            static const std::unordered_set<std::type_index> types{
+                typeid(osg::Node),
+                typeid(osg::Group),
+                typeid(osg::Switch),
+                typeid(osg::LOD),
+                typeid(osg::Sequence),
+                typeid(osg::MatrixTransform),
+                typeid(NifOsg::MatrixTransform),
+                typeid(osg::Geometry),
+                typeid(osg::AlphaFunc),
+                typeid(osg::BlendFunc),
+                typeid(osg::CullFace),
+                typeid(osg::Depth),
+                // Stored as osg::Depth which is replaced by SceneManager after loading anyway
+                typeid(SceneUtil::AutoDepth),
+                typeid(osg::FrontFace),
+                typeid(osg::Material),
+                typeid(osg::PolygonMode),
+                typeid(osg::PolygonOffset),
+                typeid(osg::Stencil),
+                typeid(osg::TexEnv),
+                typeid(osg::TexEnvCombine),
+                typeid(osg::TexGen),
+                typeid(osg::TexMat),
+                typeid(osg::Texture2D),
+                typeid(NifOsg::Fog),
+                typeid(SceneUtil::TextureType),
+                typeid(osg::Uniform),
+                typeid(osg::DefaultUserDataContainer),
+                typeid(osg::BoolValueObject),
+                typeid(osg::IntValueObject),
+                typeid(osg::UIntValueObject),
+                typeid(osg::FloatValueObject),
+                typeid(osg::StringValueObject),
+            };
+            return types.contains(typeid(object));
+        }
+
+        bool isLosslessUserData(const osg::Object& object)
+        {
+            const osg::UserDataContainer* container = object.getUserDataContainer();
+            if (container == nullptr)
+                return true;
+            if (!isLosslessType(*container) || container->getUserData() != nullptr)
+                return false;
+            for (unsigned i = 0; i < container->getNumUserObjects(); ++i)
+                if (!isLosslessType(*container->getUserObject(i)))
+                    return false;
+            return true;
+        }
+
+        bool isLosslessAttributes(const osg::StateSet::AttributeList& attributes)
+        {
+            for (const auto& [key, attribute] : attributes)
+            {
+                const osg::StateAttribute& value = *attribute.first;
+                if (!isLosslessType(value) || !isLosslessUserData(value) || value.getUpdateCallback() != nullptr
+                    || value.getEventCallback() != nullptr)
+                    return false;
+                // Images are stored as references to the files loaded through the image manager
+                if (const osg::Texture* texture = value.asTexture())
+                    for (unsigned i = 0; i < texture->getNumImages(); ++i)
+                        if (const osg::Image* image = texture->getImage(i);
+                            image != nullptr && image->getFileName().empty())
+                            return false;
+            }
+            return true;
+        }
+
+        bool isLosslessStateSet(const osg::StateSet& stateSet)
+        {
+            if (stateSet.getUpdateCallback() != nullptr || stateSet.getEventCallback() != nullptr
+                || !isLosslessUserData(stateSet) || !isLosslessAttributes(stateSet.getAttributeList()))
+                return false;
+            for (const osg::StateSet::AttributeList& attributes : stateSet.getTextureAttributeList())
+                if (!isLosslessAttributes(attributes))
+                    return false;
+            for (const auto& [name, uniform] : stateSet.getUniformList())
+                if (!isLosslessType(*uniform.first) || uniform.first->getUpdateCallback() != nullptr
+                    || uniform.first->getEventCallback() != nullptr)
+                    return false;
+            return true;
+        }
+    }
+
+    TemplateDiskCache::TemplateDiskCache(
+        const std::filesystem::path& directory, osg::ref_ptr<osgDB::ReadFileCallback> readImageCallback)
+        : mDirectory(directory)
+        , mReadImageCallback(std::move(readImageCallback))
+    {
+        SceneUtil::registerLosslessSerializers();
+    }
+
+    TemplateDiskCache::~TemplateDiskCache() = default;
+
+    bool TemplateDiskCache::isLossless(const osg::Node& node)
+    {
+        if (!isLosslessType(node) || !isLosslessUserData(node) || node.getUpdateCallback() != nullptr
+            || node.getEventCallback() != nullptr || node.getCullCallback() != nullptr
+            || node.getComputeBoundingSphereCallback() != nullptr)
+            return false;
+
+        if (const osg::StateSet* stateSet = node.getStateSet(); stateSet != nullptr && !isLosslessStateSet(*stateSet))
+            return false;
+
+        if (const osg::Drawable* drawable = node.asDrawable())
+            if (drawable->getDrawCallback() != nullptr || drawable->getComputeBoundingBoxCallback() != nullptr
+                || drawable->getShape() != nullptr)
+                return false;
+
+        if (const osg::Group* group = node.asGroup())
+            for (unsigned i = 0; i < group->getNumChildren(); ++i)
+                if (!isLossless(*group->getChild(i)))
+                    return false;
+
+        return true;
+    }
+
+    bool TemplateDiskCache::isUsable()
+    {
+        // Entries are stored with geometry data which the replaced serializer would skip when reading them back
+        return SceneUtil::isGeometryDataSerialized();
+    }
+
+    std::filesystem::path TemplateDiskCache::getEntryPath(VFS::Path::NormalizedView path) const
+    {
+        std::istringstream stream{ std::string(path.value()) };
+        const std::array<std::uint64_t, 2> hash = Files::getHash(path.value(), stream);
+        std::ostringstream name;
+        name << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1] << ".osgb";
+        return mDirectory / name.str();
+    }
+
+    osg::ref_ptr<osg::Node> TemplateDiskCache::read(
+        VFS::Path::NormalizedView path, const ContentHash& contentHash) const
+    {
+        if (!isUsable())
+            return nullptr;
+
+        std::ifstream stream(getEntryPath(path), std::ios_base::binary);
+        if (!stream.is_open())
+            return nullptr;
+
+        const std::string expectedHeader = makeHeader(path, contentHash);
+        std::string header(expectedHeader.size(), '\0');
+        if (!stream.read(header.data(), static_cast<std::streamsize>(header.size())) || header != expectedHeader)
+            return nullptr;
+
+        osgDB::ReaderWriter* readerWriter = getReaderWriter();
+        if (readerWriter == nullptr)
+            return nullptr;
+
+        osg::ref_ptr<osgDB::Options> options = new osgDB::Options;
+        options->setReadFileCallback(mReadImageCallback);
+
+        const osgDB::ReaderWriter::ReadResult result = readerWriter->readNode(stream, options);
+        if (!result.success())
+        {
+            Log(Debug::Warning) << "Failed to read cached scene graph for " << path << ": " << result.message();
+            return nullptr;
+        }
+
+        return result.getNode();
+    }
+
+    void TemplateDiskCache::write(
+        VFS::Path::NormalizedView path, const ContentHash& contentHash, const osg::Node& node) const
+    {
+        if (!isUsable() || !isLossless(node))
+            return;
+
+        osgDB::ReaderWriter* readerWriter = getReaderWriter();
+        if (readerWriter == nullptr)
+            return;
+
+        const std::filesystem::path entryPath = getEntryPath(path);
+
+        // The same file may be loaded by multiple threads, each one writes into own temporary file
+        std::filesystem::path tempPath = entryPath;
+        tempPath += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+        try
+        {
+            std::filesystem::create_directories(mDirectory);
+
+            {
+                std::ofstream stream(tempPath, std::ios_base::binary | std::ios_base::trunc);
+                stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+
+                const std::string header = makeHeader(path, contentHash);
+                stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+                osg::ref_ptr<osgDB::Options> options = new osgDB::Options;
+                options->setPluginStringData("WriteImageHint", "UseExternal");
+
+                const osgDB::ReaderWriter::WriteResult result = readerWriter->writeNode(node, stream, options);
+                if (!result.success())
+                    throw std::runtime_error(result.message());
+            }
+
+            std::filesystem::rename(tempPath, entryPath);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write cached scene graph for " << path << " to " << entryPath << ": "
+                                << e.what();
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_TEMPLATEDISKCACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_TEMPLATEDISKCACHE_H
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include <osg/ref_ptr>
+
+#include <components/vfs/pathutil.hpp>
+
+namespace osg
+{
+    class Node;
+}
+
+namespace osgDB
+{
+    class ReadFileCallback;
+}
+
+namespace Resource
+{
+    /// @brief On-disk cache of the scene graphs created by NifOsg::Loader.
+    /// @par Scene graphs are stored in the native OSG binary format together with the hash of the NIF file content,
+    /// the engine version and the loader settings, an entry is used only when all of them match. Only scene graphs
+    /// consisting of classes that can be written without losing any state are stored, that excludes animated, skinned
+    /// and particle models, and models with embedded textures. External material files are not tracked.
+    /// @note Thread safe.
+    class TemplateDiskCache
+    {
+    public:
+        using ContentHash = std::array<std::uint64_t, 2>;
+
+        /// @param readImageCallback Used to load images referenced by the stored scene graphs.
+        explicit TemplateDiskCache(
+            const std::filesystem::path& directory, osg::ref_ptr<osgDB::ReadFileCallback> readImageCallback);
+
+        ~TemplateDiskCache();
+
+        /// Returns the stored scene graph for the file with the given content or nullptr. Returns nullptr when
+        /// the cache is not usable.
+        osg::ref_ptr<osg::Node> read(VFS::Path::NormalizedView path, const ContentHash& contentHash) const;
+
+        /// Store the scene graph loaded from the file with the given content if it can be stored losslessly and the
+        /// cache is usable.
+        void write(VFS::Path::NormalizedView path, const ContentHash& contentHash, const osg::Node& node) const;
+
+        /// Whether the scene graph can be written and read back without losing any state.
+        static bool isLossless(const osg::Node& node);
+
+        /// Whether entries can be written and read back. False once SceneUtil::registerSerializers() replaced the
+        /// osg::Geometry serializer by one skipping the geometry data.
+        static bool isUsable();
+
+    private:
+        std::filesystem::path mDirectory;
+        osg::ref_ptr<osgDB::ReadFileCallback> mReadImageCallback;
+
+        std::filesystem::path getEntryPath(VFS::Path::NormalizedView path) const;
+    };
+}
+
+#endif
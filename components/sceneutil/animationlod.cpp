@@ -0,0 +1,52 @@
+#include "animationlod.hpp"
+
+#include <osg/Stats>
+
+#include <algorithm>
+#include <cmath>
+
+namespace SceneUtil
+{
+    AnimationLod::AnimationLod(float pixelSize, unsigned int maxUpdateInterval)
+        : mPixelSize(pixelSize)
+        , mMaxUpdateInterval(std::max(maxUpdateInterval, 1u))
+    {
+    }
+
+    unsigned int AnimationLod::getUpdateInterval(float pixelSize) const
+    {
+        if (pixelSize >= mPixelSize)
+            return 1;
+        // Halving the size on the screen doubles the interval
+        if (pixelSize * static_cast<float>(mMaxUpdateInterval) <= mPixelSize)
+            return mMaxUpdateInterval;
+        return static_cast<unsigned int>(std::ceil(mPixelSize / pixelSize));
+    }
+
+    void AnimationLod::record(unsigned int frameNumber, bool skipped)
+    {
+        rollOver(frameNumber);
+
+        if (skipped)
+            ++mStats.mSkipped;
+        else
+            ++mStats.mUpdated;
+    }
+
+    void AnimationLod::reportStats(unsigned int frameNumber, osg::Stats& stats)
+    {
+        rollOver(frameNumber);
+        stats.setAttribute(frameNumber, "Animation Updated", static_cast<double>(mLastStats.mUpdated));
+        stats.setAttribute(frameNumber, "Animation Skipped", static_cast<double>(mLastStats.mSkipped));
+    }
+
+    void AnimationLod::rollOver(unsigned int frameNumber)
+    {
+        if (frameNumber == mFrameNumber)
+            return;
+        // Nothing is recorded for the previous frame when the last record is older
+        mLastStats = frameNumber == mFrameNumber + 1 ? mStats : AnimationLodStats{};
+        mStats = AnimationLodStats{};
+        mFrameNumber = frameNumber;
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_ANIMATIONLOD_H
+#define OPENMW_COMPONENTS_SCENEUTIL_ANIMATIONLOD_H
+
+#include <osg/Referenced>
+
+#include <cstddef>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace SceneUtil
+{
+    struct AnimationLodStats
+    {
+        std::size_t mUpdated = 0;
+        std::size_t mSkipped = 0;
+    };
+
+    /// @brief Chooses how often bones of a skeleton are updated depending on its size on the screen.
+    /// @note Not thread safe, used by the update traversal.
+    class AnimationLod : public osg::Referenced
+    {
+    public:
+        /// @param pixelSize skeletons smaller than this on the screen are updated less often
+        /// @param maxUpdateInterval the largest number of frames between updates
+        explicit AnimationLod(float pixelSize, unsigned int maxUpdateInterval);
+
+        /// @param pixelSize size on the screen like for osg::LOD::PIXEL_SIZE_ON_SCREEN
+        /// @return number of frames between updates of the bones, 1 to update every frame
+        unsigned int getUpdateInterval(float pixelSize) const;
+
+        /// Count an update or a skipped update of a skeleton
+        void record(unsigned int frameNumber, bool skipped);
+
+        /// Stats of the last complete frame
+        AnimationLodStats getStats() const { return mLastStats; }
+
+        /// Report stats of the frame before the given one, zero when nothing was recorded for it
+        void reportStats(unsigned int frameNumber, osg::Stats& stats);
+
+    private:
+        const float mPixelSize;
+        const unsigned int mMaxUpdateInterval;
+        unsigned int mFrameNumber = 0;
+        AnimationLodStats mStats;
+        AnimationLodStats mLastStats;
+
+        void rollOver(unsigned int frameNumber);
+    };
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "riggeometry.hpp"
 
+#include <algorithm>
+#include <optional>
 #include <unordered_map>
 
 #include <osg/MatrixTransform>
@@ -10,10 +12,71 @@
 #include <components/resource/scenemanager.hpp>
 
 #include "skeleton.hpp"
+#include "skinningcache.hpp"
 #include "util.hpp"
+#include "workqueue.hpp"
 
 namespace SceneUtil
 {
+    namespace
+    {
+        osg::ref_ptr<WorkQueue> sWorkQueue;
+        osg::ref_ptr<SkinningCache> sSkinningCache;
+
+        std::vector<SkinningInfluence> makeInfluences(
+            std::map<RigGeometry::BoneWeights, std::vector<unsigned short>>&& influencesToVertices)
+        {
+            std::vector<SkinningInfluence> result;
+            result.reserve(influencesToVertices.size());
+            for (auto& [boneWeights, vertices] : influencesToVertices)
+            {
+                // Access vertices in memory order
+                std::sort(vertices.begin(), vertices.end());
+                result.push_back(SkinningInfluence{ .mBoneWeights = boneWeights, .mVertices = std::move(vertices) });
+            }
+            return result;
+        }
+
+        bool readsVertices(const osg::NodeVisitor& nv)
+        {
+            const osg::CullSettings::ComputeNearFarMode mode
+                = static_cast<const osgUtil::CullVisitor&>(nv).getComputeNearFarMode();
+            return mode == osg::CullSettings::COMPUTE_NEAR_FAR_USING_PRIMITIVES
+                || mode == osg::CullSettings::COMPUTE_NEAR_USING_PRIMITIVES;
+        }
+
+        // Skinning of the geometry may be still in progress when it's drawn
+        class WaitSkinningDrawCallback final : public osg::Drawable::DrawCallback
+        {
+        public:
+            void setWorkItem(osg::ref_ptr<WorkItem> workItem) { mWorkItem = std::move(workItem); }
+
+            void wait() const
+            {
+                if (mWorkItem != nullptr)
+                    mWorkItem->waitTillDone();
+            }
+
+            void drawImplementation(osg::RenderInfo& renderInfo, const osg::Drawable* drawable) const override
+            {
+                wait();
+                drawable->drawImplementation(renderInfo);
+            }
+
+        private:
+            osg::ref_ptr<WorkItem> mWorkItem;
+        };
+    }
+
+    void RigGeometry::setWorkQueue(osg::ref_ptr<WorkQueue> workQueue)
+    {
+        sWorkQueue = std::move(workQueue);
+    }
+
+    void RigGeometry::setSkinningCache(osg::ref_ptr<SkinningCache> cache)
+    {
+        sSkinningCache = std::move(cache);
+    }
 
     RigGeometry::RigGeometry()
     {
@@ -55,6 +118,7 @@ namespace SceneUtil
             to.setCullingActive(false); // make sure to disable culling since that's handled by this class
             to.setComputeBoundingBoxCallback(new CopyBoundingBoxCallback());
             to.setComputeBoundingSphereCallback(new CopyBoundingSphereCallback());
+            to.setDrawCallback(new WaitSkinningDrawCallback);
 
             // vertices and normals are modified every frame, so we need to deep copy them.
             // assign a dedicated VBO to make sure that modifications don't interfere with source geometry's VBO.
@@ -125,11 +189,11 @@ namespace SceneUtil
             return false;
         }
 
-        mNodes.clear();
+        mBoneIndices.clear();
         for (const BoneInfo& info : mData->mBones)
         {
-            mNodes.push_back(mSkeleton->getBone(info.mName));
-            if (!mNodes.back())
+            mBoneIndices.push_back(mSkeleton->getBoneIndex(info.mName));
+            if (!mBoneIndices.back().has_value())
                 Log(Debug::Error) << "Error: RigGeometry did not find bone " << info.mName;
         }
 
@@ -148,78 +212,85 @@ namespace SceneUtil
         }
 
         unsigned int traversalNumber = nv->getTraversalNumber();
-        if (mLastFrameNumber == traversalNumber || (mLastFrameNumber != 0 && !mSkeleton->getActive()))
+        // Bones of the skeleton may be not updated since the last skinning, see Skeleton::setAnimationLod
+        if (mLastFrameNumber == traversalNumber
+            || (mLastFrameNumber != 0
+                && (!mSkeleton->getActive() || mSkeleton->getLastUpdateFrameNumber() <= mLastFrameNumber)))
         {
-            osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+            osg::Geometry& geom = *getGeometry();
+            if (readsVertices(*nv))
+                static_cast<const WaitSkinningDrawCallback*>(geom.getDrawCallback())->wait();
             nv->pushOntoNodePath(&geom);
             nv->apply(geom);
             nv->popFromNodePath();
             return;
         }
         mLastFrameNumber = traversalNumber;
-        osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+        // The other geometry may be still drawn in the previous frame
+        mCurrentGeometry ^= 1;
+        osg::Geometry& geom = *getGeometry();
 
         mSkeleton->updateBoneMatrices(traversalNumber);
 
         // skinning
-        const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
-        const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
-        const osg::Vec4Array* tangentSrc = mSourceTangents;
-
-        osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
-        osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
-        osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
-
-        std::vector<osg::Matrixf> boneMatrices(mNodes.size());
-        std::vector<Bone*>::const_iterator bone = mNodes.begin();
-        std::vector<BoneInfo>::const_iterator boneInfo = mData->mBones.begin();
-        for (osg::Matrixf& boneMat : boneMatrices)
+        const SkinningArrays arrays{
+            .mSourcePositions = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray()),
+            .mSourceNormals = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray()),
+            .mSourceTangents = mSourceTangents,
+            .mPositions = static_cast<osg::Vec3Array*>(geom.getVertexArray()),
+            .mNormals = static_cast<osg::Vec3Array*>(geom.getNormalArray()),
+            .mTangents = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7)),
+        };
+
+        // Missing bones don't contribute to the blended matrices
+        const osg::Matrixf missingBoneMatrix(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        std::vector<osg::Matrixf> boneMatrices(mBoneIndices.size(), missingBoneMatrix);
+        const std::vector<osg::Matrixf>& skeletonMatrices = mSkeleton->getBoneMatrices();
+        for (std::size_t i = 0; i < mBoneIndices.size(); ++i)
         {
-            if (*bone != nullptr)
-                boneMat = boneInfo->mInvBindMatrix * (*bone)->mMatrixInSkeletonSpace;
-            ++bone;
-            ++boneInfo;
+            if (mBoneIndices[i].has_value())
+                boneMatrices[i].mult(mData->mBones[i].mInvBindMatrix, skeletonMatrices[*mBoneIndices[i]]);
         }
 
-        for (const auto& [influences, vertices] : mData->mInfluences)
-        {
-            osg::Matrixf resultMat(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1);
+        std::optional<osg::Matrixf> geomToSkelMatrix;
+        if (mGeomToSkelMatrix)
+            geomToSkelMatrix = osg::Matrixf(*mGeomToSkelMatrix);
 
-            for (const auto& [index, weight] : influences)
-            {
-                if (mNodes[index] == nullptr)
-                    continue;
-                const float* boneMatPtr = boneMatrices[index].ptr();
-                float* resultMatPtr = resultMat.ptr();
-                for (int i = 0; i < 16; ++i, ++resultMatPtr, ++boneMatPtr)
-                    if (i % 4 != 3)
-                        *resultMatPtr += *boneMatPtr * weight;
-            }
+        WaitSkinningDrawCallback& drawCallback = static_cast<WaitSkinningDrawCallback&>(*geom.getDrawCallback());
+        // The last skinning into this geometry may be still in progress
+        drawCallback.wait();
 
-            if (mGeomToSkelMatrix)
-                resultMat *= (*mGeomToSkelMatrix);
+        osg::ref_ptr<SkinningResult> result
+            = new SkinningResult(mData, mData->mInfluences, std::move(boneMatrices), geomToSkelMatrix, arrays);
 
-            for (unsigned short vertex : vertices)
-            {
-                (*positionDst)[vertex] = resultMat.preMult((*positionSrc)[vertex]);
-                if (normalDst)
-                    (*normalDst)[vertex] = osg::Matrixf::transform3x3((*normalSrc)[vertex], resultMat);
+        osg::ref_ptr<SkinningResult> shared;
+        if (sSkinningCache != nullptr)
+            shared = sSkinningCache->get(traversalNumber, result);
 
-                if (tangentDst)
-                {
-                    const osg::Vec4f& srcTangent = (*tangentSrc)[vertex];
-                    osg::Vec3f transformedTangent = osg::Matrixf::transform3x3(
-                        osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
-                    (*tangentDst)[vertex] = osg::Vec4f(transformedTangent, srcTangent.w());
-                }
+        if (shared != nullptr)
+        {
+            // Another geometry with the same source has the same pose in this frame
+            if (shared->share(SkinnedArrays{ arrays.mPositions, arrays.mNormals, arrays.mTangents }))
+                drawCallback.setWorkItem(nullptr);
+            else if (readsVertices(*nv))
+            {
+                shared->waitTillDone();
+                drawCallback.setWorkItem(nullptr);
             }
+            else
+                drawCallback.setWorkItem(std::move(shared));
+        }
+        else if (sWorkQueue != nullptr && !readsVertices(*nv))
+        {
+            drawCallback.setWorkItem(result);
+            sWorkQueue->addWorkItem(std::move(result), WorkPriority::High);
+        }
+        else
+        {
+            drawCallback.setWorkItem(nullptr);
+            result->doWork();
+            result->signalDone();
         }
-
-        positionDst->dirty();
-        if (normalDst)
-            normalDst->dirty();
-        if (tangentDst)
-            tangentDst->dirty();
 
         geom.osg::Drawable::dirtyGLObjects();
 
@@ -246,18 +317,18 @@ namespace SceneUtil
 
         osg::BoundingBox box;
 
-        size_t index = 0;
-        for (const BoneInfo& info : mData->mBones)
+        const std::vector<osg::Matrixf>& skeletonMatrices = mSkeleton->getBoneMatrices();
+        for (std::size_t i = 0; i < mBoneIndices.size(); ++i)
         {
-            const Bone* bone = mNodes[index++];
-            if (bone == nullptr)
+            if (!mBoneIndices[i].has_value())
                 continue;
 
-            osg::BoundingSpheref bs = info.mBoundSphere;
+            const osg::Matrixf& boneMatrix = skeletonMatrices[*mBoneIndices[i]];
+            osg::BoundingSpheref bs = mData->mBones[i].mBoundSphere;
             if (mGeomToSkelMatrix)
-                transformBoundingSphere(bone->mMatrixInSkeletonSpace * (*mGeomToSkelMatrix), bs);
+                transformBoundingSphere(boneMatrix * (*mGeomToSkelMatrix), bs);
             else
-                transformBoundingSphere(bone->mMatrixInSkeletonSpace, bs);
+                transformBoundingSphere(boneMatrix, bs);
             box.expandBy(bs);
         }
 
@@ -335,8 +406,7 @@ namespace SceneUtil
         for (const auto& [vertex, weights] : vertexToInfluences)
             influencesToVertices[weights].emplace_back(vertex);
 
-        mData->mInfluences.reserve(influencesToVertices.size());
-        mData->mInfluences.assign(influencesToVertices.begin(), influencesToVertices.end());
+        mData->mInfluences = makeInfluences(std::move(influencesToVertices));
     }
 
     void RigGeometry::setInfluences(const std::vector<BoneWeights>& influences)
@@ -348,8 +418,7 @@ namespace SceneUtil
         for (size_t i = 0; i < influences.size(); i++)
             influencesToVertices[influences[i]].emplace_back(i);
 
-        mData->mInfluences.reserve(influencesToVertices.size());
-        mData->mInfluences.assign(influencesToVertices.begin(), influencesToVertices.end());
+        mData->mInfluences = makeInfluences(std::move(influencesToVertices));
     }
 
     void RigGeometry::accept(osg::NodeVisitor& nv)
@@ -382,12 +451,14 @@ namespace SceneUtil
 
     void RigGeometry::accept(osg::PrimitiveFunctor& func) const
     {
-        getGeometry(mLastFrameNumber)->accept(func);
+        const osg::Geometry& geom = *getGeometry();
+        static_cast<const WaitSkinningDrawCallback*>(geom.getDrawCallback())->wait();
+        geom.accept(func);
     }
 
-    osg::Geometry* RigGeometry::getGeometry(unsigned int frame) const
+    osg::Geometry* RigGeometry::getGeometry() const
     {
-        return mGeometry[frame % 2].get();
+        return mGeometry[mCurrentGeometry].get();
     }
 
 }
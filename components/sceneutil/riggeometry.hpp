@@ -4,10 +4,17 @@
 #include <osg/Geometry>
 #include <osg/Matrixf>
 
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "skinning.hpp"
+
 namespace SceneUtil
 {
     class Skeleton;
-    class Bone;
+    class WorkQueue;
+    class SkinningCache;
 
     // TODO: This class has a lot of issues.
     // - We require too many workarounds to ensure safety.
@@ -23,9 +30,18 @@ namespace SceneUtil
     /// @note The internal Geometry used for rendering is double buffered, this allows updates to be done in a thread
     /// safe way while not compromising rendering performance. This is crucial when using osg's default threading model
     /// of DrawThreadPerContext.
+    /// @note Skinning may be done by a work queue. In that case the internal Geometry waits for it before drawing.
     class RigGeometry : public osg::Drawable
     {
     public:
+        /// Skin all rig geometries on the given work queue instead of the cull thread, nullptr to disable.
+        /// @note Not thread safe, should be set before rendering.
+        static void setWorkQueue(osg::ref_ptr<WorkQueue> workQueue);
+
+        /// Share skinning results between rig geometries in the same pose, nullptr to disable.
+        /// @note Not thread safe, should be set before rendering.
+        static void setSkinningCache(osg::ref_ptr<SkinningCache> cache);
+
         RigGeometry();
         RigGeometry(const RigGeometry& copy, const osg::CopyOp& copyop);
 
@@ -83,7 +99,9 @@ namespace SceneUtil
         void updateBounds(osg::NodeVisitor* nv);
 
         osg::ref_ptr<osg::Geometry> mGeometry[2];
-        osg::Geometry* getGeometry(unsigned int frame) const;
+        // Geometry skinned last
+        unsigned int mCurrentGeometry{ 0 };
+        osg::Geometry* getGeometry() const;
 
         osg::ref_ptr<osg::Geometry> mSourceGeometry;
         osg::ref_ptr<const osg::Vec4Array> mSourceTangents;
@@ -95,10 +113,11 @@ namespace SceneUtil
         struct InfluenceData : public osg::Referenced
         {
             std::vector<BoneInfo> mBones;
-            std::vector<std::pair<BoneWeights, VertexList>> mInfluences;
+            std::vector<SkinningInfluence> mInfluences;
         };
         osg::ref_ptr<InfluenceData> mData;
-        std::vector<Bone*> mNodes;
+        // Indices of mData->mBones in the skeleton
+        std::vector<std::optional<std::size_t>> mBoneIndices;
 
         unsigned int mLastFrameNumber{ 0 };
         bool mBoundsFirstFrame{ true };
@@ -1,6 +1,10 @@
 #include "serialize.hpp"
 
+#include <atomic>
+
+#include <osgDB/InputStream>
 #include <osgDB/ObjectWrapper>
+#include <osgDB/OutputStream>
 #include <osgDB/Registry>
 
 #include <components/nifosg/fog.hpp>
@@ -122,6 +126,31 @@ namespace SceneUtil
             : osgDB::ObjectWrapper(createInstanceFunc<NifOsg::MatrixTransform>, "NifOsg::MatrixTransform",
                 "osg::Object osg::Node osg::Group osg::Transform osg::MatrixTransform NifOsg::MatrixTransform")
         {
+            addSerializer(new osgDB::UserSerializer<NifOsg::MatrixTransform>(
+                              "ScaleRotation", &checkScaleRotation, &readScaleRotation, &writeScaleRotation),
+                osgDB::BaseSerializer::RW_USER);
+        }
+
+    private:
+        static bool checkScaleRotation(const NifOsg::MatrixTransform& /*node*/) { return true; }
+
+        static bool readScaleRotation(osgDB::InputStream& stream, NifOsg::MatrixTransform& node)
+        {
+            stream >> node.mScale;
+            for (auto& row : node.mRotationScale.mValues)
+                for (float& value : row)
+                    stream >> value;
+            return true;
+        }
+
+        static bool writeScaleRotation(osgDB::OutputStream& stream, const NifOsg::MatrixTransform& node)
+        {
+            stream << node.mScale;
+            for (const auto& row : node.mRotationScale.mValues)
+                for (const float value : row)
+                    stream << value;
+            stream << std::endl;
+            return true;
         }
     };
 
@@ -163,11 +192,32 @@ namespace SceneUtil
         }
     };
 
+    static std::atomic_bool sGeometryDataSerialized{ true };
+
+    void registerLosslessSerializers()
+    {
+        static const bool done = [] {
+            osgDB::ObjectWrapperManager* mgr = osgDB::Registry::instance()->getObjectWrapperManager();
+            mgr->addWrapper(new MatrixTransformSerializer);
+            mgr->addWrapper(new FogSerializer);
+            mgr->addWrapper(new TextureTypeSerializer);
+            return true;
+        }();
+        static_cast<void>(done);
+    }
+
+    bool isGeometryDataSerialized()
+    {
+        return sGeometryDataSerialized;
+    }
+
     void registerSerializers()
     {
         static bool done = false;
         if (!done)
         {
+            registerLosslessSerializers();
+
             osgDB::ObjectWrapperManager* mgr = osgDB::Registry::instance()->getObjectWrapperManager();
             mgr->addWrapper(new PositionAttitudeTransformSerializer);
             mgr->addWrapper(new SkeletonSerializer);
@@ -177,12 +227,10 @@ namespace SceneUtil
             mgr->addWrapper(new MorphGeometrySerializer);
             mgr->addWrapper(new LightManagerSerializer);
             mgr->addWrapper(new CameraRelativeTransformSerializer);
-            mgr->addWrapper(new MatrixTransformSerializer);
-            mgr->addWrapper(new FogSerializer);
-            mgr->addWrapper(new TextureTypeSerializer);
 
             // Don't serialize Geometry data as we are more interested in the overall structure rather than tons of
             // vertex data that would make the file large and hard to read.
+            sGeometryDataSerialized = false;
             mgr->removeWrapper(mgr->findWrapper("osg::Geometry"));
             mgr->addWrapper(new GeometrySerializer);
 
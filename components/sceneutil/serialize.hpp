@@ -5,8 +5,16 @@ namespace SceneUtil
 {
 
     /// Register osg node serializers for certain SceneUtil classes if not already done so
+    /// @note Replaces the osg::Geometry serializer by one skipping all the data to produce a readable scene structure.
     void registerSerializers();
 
+    /// Register serializers for SceneUtil and NifOsg classes that preserve all data required to read the object back
+    /// if not already done so. Standard OSG serializers are kept intact.
+    void registerLosslessSerializers();
+
+    /// False once registerSerializers is called.
+    bool isGeometryDataSerialized();
+
 }
 
 #endif
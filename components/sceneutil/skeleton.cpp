@@ -2,13 +2,20 @@
 
 #include <osg/MatrixTransform>
 
-#include <components/debug/debuglog.hpp>
+#include <osgUtil/CullVisitor>
+
 #include <components/misc/strings/lower.hpp>
 
 #include <algorithm>
 
+#include "animationlod.hpp"
+
 namespace SceneUtil
 {
+    namespace
+    {
+        osg::ref_ptr<AnimationLod> sAnimationLod;
+    }
 
     class InitBoneCacheVisitor : public osg::NodeVisitor
     {
@@ -52,7 +59,7 @@ namespace SceneUtil
     {
     }
 
-    Bone* Skeleton::getBone(const std::string& name)
+    std::optional<std::size_t> Skeleton::getBoneIndex(const std::string& name)
     {
         if (!mBoneCacheInit)
         {
@@ -63,33 +70,27 @@ namespace SceneUtil
 
         BoneCache::iterator found = mBoneCache.find(Misc::StringUtils::lowerCase(name));
         if (found == mBoneCache.end())
-            return nullptr;
+            return std::nullopt;
 
-        // find or insert in the bone hierarchy
-
-        if (!mRootBone.get())
-        {
-            mRootBone = std::make_unique<Bone>();
-        }
+        // find or insert the bone with all its parents
 
-        Bone* bone = mRootBone.get();
+        std::size_t index = sNoParent;
         for (osg::MatrixTransform* matrixTransform : found->second)
         {
-            const auto it = std::find_if(bone->mChildren.begin(), bone->mChildren.end(),
-                [&](const auto& v) { return v->mNode == matrixTransform; });
+            const std::size_t parent = index;
+            const auto [it, inserted] = mBoneIndices.emplace(matrixTransform, mBoneNodes.size());
+            index = it->second;
 
-            if (it == bone->mChildren.end())
+            if (inserted)
             {
-                bone = bone->mChildren.emplace_back(std::make_unique<Bone>()).get();
+                mBoneNodes.push_back(matrixTransform);
+                mBoneParents.push_back(parent);
+                mBoneMatrices.emplace_back();
                 mNeedToUpdateBoneMatrices = true;
             }
-            else
-                bone = it->get();
-
-            bone->mNode = matrixTransform;
         }
 
-        return bone;
+        return index;
     }
 
     void Skeleton::updateBoneMatrices(unsigned int traversalNumber)
@@ -101,10 +102,15 @@ namespace SceneUtil
 
         if (mNeedToUpdateBoneMatrices)
         {
-            if (mRootBone.get())
+            // Parents are updated before their children
+            for (std::size_t i = 0; i < mBoneNodes.size(); ++i)
             {
-                for (const auto& child : mRootBone->mChildren)
-                    child->update(nullptr);
+                const osg::Matrixf local(mBoneNodes[i]->getMatrix());
+                const std::size_t parent = mBoneParents[i];
+                if (parent == sNoParent)
+                    mBoneMatrices[i] = local;
+                else
+                    mBoneMatrices[i].mult(local, mBoneMatrices[parent]);
             }
 
             mNeedToUpdateBoneMatrices = false;
@@ -121,6 +127,11 @@ namespace SceneUtil
         return mActive != Inactive;
     }
 
+    void Skeleton::setAnimationLod(osg::ref_ptr<AnimationLod> lod)
+    {
+        sAnimationLod = std::move(lod);
+    }
+
     void Skeleton::markDirty()
     {
         mLastFrameNumber = 0;
@@ -136,9 +147,25 @@ namespace SceneUtil
                 return;
             if (mActive == SemiActive && mLastFrameNumber != 0 && mLastCullFrameNumber + 3 <= nv.getTraversalNumber())
                 return;
+            if (mActive == SemiActive && mLastFrameNumber != 0 && sAnimationLod != nullptr)
+            {
+                const unsigned int interval = sAnimationLod->getUpdateInterval(mPixelSize);
+                const bool skip = nv.getTraversalNumber() < mLastUpdateFrameNumber + interval;
+                sAnimationLod->record(nv.getTraversalNumber(), skip);
+                if (skip)
+                    return;
+            }
+            mLastUpdateFrameNumber = nv.getTraversalNumber();
         }
         else if (nv.getVisitorType() == osg::NodeVisitor::CULL_VISITOR)
+        {
+            const float pixelSize = static_cast<osgUtil::CullVisitor&>(nv).clampedPixelSize(getBound());
+            if (mLastCullFrameNumber != nv.getTraversalNumber())
+                mPixelSize = pixelSize;
+            else
+                mPixelSize = std::max(mPixelSize, pixelSize);
             mLastCullFrameNumber = nv.getTraversalNumber();
+        }
 
         osg::Group::traverse(nv);
     }
@@ -153,25 +180,4 @@ namespace SceneUtil
         markDirty();
     }
 
-    Bone::Bone()
-        : mNode(nullptr)
-    {
-    }
-
-    void Bone::update(const osg::Matrixf* parentMatrixInSkeletonSpace)
-    {
-        if (!mNode)
-        {
-            Log(Debug::Error) << "Error: Bone without node";
-            return;
-        }
-        if (parentMatrixInSkeletonSpace)
-            mMatrixInSkeletonSpace = mNode->getMatrix() * (*parentMatrixInSkeletonSpace);
-        else
-            mMatrixInSkeletonSpace = mNode->getMatrix();
-
-        for (const auto& child : mChildren)
-            child->update(&mMatrixInSkeletonSpace);
-    }
-
 }
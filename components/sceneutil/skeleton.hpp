@@ -3,28 +3,15 @@
 
 #include <osg/Group>
 
-#include <memory>
+#include <cstddef>
+#include <optional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace SceneUtil
 {
-
-    /// @brief Defines a Bone hierarchy, used for updating of skeleton-space bone matrices.
-    /// @note To prevent unnecessary updates, only bones that are used for skinning will be added to this hierarchy.
-    class Bone
-    {
-    public:
-        Bone();
-
-        osg::Matrixf mMatrixInSkeletonSpace;
-
-        osg::MatrixTransform* mNode;
-
-        std::vector<std::unique_ptr<Bone>> mChildren;
-
-        /// Update the skeleton-space matrix of this bone and all its children.
-        void update(const osg::Matrixf* parentMatrixInSkeletonSpace);
-    };
+    class AnimationLod;
 
     /// @brief Handles the bone matrices for any number of child RigGeometries.
     /// @par Bones should be created as osg::MatrixTransform children of the skeleton.
@@ -37,12 +24,17 @@ namespace SceneUtil
 
         META_Node(SceneUtil, Skeleton)
 
-        /// Retrieve a bone by name.
-        Bone* getBone(const std::string& name);
+        /// Retrieve a bone by name and add it with its parents to the updated bones. Should be done once when a bone
+        /// user is attached.
+        /// @return index of the bone in getBoneMatrices(), std::nullopt if there is no such bone
+        std::optional<std::size_t> getBoneIndex(const std::string& name);
 
         /// Request an update of bone matrices. May be a no-op if already updated in this frame.
         void updateBoneMatrices(unsigned int traversalNumber);
 
+        /// Skeleton-space matrices of the bones, valid after updateBoneMatrices().
+        const std::vector<osg::Matrixf>& getBoneMatrices() const { return mBoneMatrices; }
+
         enum ActiveType
         {
             Inactive = 0,
@@ -56,6 +48,13 @@ namespace SceneUtil
 
         bool getActive() const;
 
+        /// Update semi active skeletons small on the screen less often, nullptr to disable.
+        /// @note Not thread safe, should be set before rendering.
+        static void setAnimationLod(osg::ref_ptr<AnimationLod> lod);
+
+        /// Frame number of the last update traversal of the bones and their controllers.
+        unsigned int getLastUpdateFrameNumber() const { return mLastUpdateFrameNumber; }
+
         void traverse(osg::NodeVisitor& nv) override;
 
         void markDirty();
@@ -64,9 +63,14 @@ namespace SceneUtil
         void childRemoved(unsigned int, unsigned int) override;
 
     private:
-        // The root bone is not a "real" bone, it has no corresponding node in the scene graph.
-        // As far as the scene graph goes we support multiple root bones.
-        std::unique_ptr<Bone> mRootBone;
+        static constexpr std::size_t sNoParent = static_cast<std::size_t>(-1);
+
+        // To prevent unnecessary updates, only bones that are used for skinning are added. Bones are ordered so that
+        // parents go before their children to update the matrices in a single pass. There may be many root bones.
+        std::vector<osg::MatrixTransform*> mBoneNodes;
+        std::vector<std::size_t> mBoneParents;
+        std::vector<osg::Matrixf> mBoneMatrices;
+        std::unordered_map<const osg::MatrixTransform*, std::size_t> mBoneIndices;
 
         typedef std::unordered_map<std::string, std::vector<osg::MatrixTransform*>> BoneCache;
         BoneCache mBoneCache;
@@ -78,6 +82,9 @@ namespace SceneUtil
 
         unsigned int mLastFrameNumber;
         unsigned int mLastCullFrameNumber;
+        unsigned int mLastUpdateFrameNumber = 0;
+        // The largest size on the screen among the cull traversals of the last culled frame
+        float mPixelSize = 0;
     };
 
 }
@@ -0,0 +1,181 @@
+#include "skinning.hpp"
+
+#include <algorithm>
+#include <array>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define OPENMW_SKINNING_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define OPENMW_SKINNING_NEON
+#endif
+
+namespace SceneUtil
+{
+    namespace
+    {
+        // Minimal 4 floats vector on top of SSE or NEON with a scalar fallback
+        struct Float4
+        {
+#if defined(OPENMW_SKINNING_SSE)
+            __m128 mValue;
+
+            static Float4 load(const float* values) { return { _mm_loadu_ps(values) }; }
+
+            static Float4 splat(float value) { return { _mm_set1_ps(value) }; }
+
+            void store(float* values) const { _mm_storeu_ps(values, mValue); }
+
+            friend Float4 operator+(Float4 l, Float4 r) { return { _mm_add_ps(l.mValue, r.mValue) }; }
+
+            friend Float4 operator*(Float4 l, Float4 r) { return { _mm_mul_ps(l.mValue, r.mValue) }; }
+#elif defined(OPENMW_SKINNING_NEON)
+            float32x4_t mValue;
+
+            static Float4 load(const float* values) { return { vld1q_f32(values) }; }
+
+            static Float4 splat(float value) { return { vdupq_n_f32(value) }; }
+
+            void store(float* values) const { vst1q_f32(values, mValue); }
+
+            friend Float4 operator+(Float4 l, Float4 r) { return { vaddq_f32(l.mValue, r.mValue) }; }
+
+            friend Float4 operator*(Float4 l, Float4 r) { return { vmulq_f32(l.mValue, r.mValue) }; }
+#else
+            std::array<float, 4> mValue;
+
+            static Float4 load(const float* values) { return { { values[0], values[1], values[2], values[3] } }; }
+
+            static Float4 splat(float value) { return { { value, value, value, value } }; }
+
+            void store(float* values) const { std::copy(mValue.begin(), mValue.end(), values); }
+
+            friend Float4 operator+(Float4 l, Float4 r)
+            {
+                return { { l.mValue[0] + r.mValue[0], l.mValue[1] + r.mValue[1], l.mValue[2] + r.mValue[2],
+                    l.mValue[3] + r.mValue[3] } };
+            }
+
+            friend Float4 operator*(Float4 l, Float4 r)
+            {
+                return { { l.mValue[0] * r.mValue[0], l.mValue[1] * r.mValue[1], l.mValue[2] * r.mValue[2],
+                    l.mValue[3] * r.mValue[3] } };
+            }
+#endif
+        };
+
+        // Rows of osg::Matrixf, a row vector is multiplied by the matrix on the left
+        struct Rows
+        {
+            std::array<Float4, 4> mRows;
+
+            explicit Rows(const osg::Matrixf& matrix)
+            {
+                for (std::size_t i = 0; i < mRows.size(); ++i)
+                    mRows[i] = Float4::load(matrix.ptr() + i * 4);
+            }
+
+            // Same as osg::Matrixf::transform3x3
+            Float4 transform3x3(const osg::Vec3f& v) const
+            {
+                return Float4::splat(v.x()) * mRows[0] + Float4::splat(v.y()) * mRows[1]
+                    + Float4::splat(v.z()) * mRows[2];
+            }
+
+            // Same as osg::Matrixf::preMult for an affine matrix
+            Float4 transformAffine(const osg::Vec3f& v) const { return transform3x3(v) + mRows[3]; }
+        };
+
+        osg::Matrixf blendBoneMatrices(
+            const std::vector<std::pair<std::size_t, float>>& boneWeights, std::span<const osg::Matrixf> boneMatrices)
+        {
+            std::array<Float4, 4> rows;
+            rows.fill(Float4::splat(0));
+
+            for (const auto& [index, weight] : boneWeights)
+            {
+                const float* const boneMatrix = boneMatrices[index].ptr();
+                const Float4 boneWeight = Float4::splat(weight);
+                for (std::size_t i = 0; i < rows.size(); ++i)
+                    rows[i] = rows[i] + Float4::load(boneMatrix + i * 4) * boneWeight;
+            }
+
+            std::array<float, 16> result;
+            for (std::size_t i = 0; i < rows.size(); ++i)
+                rows[i].store(result.data() + i * 4);
+
+            // Bone matrices are affine, keep the last column exact
+            result[3] = 0;
+            result[7] = 0;
+            result[11] = 0;
+            result[15] = 1;
+
+            return osg::Matrixf(result.data());
+        }
+
+        // Source and destination vertices are 3 floats, only the first 3 lanes are read and written
+        void transformPositions(
+            const Rows& rows, std::span<const unsigned short> vertices, const osg::Vec3f* src, osg::Vec3f* dst)
+        {
+            std::array<float, 4> result;
+            for (const unsigned short vertex : vertices)
+            {
+                rows.transformAffine(src[vertex]).store(result.data());
+                dst[vertex].set(result[0], result[1], result[2]);
+            }
+        }
+
+        void transformNormals(
+            const Rows& rows, std::span<const unsigned short> vertices, const osg::Vec3f* src, osg::Vec3f* dst)
+        {
+            std::array<float, 4> result;
+            for (const unsigned short vertex : vertices)
+            {
+                rows.transform3x3(src[vertex]).store(result.data());
+                dst[vertex].set(result[0], result[1], result[2]);
+            }
+        }
+
+        void transformTangents(
+            const Rows& rows, std::span<const unsigned short> vertices, const osg::Vec4f* src, osg::Vec4f* dst)
+        {
+            std::array<float, 4> result;
+            for (const unsigned short vertex : vertices)
+            {
+                const osg::Vec4f& v = src[vertex];
+                rows.transform3x3(osg::Vec3f(v.x(), v.y(), v.z())).store(result.data());
+                dst[vertex] = osg::Vec4f(result[0], result[1], result[2], v.w());
+            }
+        }
+    }
+
+    void skin(std::span<const SkinningInfluence> influences, std::span<const osg::Matrixf> boneMatrices,
+        const osg::Matrixf* geomToSkelMatrix, const SkinningArrays& arrays)
+    {
+        const osg::Vec3f* const sourcePositions = arrays.mSourcePositions->asVector().data();
+        osg::Vec3f* const positions = arrays.mPositions->asVector().data();
+        const bool normals = arrays.mSourceNormals != nullptr && arrays.mNormals != nullptr;
+        const bool tangents = arrays.mSourceTangents != nullptr && arrays.mTangents != nullptr;
+
+        for (const SkinningInfluence& influence : influences)
+        {
+            osg::Matrixf matrix = blendBoneMatrices(influence.mBoneWeights, boneMatrices);
+
+            if (geomToSkelMatrix != nullptr)
+                matrix *= *geomToSkelMatrix;
+
+            const Rows rows(matrix);
+
+            transformPositions(rows, influence.mVertices, sourcePositions, positions);
+
+            if (normals)
+                transformNormals(rows, influence.mVertices, arrays.mSourceNormals->asVector().data(),
+                    arrays.mNormals->asVector().data());
+
+            if (tangents)
+                transformTangents(rows, influence.mVertices, arrays.mSourceTangents->asVector().data(),
+                    arrays.mTangents->asVector().data());
+        }
+    }
+}
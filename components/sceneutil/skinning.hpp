@@ -0,0 +1,39 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+#define OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+
+#include <osg/Array>
+#include <osg/Matrixf>
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace SceneUtil
+{
+    /// Vertices influenced by the same bones with the same weights
+    struct SkinningInfluence
+    {
+        std::vector<std::pair<std::size_t, float>> mBoneWeights;
+        std::vector<unsigned short> mVertices;
+    };
+
+    struct SkinningArrays
+    {
+        const osg::Vec3Array* mSourcePositions = nullptr;
+        const osg::Vec3Array* mSourceNormals = nullptr;
+        const osg::Vec4Array* mSourceTangents = nullptr;
+        osg::Vec3Array* mPositions = nullptr;
+        osg::Vec3Array* mNormals = nullptr;
+        osg::Vec4Array* mTangents = nullptr;
+    };
+
+    /// @brief Blend matrices of the bones for each influence and transform its vertices
+    /// @param boneMatrices affine transformations from bind pose to skeleton space, zero for missing bones
+    /// @param geomToSkelMatrix applied after the blended bone matrix when not null
+    /// @note Normals and tangents are transformed only when both source and destination arrays are given.
+    void skin(std::span<const SkinningInfluence> influences, std::span<const osg::Matrixf> boneMatrices,
+        const osg::Matrixf* geomToSkelMatrix, const SkinningArrays& arrays);
+}
+
+#endif
@@ -0,0 +1,160 @@
+#include "skinningcache.hpp"
+
+#include <components/misc/hash.hpp>
+
+#include <osg/Stats>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        std::string_view asBytes(std::span<const osg::Matrixf> matrices)
+        {
+            return std::string_view(reinterpret_cast<const char*>(matrices.data()), matrices.size_bytes());
+        }
+
+        bool isSameMatrix(const std::optional<osg::Matrixf>& lhs, const std::optional<osg::Matrixf>& rhs)
+        {
+            if (!lhs.has_value() || !rhs.has_value())
+                return lhs.has_value() == rhs.has_value();
+            return asBytes(std::span(&*lhs, 1)) == asBytes(std::span(&*rhs, 1));
+        }
+
+        template <class T>
+        void copyArray(const osg::ref_ptr<T>& src, const osg::ref_ptr<T>& dst)
+        {
+            if (src == nullptr || dst == nullptr)
+                return;
+            std::copy(src->begin(), src->end(), dst->begin());
+            dst->dirty();
+        }
+
+        void copyArrays(const SkinnedArrays& src, const SkinnedArrays& dst)
+        {
+            copyArray(src.mPositions, dst.mPositions);
+            copyArray(src.mNormals, dst.mNormals);
+            copyArray(src.mTangents, dst.mTangents);
+        }
+    }
+
+    SkinningResult::SkinningResult(osg::ref_ptr<const osg::Referenced> holder,
+        std::span<const SkinningInfluence> influences, std::vector<osg::Matrixf>&& boneMatrices,
+        const std::optional<osg::Matrixf>& geomToSkelMatrix, const SkinningArrays& arrays)
+        : mHolder(std::move(holder))
+        , mInfluences(influences)
+        , mBoneMatrices(std::move(boneMatrices))
+        , mGeomToSkelMatrix(geomToSkelMatrix)
+        , mArrays(arrays)
+        , mSourcePositions(arrays.mSourcePositions)
+        , mSourceNormals(arrays.mSourceNormals)
+        , mSourceTangents(arrays.mSourceTangents)
+        , mSkinnedArrays{ arrays.mPositions, arrays.mNormals, arrays.mTangents }
+        , mHash(std::hash<std::string_view>()(asBytes(mBoneMatrices)))
+    {
+        Misc::hashCombine(mHash, mInfluences.data());
+        Misc::hashCombine(mHash, arrays.mSourcePositions);
+        if (mGeomToSkelMatrix.has_value())
+            Misc::hashCombine(mHash, std::hash<std::string_view>()(asBytes(std::span(&*mGeomToSkelMatrix, 1))));
+    }
+
+    void SkinningResult::doWork()
+    {
+        skin(mInfluences, mBoneMatrices, mGeomToSkelMatrix ? &*mGeomToSkelMatrix : nullptr, mArrays);
+
+        mSkinnedArrays.mPositions->dirty();
+        if (mSkinnedArrays.mNormals != nullptr)
+            mSkinnedArrays.mNormals->dirty();
+        if (mSkinnedArrays.mTangents != nullptr)
+            mSkinnedArrays.mTangents->dirty();
+
+        std::vector<SkinnedArrays> pending;
+        {
+            const std::lock_guard lock(mMutex);
+            mSkinned = true;
+            pending.swap(mPending);
+        }
+
+        for (const SkinnedArrays& arrays : pending)
+            copyArrays(mSkinnedArrays, arrays);
+    }
+
+    bool SkinningResult::share(const SkinnedArrays& arrays)
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            if (!mSkinned)
+            {
+                mPending.push_back(arrays);
+                return false;
+            }
+        }
+
+        copyArrays(mSkinnedArrays, arrays);
+        return true;
+    }
+
+    bool SkinningResult::isSame(const SkinningResult& other) const
+    {
+        return mInfluences.data() == other.mInfluences.data() && mInfluences.size() == other.mInfluences.size()
+            && mSourcePositions == other.mSourcePositions && mSourceNormals == other.mSourceNormals
+            && mSourceTangents == other.mSourceTangents && asBytes(mBoneMatrices) == asBytes(other.mBoneMatrices)
+            && isSameMatrix(mGeomToSkelMatrix, other.mGeomToSkelMatrix);
+    }
+
+    osg::ref_ptr<SkinningResult> SkinningCache::get(
+        unsigned int frameNumber, const osg::ref_ptr<SkinningResult>& result)
+    {
+        const std::lock_guard lock(mMutex);
+
+        rollOver(frameNumber);
+
+        ++mStats.mGet;
+
+        const auto [begin, end] = mResults.equal_range(result->getHash());
+        for (auto it = begin; it != end; ++it)
+        {
+            if (it->second->isSame(*result))
+            {
+                ++mStats.mHit;
+                return it->second;
+            }
+        }
+
+        mResults.emplace(result->getHash(), result);
+        return nullptr;
+    }
+
+    SkinningCacheStats SkinningCache::getStats() const
+    {
+        const std::lock_guard lock(mMutex);
+        return mLastStats;
+    }
+
+    void SkinningCache::reportStats(unsigned int frameNumber, osg::Stats& stats)
+    {
+        SkinningCacheStats cacheStats;
+        {
+            const std::lock_guard lock(mMutex);
+            rollOver(frameNumber);
+            cacheStats = mLastStats;
+        }
+        stats.setAttribute(frameNumber, "Skinning Get", static_cast<double>(cacheStats.mGet));
+        stats.setAttribute(frameNumber, "Skinning Hit", static_cast<double>(cacheStats.mHit));
+    }
+
+    void SkinningCache::rollOver(unsigned int frameNumber)
+    {
+        if (frameNumber == mFrameNumber)
+            return;
+        // Nothing is requested in the previous frame when the last request is older
+        mLastStats = frameNumber == mFrameNumber + 1 ? mStats : SkinningCacheStats{};
+        mStats = SkinningCacheStats{};
+        mResults.clear();
+        mFrameNumber = frameNumber;
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_SKINNINGCACHE_H
+#define OPENMW_COMPONENTS_SCENEUTIL_SKINNINGCACHE_H
+
+#include "skinning.hpp"
+#include "workqueue.hpp"
+
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace SceneUtil
+{
+    /// Destination arrays of skinning, kept alive until they are filled
+    struct SkinnedArrays
+    {
+        osg::ref_ptr<osg::Vec3Array> mPositions;
+        osg::ref_ptr<osg::Vec3Array> mNormals;
+        osg::ref_ptr<osg::Vec4Array> mTangents;
+    };
+
+    /// @brief Skinning of a geometry in a pose, done either by a WorkQueue or by calling doWork() and signalDone().
+    /// @par The result may be shared with other geometries having the same source and pose.
+    class SkinningResult final : public WorkItem
+    {
+    public:
+        /// @param holder keeps influences alive
+        SkinningResult(osg::ref_ptr<const osg::Referenced> holder, std::span<const SkinningInfluence> influences,
+            std::vector<osg::Matrixf>&& boneMatrices, const std::optional<osg::Matrixf>& geomToSkelMatrix,
+            const SkinningArrays& arrays);
+
+        void doWork() override;
+
+        /// Copy the result into the given arrays now if it's ready or right after skinning otherwise.
+        /// @return true when the arrays are filled, otherwise waitTillDone() has to be called before using them
+        bool share(const SkinnedArrays& arrays);
+
+        std::size_t getHash() const { return mHash; }
+
+        /// Whether the result is the same for the given skinning
+        bool isSame(const SkinningResult& other) const;
+
+    private:
+        osg::ref_ptr<const osg::Referenced> mHolder;
+        std::span<const SkinningInfluence> mInfluences;
+        std::vector<osg::Matrixf> mBoneMatrices;
+        std::optional<osg::Matrixf> mGeomToSkelMatrix;
+        SkinningArrays mArrays;
+        osg::ref_ptr<const osg::Vec3Array> mSourcePositions;
+        osg::ref_ptr<const osg::Vec3Array> mSourceNormals;
+        osg::ref_ptr<const osg::Vec4Array> mSourceTangents;
+        SkinnedArrays mSkinnedArrays;
+        std::size_t mHash;
+        std::mutex mMutex;
+        bool mSkinned = false;
+        std::vector<SkinnedArrays> mPending;
+    };
+
+    struct SkinningCacheStats
+    {
+        std::size_t mGet = 0;
+        std::size_t mHit = 0;
+    };
+
+    /// @brief Skinning results of the current frame shared between rig geometries in the same pose, like NPCs playing
+    /// the same animation at the same time.
+    /// @note Thread safe. Results are kept only for a single frame.
+    class SkinningCache : public osg::Referenced
+    {
+    public:
+        /// @return previously added result for the same source and pose in this frame or nullptr after adding the given
+        /// one
+        osg::ref_ptr<SkinningResult> get(unsigned int frameNumber, const osg::ref_ptr<SkinningResult>& result);
+
+        /// Stats of the last complete frame
+        SkinningCacheStats getStats() const;
+
+        /// Report stats of the frame before the given one, zero when nothing was requested in it
+        void reportStats(unsigned int frameNumber, osg::Stats& stats);
+
+    private:
+        mutable std::mutex mMutex;
+        unsigned int mFrameNumber = 0;
+        std::unordered_multimap<std::size_t, osg::ref_ptr<SkinningResult>> mResults;
+        SkinningCacheStats mStats;
+        SkinningCacheStats mLastStats;
+
+        void rollOver(unsigned int frameNumber);
+    };
+}
+
+#endif
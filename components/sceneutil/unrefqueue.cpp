@@ -25,8 +25,9 @@ namespace SceneUtil
             return;
 
         // Move only objects to keep allocated storage in mObjects
-        workQueue.addWorkItem(new ClearVector(std::vector<osg::ref_ptr<osg::Referenced>>(
-            std::move_iterator(mObjects.begin()), std::move_iterator(mObjects.end()))));
+        std::vector<osg::ref_ptr<osg::Referenced>> objects(
+            std::move_iterator(mObjects.begin()), std::move_iterator(mObjects.end()));
+        workQueue.addWorkItem(new ClearVector(std::move(objects)), WorkPriority::Low);
         mObjects.clear();
     }
 }
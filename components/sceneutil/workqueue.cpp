@@ -2,10 +2,19 @@
 
 #include <components/debug/debuglog.hpp>
 
+#include <osg/Stats>
+
+#include <algorithm>
 #include <numeric>
 
 namespace SceneUtil
 {
+    namespace
+    {
+        // Allows items added from a worker thread to stay in the queue of this thread
+        thread_local const WorkQueue* currentWorkQueue = nullptr;
+        thread_local std::size_t currentThreadIndex = 0;
+    }
 
     void WorkItem::waitTillDone()
     {
@@ -33,10 +42,25 @@ namespace SceneUtil
         return mDone;
     }
 
+    void WorkItem::cancel()
+    {
+        mCancelled = true;
+        abort();
+    }
+
+    bool WorkItem::isCancelled() const
+    {
+        return mCancelled;
+    }
+
     WorkQueue::WorkQueue(std::size_t workerThreads)
         : mIsReleased(false)
     {
-        start(workerThreads);
+        // Queues have to be created before any thread is started because threads access them without a lock
+        for (std::size_t i = 0; i < std::max<std::size_t>(workerThreads, 1); ++i)
+            mQueues.push_back(std::make_unique<ThreadQueue>());
+        for (std::size_t i = 0; i < workerThreads; ++i)
+            mThreads.emplace_back(std::make_unique<WorkThread>(*this, i));
     }
 
     WorkQueue::~WorkQueue()
@@ -44,22 +68,20 @@ namespace SceneUtil
         stop();
     }
 
-    void WorkQueue::start(std::size_t workerThreads)
+    void WorkQueue::stop()
     {
+        for (const std::unique_ptr<ThreadQueue>& queue : mQueues)
         {
-            const std::lock_guard lock(mMutex);
-            mIsReleased = false;
+            const std::lock_guard lock(queue->mMutex);
+            for (std::deque<osg::ref_ptr<WorkItem>>& items : queue->mItems)
+            {
+                mNumItems -= items.size();
+                items.clear();
+            }
         }
-        while (mThreads.size() < workerThreads)
-            mThreads.emplace_back(std::make_unique<WorkThread>(*this));
-    }
 
-    void WorkQueue::stop()
-    {
         {
             std::unique_lock<std::mutex> lock(mMutex);
-            while (!mQueue.empty())
-                mQueue.pop_back();
             mIsReleased = true;
             mCondition.notify_all();
         }
@@ -67,7 +89,7 @@ namespace SceneUtil
         mThreads.clear();
     }
 
-    void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, bool front)
+    void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, WorkPriority priority)
     {
         if (item->isDone())
         {
@@ -75,34 +97,90 @@ namespace SceneUtil
             return;
         }
 
-        std::unique_lock<std::mutex> lock(mMutex);
-        if (front)
-            mQueue.push_front(std::move(item));
-        else
-            mQueue.push_back(std::move(item));
+        {
+            // Counter is incremented before the item can be taken to never underflow, and under the lock to not miss
+            // a thread going to sleep
+            const std::lock_guard lock(mMutex);
+            ++mNumItems;
+        }
+
+        ThreadQueue& queue = *mQueues[getQueueIndex()];
+        {
+            const std::lock_guard lock(queue.mMutex);
+            queue.mItems[static_cast<std::size_t>(priority)].push_back(std::move(item));
+        }
+
         mCondition.notify_one();
     }
 
-    osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem()
+    osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem(std::size_t threadIndex)
     {
-        std::unique_lock<std::mutex> lock(mMutex);
-        while (mQueue.empty() && !mIsReleased)
+        while (true)
         {
-            mCondition.wait(lock);
+            if (osg::ref_ptr<WorkItem> item = takeWorkItem(threadIndex))
+            {
+                if (!item->isCancelled())
+                    return item;
+                ++mCancelled;
+                item->signalDone();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mMutex);
+            while (mNumItems == 0 && !mIsReleased)
+            {
+                mCondition.wait(lock);
+            }
+            if (mIsReleased)
+                return nullptr;
         }
-        if (!mQueue.empty())
+    }
+
+    osg::ref_ptr<WorkItem> WorkQueue::takeWorkItem(std::size_t threadIndex)
+    {
+        for (std::size_t priority = sPrioritiesCount; priority-- > 0;)
         {
-            osg::ref_ptr<WorkItem> item = std::move(mQueue.front());
-            mQueue.pop_front();
-            return item;
+            {
+                ThreadQueue& own = *mQueues[threadIndex];
+                const std::lock_guard lock(own.mMutex);
+                std::deque<osg::ref_ptr<WorkItem>>& items = own.mItems[priority];
+                if (!items.empty())
+                {
+                    osg::ref_ptr<WorkItem> item = std::move(items.front());
+                    items.pop_front();
+                    --mNumItems;
+                    return item;
+                }
+            }
+
+            for (std::size_t i = 1; i < mQueues.size(); ++i)
+            {
+                ThreadQueue& other = *mQueues[(threadIndex + i) % mQueues.size()];
+                const std::lock_guard lock(other.mMutex);
+                std::deque<osg::ref_ptr<WorkItem>>& items = other.mItems[priority];
+                if (!items.empty())
+                {
+                    osg::ref_ptr<WorkItem> item = std::move(items.back());
+                    items.pop_back();
+                    --mNumItems;
+                    ++mStolen;
+                    return item;
+                }
+            }
         }
         return nullptr;
     }
 
+    std::size_t WorkQueue::getQueueIndex() const
+    {
+        if (currentWorkQueue == this)
+            return currentThreadIndex;
+        return mNextQueue.fetch_add(1, std::memory_order_relaxed) % mQueues.size();
+    }
+
     unsigned int WorkQueue::getNumItems() const
     {
-        std::unique_lock<std::mutex> lock(mMutex);
-        return mQueue.size();
+        return static_cast<unsigned int>(mNumItems);
     }
 
     unsigned int WorkQueue::getNumActiveThreads() const
@@ -111,8 +189,17 @@ namespace SceneUtil
             mThreads.begin(), mThreads.end(), 0u, [](auto r, const auto& t) { return r + t->isActive(); });
     }
 
-    WorkThread::WorkThread(WorkQueue& workQueue)
+    void WorkQueue::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "WorkQueue", getNumItems());
+        stats.setAttribute(frameNumber, "WorkThread", getNumActiveThreads());
+        stats.setAttribute(frameNumber, "WorkQueue Stolen", static_cast<double>(mStolen));
+        stats.setAttribute(frameNumber, "WorkQueue Cancelled", static_cast<double>(mCancelled));
+    }
+
+    WorkThread::WorkThread(WorkQueue& workQueue, std::size_t index)
         : mWorkQueue(&workQueue)
+        , mIndex(index)
         , mActive(false)
         , mThread([this] { run(); })
     {
@@ -125,9 +212,11 @@ namespace SceneUtil
 
     void WorkThread::run()
     {
+        currentWorkQueue = mWorkQueue;
+        currentThreadIndex = mIndex;
         while (true)
         {
-            osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem();
+            osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem(mIndex);
             if (!item)
                 return;
             mActive = true;
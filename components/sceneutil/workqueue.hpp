@@ -4,15 +4,30 @@
 #include <osg/Referenced>
 #include <osg/ref_ptr>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace SceneUtil
 {
+    enum class WorkPriority : std::uint8_t
+    {
+        Low, ///< Work that is fine to be late, e.g. distant terrain or deallocation.
+        Normal,
+        High, ///< Work the player is going to wait for soon, e.g. preloading the next cell.
+    };
 
     class WorkItem : public osg::Referenced
     {
@@ -31,8 +46,15 @@ namespace SceneUtil
         /// Set abort flag in order to return from doWork() as soon as possible. May not be respected by all WorkItems.
         virtual void abort() {}
 
+        /// The result is not needed anymore. WorkQueue drops the item without calling doWork() if it's not started
+        /// yet, otherwise abort() is called. The item is signaled done in both cases.
+        void cancel();
+
+        bool isCancelled() const;
+
     private:
         std::atomic_bool mDone{ false };
+        std::atomic_bool mCancelled{ false };
         std::mutex mMutex;
         std::condition_variable mCondition;
     };
@@ -40,47 +62,68 @@ namespace SceneUtil
     class WorkThread;
 
     /// @brief A work queue that users can push work items onto, to be completed by one or more background threads.
-    /// @note Work items will be processed in the order that they were given in, however
-    /// if multiple work threads are involved then it is possible for a later item to complete before earlier items.
+    /// @par Each thread has its own queue. Items added by a worker thread go to its queue, other items are distributed
+    /// between the queues. A thread takes the oldest item of the highest priority from its own queue or steals the
+    /// newest one of the same priority from the other queues when its own has nothing to offer, so items of a higher
+    /// priority are always taken before items of a lower priority.
+    /// @note Items of the same priority are processed approximately in the order they were given in. It is possible
+    /// for a later item to complete before earlier items.
     class WorkQueue : public osg::Referenced
     {
     public:
-        WorkQueue(std::size_t workerThreads);
+        explicit WorkQueue(std::size_t workerThreads);
         ~WorkQueue();
 
-        void start(std::size_t workerThreads);
-
         void stop();
 
-        /// Add a new work item to the back of the queue.
+        /// Add a new work item to the queue.
         /// @par The work item's waitTillDone() method may be used by the caller to wait until the work is complete.
-        /// @param front If true, add item to the front of the queue. If false (default), add to the back.
-        void addWorkItem(osg::ref_ptr<WorkItem> item, bool front = false);
+        void addWorkItem(osg::ref_ptr<WorkItem> item, WorkPriority priority = WorkPriority::Normal);
 
-        /// Get the next work item from the front of the queue. If the queue is empty, waits until a new item is added.
+        /// Get the next work item for the thread. If all queues are empty, waits until a new item is added.
+        /// Cancelled items are signaled done and skipped.
         /// If the workqueue is in the process of being destroyed, may return nullptr.
         /// @par Used internally by the WorkThread.
-        osg::ref_ptr<WorkItem> removeWorkItem();
+        osg::ref_ptr<WorkItem> removeWorkItem(std::size_t threadIndex);
 
         unsigned int getNumItems() const;
 
         unsigned int getNumActiveThreads() const;
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
     private:
+        static constexpr std::size_t sPrioritiesCount = static_cast<std::size_t>(WorkPriority::High) + 1;
+
+        struct ThreadQueue
+        {
+            std::mutex mMutex;
+            std::array<std::deque<osg::ref_ptr<WorkItem>>, sPrioritiesCount> mItems;
+        };
+
         bool mIsReleased;
-        std::deque<osg::ref_ptr<WorkItem>> mQueue;
+        std::atomic_size_t mNumItems{ 0 };
+        mutable std::atomic_size_t mNextQueue{ 0 };
+        std::atomic_size_t mStolen{ 0 };
+        std::atomic_size_t mCancelled{ 0 };
+        std::vector<std::unique_ptr<ThreadQueue>> mQueues;
 
+        // Guards only sleeping and waking up the threads, queues have their own locks
         mutable std::mutex mMutex;
         std::condition_variable mCondition;
 
         std::vector<std::unique_ptr<WorkThread>> mThreads;
+
+        std::size_t getQueueIndex() const;
+
+        osg::ref_ptr<WorkItem> takeWorkItem(std::size_t threadIndex);
     };
 
     /// Internally used by WorkQueue.
     class WorkThread
     {
     public:
-        WorkThread(WorkQueue& workQueue);
+        WorkThread(WorkQueue& workQueue, std::size_t index);
 
         ~WorkThread();
 
@@ -88,6 +131,7 @@ namespace SceneUtil
 
     private:
         WorkQueue* mWorkQueue;
+        std::size_t mIndex;
         std::atomic<bool> mActive;
         std::thread mThread;
 
@@ -33,6 +33,10 @@ namespace Settings
         SettingValue<float> mCacheExpiryDelay{ mIndex, "Cells", "cache expiry delay", makeMaxSanitizerFloat(0) };
         SettingValue<float> mTargetFramerate{ mIndex, "Cells", "target framerate", makeMaxStrictSanitizerFloat(0) };
         SettingValue<int> mPointersCacheSize{ mIndex, "Cells", "pointers cache size", makeClampSanitizerInt(40, 1000) };
+        SettingValue<std::uint64_t> mSceneCacheBudget{ mIndex, "Cells", "scene cache budget" };
+        SettingValue<std::uint64_t> mImageCacheBudget{ mIndex, "Cells", "image cache budget" };
+        SettingValue<std::uint64_t> mKeyframeCacheBudget{ mIndex, "Cells", "keyframe cache budget" };
+        SettingValue<std::uint64_t> mBulletShapeCacheBudget{ mIndex, "Cells", "bullet shape cache budget" };
     };
 }
 
@@ -11,6 +11,13 @@ namespace Settings
         using WithIndex::WithIndex;
 
         SettingValue<bool> mLoadUnsupportedNifFiles{ mIndex, "Models", "load unsupported nif files" };
+        SettingValue<bool> mCacheNifTemplates{ mIndex, "Models", "cache nif templates" };
+        SettingValue<int> mSkinningNumThreads{ mIndex, "Models", "skinning num threads", makeMaxSanitizerInt(0) };
+        SettingValue<bool> mShareSkinningResults{ mIndex, "Models", "share skinning results" };
+        SettingValue<float> mAnimationLodPixelSize{ mIndex, "Models", "animation lod pixel size",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<int> mAnimationLodMaxUpdateInterval{ mIndex, "Models", "animation lod max update interval",
+            makeMaxSanitizerInt(1) };
         SettingValue<VFS::Path::Normalized> mXbaseanim{ mIndex, "Models", "xbaseanim" };
         SettingValue<VFS::Path::Normalized> mBaseanim{ mIndex, "Models", "baseanim" };
         SettingValue<VFS::Path::Normalized> mXbaseanim1st{ mIndex, "Models", "xbaseanim1st" };
@@ -43,6 +43,7 @@ namespace Settings
         SettingValue<std::size_t> mAsyncNavMeshUpdaterThreads{ mIndex, "Navigator", "async nav mesh updater threads",
             makeMaxSanitizerSize(1) };
         SettingValue<std::size_t> mMaxNavMeshTilesCacheSize{ mIndex, "Navigator", "max nav mesh tiles cache size" };
+        SettingValue<std::size_t> mMaxHeightfieldsCacheSize{ mIndex, "Navigator", "max heightfields cache size" };
         SettingValue<std::size_t> mMaxPolygonPathSize{ mIndex, "Navigator", "max polygon path size" };
         SettingValue<std::size_t> mMaxSmoothPathSize{ mIndex, "Navigator", "max smooth path size" };
         SettingValue<bool> mEnableWriteRecastMeshToFile{ mIndex, "Navigator", "enable write recast mesh to file" };
@@ -63,6 +64,10 @@ namespace Settings
         SettingValue<bool> mEnableNavMeshDiskCache{ mIndex, "Navigator", "enable nav mesh disk cache" };
         SettingValue<bool> mWriteToNavmeshdb{ mIndex, "Navigator", "write to navmeshdb" };
         SettingValue<std::uint64_t> mMaxNavmeshdbFileSize{ mIndex, "Navigator", "max navmeshdb file size" };
+        SettingValue<int> mNavmeshdbTransactionIntervalMs{ mIndex, "Navigator", "navmeshdb transaction interval ms",
+            makeMaxSanitizerInt(0) };
+        SettingValue<int> mMaxNavmeshdbTransactionSize{ mIndex, "Navigator", "max navmeshdb transaction size",
+            makeMaxSanitizerInt(1) };
         SettingValue<bool> mWaitForAllJobsOnExit{ mIndex, "Navigator", "wait for all jobs on exit" };
     };
 }
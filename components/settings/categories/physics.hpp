@@ -21,6 +21,10 @@ namespace Settings
         SettingValue<int> mAsyncNumThreads{ mIndex, "Physics", "async num threads", makeMaxSanitizerInt(0) };
         SettingValue<int> mLineofsightKeepInactiveCache{ mIndex, "Physics", "lineofsight keep inactive cache",
             makeMaxSanitizerInt(-1) };
+        SettingValue<std::size_t> mRaycastCacheSize{ mIndex, "Physics", "raycast cache size" };
+        SettingValue<std::string> mBroadphase{ mIndex, "Physics", "broadphase",
+            makeEnumSanitizerString({ "dbvt", "sap" }) };
+        SettingValue<bool> mMergeCellStatics{ mIndex, "Physics", "merge cell statics" };
     };
 }
 
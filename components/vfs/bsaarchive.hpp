@@ -9,6 +9,7 @@
 #include <components/bsa/ba2gnrlfile.hpp>
 #include <components/bsa/bsa_file.hpp>
 #include <components/bsa/compressedbsafile.hpp>
+#include <components/debug/debuglog.hpp>
 
 #include <algorithm>
 #include <memory>
@@ -30,6 +31,8 @@ namespace VFS
 
         std::filesystem::path getPath() override { return mInfo->name(); }
 
+        void prefetch() override { mFile->prefetchFile(mInfo); }
+
         const Bsa::BSAFile::FileStruct* mInfo;
         FileType* mFile;
     };
@@ -38,11 +41,26 @@ namespace VFS
     class BsaArchive : public Archive
     {
     public:
-        BsaArchive(const std::filesystem::path& filename)
+        BsaArchive(const std::filesystem::path& filename, bool memoryMapped,
+            std::shared_ptr<Bsa::DecompressedFileCache> decompressedFileCache)
             : Archive()
         {
             mFile = std::make_unique<BSAFileType>();
             mFile->open(filename);
+            mFile->setDecompressedFileCache(std::move(decompressedFileCache));
+
+            if (memoryMapped)
+            {
+                try
+                {
+                    mFile->mapIntoMemory();
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Failed to map BSA archive " << filename
+                                        << " into memory, falling back to file streams: " << e.what();
+                }
+            }
 
             const Bsa::BSAFile::FileList& filelist = mFile->getList();
             for (Bsa::BSAFile::FileList::const_iterator it = filelist.begin(); it != filelist.end(); ++it)
@@ -73,20 +91,25 @@ namespace VFS
         std::vector<VFS::Path::Normalized> mFiles;
     };
 
-    inline std::unique_ptr<VFS::Archive> makeBsaArchive(const std::filesystem::path& path)
+    /// Archives are memory mapped by default only when there is enough address space to map all of them.
+    inline constexpr bool memoryMapBsaArchivesByDefault = sizeof(void*) >= 8;
+
+    inline std::unique_ptr<VFS::Archive> makeBsaArchive(const std::filesystem::path& path,
+        bool memoryMapped = memoryMapBsaArchivesByDefault,
+        std::shared_ptr<Bsa::DecompressedFileCache> decompressedFileCache = nullptr)
     {
         switch (Bsa::BSAFile::detectVersion(path))
         {
             case Bsa::BsaVersion::Unknown:
                 break;
             case Bsa::BsaVersion::Uncompressed:
-                return std::make_unique<BsaArchive<Bsa::BSAFile>>(path);
+                return std::make_unique<BsaArchive<Bsa::BSAFile>>(path, memoryMapped, decompressedFileCache);
             case Bsa::BsaVersion::Compressed:
-                return std::make_unique<BsaArchive<Bsa::CompressedBSAFile>>(path);
+                return std::make_unique<BsaArchive<Bsa::CompressedBSAFile>>(path, memoryMapped, decompressedFileCache);
             case Bsa::BsaVersion::BA2GNRL:
-                return std::make_unique<BsaArchive<Bsa::BA2GNRLFile>>(path);
+                return std::make_unique<BsaArchive<Bsa::BA2GNRLFile>>(path, memoryMapped, decompressedFileCache);
             case Bsa::BsaVersion::BA2DX10:
-                return std::make_unique<BsaArchive<Bsa::BA2DX10File>>(path);
+                return std::make_unique<BsaArchive<Bsa::BA2DX10File>>(path, memoryMapped, decompressedFileCache);
         }
 
         throw std::runtime_error("Unknown archive type '" + Files::pathToUnicodeString(path) + "'");
@@ -15,6 +15,9 @@ namespace VFS
         virtual Files::IStreamPtr open() = 0;
 
         virtual std::filesystem::path getPath() = 0;
+
+        /// Hint that the file will be opened soon. Must not wait for the file content to be read.
+        virtual void prefetch() {}
     };
 }
 
@@ -0,0 +1,83 @@
+#include "fileindex.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace VFS
+{
+    namespace
+    {
+        std::size_t getHash(std::string_view value)
+        {
+            return std::hash<std::string_view>()(value);
+        }
+
+        std::uint32_t getShortHash(std::size_t hash)
+        {
+            return static_cast<std::uint32_t>(hash ^ (static_cast<std::uint64_t>(hash) >> 32));
+        }
+    }
+
+    FileIndex::FileIndex(FileMap&& map)
+    {
+        mEntries.reserve(map.size());
+        while (!map.empty())
+        {
+            auto node = map.extract(map.begin());
+            mEntries.emplace_back(std::move(node.key()), node.mapped());
+        }
+
+        if (mEntries.size() >= std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("Too many files for VFS index: " + std::to_string(mEntries.size()));
+
+        if (mEntries.empty())
+            return;
+
+        // Keep load factor not greater than 0.5 to have short probe sequences
+        mBuckets.resize(std::bit_ceil(mEntries.size() * 2));
+        const std::size_t mask = mBuckets.size() - 1;
+
+        for (std::size_t i = 0; i < mEntries.size(); ++i)
+        {
+            const std::size_t hash = getHash(mEntries[i].first.view());
+            std::size_t bucket = hash & mask;
+            while (mBuckets[bucket].mPosition != 0)
+                bucket = (bucket + 1) & mask;
+            mBuckets[bucket] = Bucket{ getShortHash(hash), static_cast<std::uint32_t>(i + 1) };
+        }
+    }
+
+    FileIndex::const_iterator FileIndex::find(std::string_view normalizedPath) const
+    {
+        assert(Path::isNormalized(normalizedPath));
+
+        if (mBuckets.empty())
+            return mEntries.end();
+
+        const std::size_t hash = getHash(normalizedPath);
+        const std::uint32_t shortHash = getShortHash(hash);
+        const std::size_t mask = mBuckets.size() - 1;
+
+        for (std::size_t bucket = hash & mask; mBuckets[bucket].mPosition != 0; bucket = (bucket + 1) & mask)
+        {
+            if (mBuckets[bucket].mHash != shortHash)
+                continue;
+            const auto it = mEntries.begin() + (mBuckets[bucket].mPosition - 1);
+            if (it->first.view() == normalizedPath)
+                return it;
+        }
+
+        return mEntries.end();
+    }
+
+    FileIndex::const_iterator FileIndex::lowerBound(std::string_view normalizedPath) const
+    {
+        return std::lower_bound(mEntries.begin(), mEntries.end(), normalizedPath,
+            [](const Entry& entry, std::string_view path) { return entry.first.view() < path; });
+    }
+}
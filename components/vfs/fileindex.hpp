@@ -0,0 +1,56 @@
+#ifndef OPENMW_COMPONENTS_VFS_FILEINDEX_H
+#define OPENMW_COMPONENTS_VFS_FILEINDEX_H
+
+#include "filemap.hpp"
+#include "pathutil.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace VFS
+{
+    /// @brief Immutable index of VFS files optimized for lookups.
+    /// @par Files are stored in a contiguous array sorted by path to support prefix range queries, exact lookups use
+    /// an open addressing hash table of positions in this array.
+    /// @note All const methods are thread-safe.
+    class FileIndex
+    {
+    public:
+        using Entry = std::pair<Path::Normalized, File*>;
+        using const_iterator = std::vector<Entry>::const_iterator;
+
+        FileIndex() = default;
+
+        explicit FileIndex(FileMap&& map);
+
+        const_iterator begin() const { return mEntries.begin(); }
+
+        const_iterator end() const { return mEntries.end(); }
+
+        std::size_t size() const { return mEntries.size(); }
+
+        bool empty() const { return mEntries.empty(); }
+
+        /// Find a file by normalized path.
+        const_iterator find(std::string_view normalizedPath) const;
+
+        /// Returns the first file with path not less than given.
+        const_iterator lowerBound(std::string_view normalizedPath) const;
+
+    private:
+        struct Bucket
+        {
+            std::uint32_t mHash = 0;
+            // Position in mEntries + 1, 0 for empty bucket
+            std::uint32_t mPosition = 0;
+        };
+
+        std::vector<Entry> mEntries;
+        std::vector<Bucket> mBuckets;
+    };
+}
+
+#endif
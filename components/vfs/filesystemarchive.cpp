@@ -1,18 +1,161 @@
 #include "filesystemarchive.hpp"
 
 #include <filesystem>
+#include <fstream>
+#include <optional>
 
 #include "pathutil.hpp"
 
 #include <components/debug/debuglog.hpp>
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/platform/file.hpp>
 
 namespace VFS
 {
+    namespace
+    {
+        constexpr std::uint32_t indexSnapshotMagic = 0x58444956; // VIDX
+        constexpr std::uint32_t indexSnapshotVersion = 1;
+        constexpr std::uint32_t maxSnapshotStringSize = 64 * 1024;
+
+        std::int64_t getLastWriteTime(const std::filesystem::path& path, std::error_code& ec)
+        {
+            return static_cast<std::int64_t>(std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+        }
+
+        template <class T>
+        void writeValue(std::ostream& stream, T value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void writeString(std::ostream& stream, std::string_view value)
+        {
+            writeValue(stream, static_cast<std::uint32_t>(value.size()));
+            stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+        }
+
+        template <class T>
+        bool readValue(std::istream& stream, T& value)
+        {
+            return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+        }
+
+        bool readString(std::istream& stream, std::string& value)
+        {
+            std::uint32_t size = 0;
+            if (!readValue(stream, size) || size > maxSnapshotStringSize)
+                return false;
+            value.resize(size);
+            return static_cast<bool>(stream.read(value.data(), size));
+        }
+
+        std::optional<FileSystemIndexSnapshot> readIndexSnapshot(
+            const std::filesystem::path& snapshotPath, const std::filesystem::path& root)
+        {
+            std::ifstream stream(snapshotPath, std::ios_base::binary);
+            if (!stream.is_open())
+                return std::nullopt;
+
+            std::uint32_t magic = 0;
+            std::uint32_t version = 0;
+            std::string storedRoot;
+            if (!readValue(stream, magic) || magic != indexSnapshotMagic || !readValue(stream, version)
+                || version != indexSnapshotVersion || !readString(stream, storedRoot)
+                || storedRoot != Files::pathToUnicodeString(root))
+                return std::nullopt;
+
+            FileSystemIndexSnapshot result;
+            std::uint32_t directoriesCount = 0;
+            if (!readValue(stream, directoriesCount))
+                return std::nullopt;
+            for (std::uint32_t i = 0; i < directoriesCount; ++i)
+            {
+                std::string directory;
+                std::int64_t lastWriteTime = 0;
+                if (!readString(stream, directory) || !readValue(stream, lastWriteTime))
+                    return std::nullopt;
+                // Any added, removed or renamed entry changes the last write time of the containing directory
+                std::error_code ec;
+                if (getLastWriteTime(root / Files::pathFromUnicodeString(directory), ec) != lastWriteTime || ec)
+                    return std::nullopt;
+                result.mDirectories.emplace_back(std::move(directory), lastWriteTime);
+            }
+
+            std::uint32_t filesCount = 0;
+            if (!readValue(stream, filesCount))
+                return std::nullopt;
+            result.mFiles.resize(filesCount);
+            for (std::string& file : result.mFiles)
+                if (!readString(stream, file))
+                    return std::nullopt;
+
+            return result;
+        }
+
+        void writeIndexSnapshot(const std::filesystem::path& snapshotPath, const std::filesystem::path& root,
+            const FileSystemIndexSnapshot& snapshot)
+        {
+            std::filesystem::create_directories(snapshotPath.parent_path());
+
+            // Write into a temporary file first to never leave a partially written snapshot behind
+            std::filesystem::path tempPath = snapshotPath;
+            tempPath += ".tmp";
+
+            {
+                std::ofstream stream(tempPath, std::ios_base::binary | std::ios_base::trunc);
+                stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+                writeValue(stream, indexSnapshotMagic);
+                writeValue(stream, indexSnapshotVersion);
+                writeString(stream, Files::pathToUnicodeString(root));
+                writeValue(stream, static_cast<std::uint32_t>(snapshot.mDirectories.size()));
+                for (const auto& [directory, lastWriteTime] : snapshot.mDirectories)
+                {
+                    writeString(stream, directory);
+                    writeValue(stream, lastWriteTime);
+                }
+                writeValue(stream, static_cast<std::uint32_t>(snapshot.mFiles.size()));
+                for (const std::string& file : snapshot.mFiles)
+                    writeString(stream, file);
+            }
+
+            std::filesystem::rename(tempPath, snapshotPath);
+        }
+    }
 
     FileSystemArchive::FileSystemArchive(const std::filesystem::path& path)
         : mPath(path)
+    {
+        scan(nullptr);
+    }
+
+    FileSystemArchive::FileSystemArchive(
+        const std::filesystem::path& path, const std::filesystem::path& indexSnapshotPath)
+        : mPath(path)
+    {
+        if (std::optional<FileSystemIndexSnapshot> snapshot = readIndexSnapshot(indexSnapshotPath, mPath))
+        {
+            for (const std::string& file : snapshot->mFiles)
+                addFile(file, mPath / Files::pathFromUnicodeString(file));
+            return;
+        }
+
+        FileSystemIndexSnapshot snapshot;
+        scan(&snapshot);
+
+        try
+        {
+            writeIndexSnapshot(indexSnapshotPath, mPath, snapshot);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write VFS index snapshot for " << mPath << " to " << indexSnapshotPath
+                                << ": " << e.what();
+        }
+    }
+
+    void FileSystemArchive::scan(FileSystemIndexSnapshot* snapshot)
     {
         const auto str = mPath.u8string();
         std::size_t prefix = str.size();
@@ -20,6 +163,12 @@ namespace VFS
         if (prefix > 0 && str[prefix - 1] != '\\' && str[prefix - 1] != '/')
             ++prefix;
 
+        if (snapshot != nullptr)
+        {
+            std::error_code ec;
+            snapshot->mDirectories.emplace_back(std::string(), getLastWriteTime(mPath, ec));
+        }
+
         std::filesystem::recursive_directory_iterator iterator(mPath);
 
         for (auto it = std::filesystem::begin(iterator), end = std::filesystem::end(iterator); it != end;)
@@ -30,14 +179,17 @@ namespace VFS
             {
                 const std::filesystem::path& filePath = entry.path();
                 const std::string proper = Files::pathToUnicodeString(filePath);
-                VFS::Path::Normalized searchable(std::string_view{ proper }.substr(prefix));
-                FileSystemArchiveFile file(filePath);
-
-                const auto inserted = mIndex.emplace(std::move(searchable), std::move(file));
-                if (!inserted.second)
-                    Log(Debug::Warning)
-                        << "Found duplicate file for '" << proper
-                        << "', please check your file system for two files with the same name in different cases.";
+                const std::string_view relativePath = std::string_view{ proper }.substr(prefix);
+                addFile(relativePath, filePath);
+
+                if (snapshot != nullptr)
+                    snapshot->mFiles.emplace_back(relativePath);
+            }
+            else if (snapshot != nullptr)
+            {
+                const std::string proper = Files::pathToUnicodeString(entry.path());
+                std::error_code ec;
+                snapshot->mDirectories.emplace_back(proper.substr(prefix), getLastWriteTime(entry.path(), ec));
             }
 
             // Exception thrown by the operator++ may not contain the context of the error like what exact path caused
@@ -53,6 +205,18 @@ namespace VFS
         }
     }
 
+    void FileSystemArchive::addFile(std::string_view relativePath, const std::filesystem::path& filePath)
+    {
+        VFS::Path::Normalized searchable(relativePath);
+        FileSystemArchiveFile file(filePath);
+
+        const auto inserted = mIndex.emplace(std::move(searchable), std::move(file));
+        if (!inserted.second)
+            Log(Debug::Warning)
+                << "Found duplicate file for '" << Files::pathToUnicodeString(filePath)
+                << "', please check your file system for two files with the same name in different cases.";
+    }
+
     void FileSystemArchive::listResources(FileMap& out)
     {
         for (auto& [k, v] : mIndex)
@@ -81,4 +245,10 @@ namespace VFS
         return Files::openConstrainedFileStream(mPath);
     }
 
+    void FileSystemArchiveFile::prefetch()
+    {
+        const Platform::File::ScopedHandle handle = Platform::File::open(mPath);
+        Platform::File::prefetch(handle, 0, Platform::File::size(handle));
+    }
+
 }
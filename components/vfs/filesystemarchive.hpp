@@ -4,8 +4,11 @@
 #include "archive.hpp"
 #include "file.hpp"
 
+#include <cstdint>
 #include <filesystem>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace VFS
 {
@@ -19,15 +22,30 @@ namespace VFS
 
         std::filesystem::path getPath() override { return mPath; }
 
+        void prefetch() override;
+
     private:
         std::filesystem::path mPath;
     };
 
+    /// Content of a directory tree sufficient to build the archive index without iterating over the tree.
+    /// The snapshot is up to date while all directories have the same last write time.
+    struct FileSystemIndexSnapshot
+    {
+        // Paths relative to the archive root
+        std::vector<std::pair<std::string, std::int64_t>> mDirectories;
+        std::vector<std::string> mFiles;
+    };
+
     class FileSystemArchive : public Archive
     {
     public:
         FileSystemArchive(const std::filesystem::path& path);
 
+        /// Builds the index from the snapshot stored in the given file if it is up to date, otherwise iterates
+        /// over the directory tree and stores a new snapshot.
+        FileSystemArchive(const std::filesystem::path& path, const std::filesystem::path& indexSnapshotPath);
+
         void listResources(FileMap& out) override;
 
         bool contains(Path::NormalizedView file) const override;
@@ -37,6 +55,10 @@ namespace VFS
     private:
         std::map<VFS::Path::Normalized, FileSystemArchiveFile, std::less<>> mIndex;
         std::filesystem::path mPath;
+
+        void scan(FileSystemIndexSnapshot* snapshot);
+
+        void addFile(std::string_view relativePath, const std::filesystem::path& filePath);
     };
 
 }
@@ -3,6 +3,8 @@
 #include <cassert>
 #include <stdexcept>
 
+#include <components/bsa/decompressedfilecache.hpp>
+#include <components/debug/debuglog.hpp>
 #include <components/files/conversion.hpp>
 #include <components/misc/strings/lower.hpp>
 #include <components/vfs/recursivedirectoryiterator.hpp>
@@ -20,8 +22,9 @@ namespace VFS
 
     void Manager::reset()
     {
-        mIndex.clear();
+        mIndex = FileIndex();
         mArchives.clear();
+        mDecompressedFileCache = nullptr;
     }
 
     void Manager::addArchive(std::unique_ptr<Archive>&& archive)
@@ -31,10 +34,12 @@ namespace VFS
 
     void Manager::buildIndex()
     {
-        mIndex.clear();
+        FileMap files;
 
         for (const auto& archive : mArchives)
-            archive->listResources(mIndex);
+            archive->listResources(files);
+
+        mIndex = FileIndex(std::move(files));
     }
 
     Files::IStreamPtr Manager::find(Path::NormalizedView name) const
@@ -61,14 +66,33 @@ namespace VFS
         return ptr;
     }
 
+    void Manager::prefetch(std::span<const Path::NormalizedView> names) const
+    {
+        for (const Path::NormalizedView name : names)
+        {
+            const auto it = mIndex.find(name.value());
+            if (it == mIndex.end())
+                continue;
+            try
+            {
+                it->second->prefetch();
+            }
+            catch (const std::exception& e)
+            {
+                // Prefetch is only an optimization, the actual read will report the error if there is a problem
+                Log(Debug::Verbose) << "Failed to prefetch '" << name.value() << "': " << e.what();
+            }
+        }
+    }
+
     bool Manager::exists(const Path::Normalized& name) const
     {
-        return mIndex.find(name) != mIndex.end();
+        return mIndex.find(name.view()) != mIndex.end();
     }
 
     bool Manager::exists(Path::NormalizedView name) const
     {
-        return mIndex.find(name) != mIndex.end();
+        return mIndex.find(name.value()) != mIndex.end();
     }
 
     std::string Manager::getArchive(const Path::Normalized& name) const
@@ -81,6 +105,11 @@ namespace VFS
         return {};
     }
 
+    void Manager::setDecompressedFileCache(std::shared_ptr<const Bsa::DecompressedFileCache> cache)
+    {
+        mDecompressedFileCache = std::move(cache);
+    }
+
     std::filesystem::path Manager::getAbsoluteFileName(const std::filesystem::path& name) const
     {
         std::string normalized = Files::pathToUnicodeString(name);
@@ -97,23 +126,23 @@ namespace VFS
         if (path.empty())
             return { mIndex.begin(), mIndex.end() };
         std::string normalized = Path::normalizeFilename(path);
-        const auto it = mIndex.lower_bound(normalized);
+        const auto it = mIndex.lowerBound(normalized);
         if (it == mIndex.end() || !it->first.view().starts_with(normalized))
             return { it, it };
         ++normalized.back();
-        return { it, mIndex.lower_bound(normalized) };
+        return { it, mIndex.lowerBound(normalized) };
     }
 
     RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator(VFS::Path::NormalizedView path) const
     {
         if (path.value().empty())
             return { mIndex.begin(), mIndex.end() };
-        const auto it = mIndex.lower_bound(path);
+        const auto it = mIndex.lowerBound(path.value());
         if (it == mIndex.end() || !it->first.view().starts_with(path.value()))
             return { it, it };
         std::string copy(path.value());
         ++copy.back();
-        return { it, mIndex.lower_bound(copy) };
+        return { it, mIndex.lowerBound(copy) };
     }
 
     RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator() const
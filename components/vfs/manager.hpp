@@ -5,13 +5,19 @@
 
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
-#include "filemap.hpp"
+#include "fileindex.hpp"
 #include "pathutil.hpp"
 
+namespace Bsa
+{
+    class DecompressedFileCache;
+}
+
 namespace VFS
 {
     class Archive;
@@ -37,6 +43,7 @@ namespace VFS
         void addArchive(std::unique_ptr<Archive>&& archive);
 
         /// Build the file index. Should be called when all archives have been registered.
+        /// @note The index is immutable after this call until the next reset() or buildIndex().
         void buildIndex();
 
         /// Does a file with this name exist?
@@ -60,6 +67,11 @@ namespace VFS
         /// @note May be called from any thread once the index has been built.
         Files::IStreamPtr getNormalized(std::string_view normalizedName) const;
 
+        /// Hint that the files will be opened soon so their content can be read in background meanwhile.
+        /// @note Does not wait for the content to be read. Missing files are ignored.
+        /// @note May be called from any thread once the index has been built.
+        void prefetch(std::span<const Path::NormalizedView> names) const;
+
         std::string getArchive(const Path::Normalized& name) const;
 
         /// Recursively iterate over the elements of the given path
@@ -77,10 +89,16 @@ namespace VFS
         /// @note May be called from any thread once the index has been built.
         std::filesystem::path getAbsoluteFileName(const std::filesystem::path& name) const;
 
+        /// Set the cache shared by the registered archives, it's used only to report the stats.
+        void setDecompressedFileCache(std::shared_ptr<const Bsa::DecompressedFileCache> cache);
+
+        const Bsa::DecompressedFileCache* getDecompressedFileCache() const { return mDecompressedFileCache.get(); }
+
     private:
         std::vector<std::unique_ptr<Archive>> mArchives;
+        std::shared_ptr<const Bsa::DecompressedFileCache> mDecompressedFileCache;
 
-        FileMap mIndex;
+        FileIndex mIndex;
 
         inline Files::IStreamPtr findNormalized(std::string_view normalizedPath) const;
     };
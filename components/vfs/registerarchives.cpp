@@ -1,10 +1,21 @@
 #include "registerarchives.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <exception>
 #include <filesystem>
+#include <functional>
+#include <iomanip>
 #include <set>
+#include <sstream>
 #include <stdexcept>
+#include <thread>
 
 #include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
 
 #include <components/vfs/bsaarchive.hpp>
 #include <components/vfs/filesystemarchive.hpp>
@@ -12,12 +23,70 @@
 
 namespace VFS
 {
+    namespace
+    {
+        using ArchiveFactory = std::function<std::unique_ptr<Archive>()>;
+
+        constexpr std::size_t decompressedFileCacheSize = 64 * 1024 * 1024;
+
+        // Archives are independent from each other, so reading their indices is done concurrently. The order of the
+        // result matches the order of factories to preserve archives priority.
+        std::vector<std::unique_ptr<Archive>> makeArchives(const std::vector<ArchiveFactory>& factories)
+        {
+            std::vector<std::unique_ptr<Archive>> result(factories.size());
+            std::vector<std::exception_ptr> errors(factories.size());
+            std::atomic_size_t next = 0;
+
+            const auto process = [&] {
+                for (std::size_t i = next++; i < factories.size(); i = next++)
+                {
+                    try
+                    {
+                        result[i] = factories[i]();
+                    }
+                    catch (...)
+                    {
+                        errors[i] = std::current_exception();
+                    }
+                }
+            };
+
+            const std::size_t threadsCount
+                = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), factories.size());
+            std::vector<std::thread> threads;
+            for (std::size_t i = 1; i < threadsCount; ++i)
+                threads.emplace_back(process);
+            process();
+            for (std::thread& thread : threads)
+                thread.join();
+
+            for (const std::exception_ptr& error : errors)
+                if (error != nullptr)
+                    std::rethrow_exception(error);
+
+            return result;
+        }
+
+        std::filesystem::path getIndexSnapshotPath(
+            const std::filesystem::path& indexCacheDir, const std::filesystem::path& dataDir)
+        {
+            const std::string dataDirString = Files::pathToUnicodeString(dataDir);
+            std::istringstream stream(dataDirString);
+            const std::array<std::uint64_t, 2> hash = Files::getHash(dataDirString, stream);
+            std::ostringstream name;
+            name << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1] << ".bin";
+            return indexCacheDir / name.str();
+        }
+    }
 
     void registerArchives(VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles)
+        const std::vector<std::string>& archives, bool useLooseFiles, const std::filesystem::path& indexCacheDir)
     {
         const Files::PathContainer& dataDirs = collections.getPaths();
 
+        std::vector<ArchiveFactory> factories;
+        const auto decompressedFileCache = std::make_shared<Bsa::DecompressedFileCache>(decompressedFileCacheSize);
+
         for (std::vector<std::string>::const_iterator archive = archives.begin(); archive != archives.end(); ++archive)
         {
             if (collections.doesExist(*archive))
@@ -25,7 +94,9 @@ namespace VFS
                 // Last BSA has the highest priority
                 const auto archivePath = collections.getPath(*archive);
                 Log(Debug::Info) << "Adding BSA archive " << archivePath;
-                vfs->addArchive(makeBsaArchive(archivePath));
+                factories.push_back([=] {
+                    return makeBsaArchive(archivePath, memoryMapBsaArchivesByDefault, decompressedFileCache);
+                });
             }
             else
             {
@@ -42,13 +113,23 @@ namespace VFS
                 {
                     Log(Debug::Info) << "Adding data directory " << dataDir;
                     // Last data dir has the highest priority
-                    vfs->addArchive(std::make_unique<FileSystemArchive>(dataDir));
+                    if (indexCacheDir.empty())
+                        factories.push_back([=] { return std::make_unique<FileSystemArchive>(dataDir); });
+                    else
+                        factories.push_back([=, snapshotPath = getIndexSnapshotPath(indexCacheDir, dataDir)] {
+                            return std::make_unique<FileSystemArchive>(dataDir, snapshotPath);
+                        });
                 }
                 else
                     Log(Debug::Info) << "Ignoring duplicate data directory " << dataDir;
             }
         }
 
+        for (std::unique_ptr<Archive>& archive : makeArchives(factories))
+            vfs->addArchive(std::move(archive));
+
+        vfs->setDecompressedFileCache(decompressedFileCache);
+
         vfs->buildIndex();
     }
 
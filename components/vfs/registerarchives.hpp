@@ -3,13 +3,17 @@
 
 #include <components/files/collections.hpp>
 
+#include <filesystem>
+
 namespace VFS
 {
     class Manager;
 
     /// @brief Register BSA and file system archives based on the given OpenMW configuration.
+    /// @param indexCacheDir when not empty data directories index snapshots are stored there and reused when the
+    /// directories are not modified.
     void registerArchives(VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles);
+        const std::vector<std::string>& archives, bool useLooseFiles, const std::filesystem::path& indexCacheDir = {});
 }
 
 #endif